@@ -191,8 +191,10 @@ main() {
     run_app
     status=$?
 
-    if [ $DEBUG -eq 1 ] && [ -f "$APP_PATH/trace.vcd" ]; then
-        mv -f $APP_PATH/trace.vcd .
+    if [ $DEBUG -eq 1 ]; then
+        for trace in $APP_PATH/trace.vcd $APP_PATH/trace_*.fst $APP_PATH/trace_*.vcd; do
+            [ -f "$trace" ] && mv -f "$trace" .
+        done
     fi
 
     if [ $SCOPE -eq 1 ] && [ -f "$APP_PATH/scope.vcd" ]; then
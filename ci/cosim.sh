@@ -0,0 +1,96 @@
+#!/bin/sh
+
+# Copyright © 2019-2023
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Runs an application on rtlsim and simx in lockstep, simx checks each
+# instruction against the commit stream of the RTL and stops at the first
+# divergence.
+
+SCRIPT_DIR=$(dirname "$0")
+ROOT_DIR=$SCRIPT_DIR/..
+
+show_usage()
+{
+    echo "Vortex Co-Simulation v1.0"
+    echo "Usage: $0 [[--app=#app] [--args=#args] [--configs=#defines] [--rebuild] [--help]]"
+}
+
+APP=basic
+ARGS=""
+CONFIGS_EXTRA=""
+REBUILD=0
+
+for i in "$@"; do
+    case $i in
+        --app=*)     APP=${i#*=} ;;
+        --args=*)    ARGS=${i#*=} ;;
+        --configs=*) CONFIGS_EXTRA=${i#*=} ;;
+        --rebuild)   REBUILD=1 ;;
+        --help)      show_usage; exit 0 ;;
+        *)           show_usage; exit 1 ;;
+    esac
+done
+
+if [ -d "$ROOT_DIR/tests/opencl/$APP" ]; then
+    APP_PATH="$ROOT_DIR/tests/opencl/$APP"
+elif [ -d "$ROOT_DIR/tests/regression/$APP" ]; then
+    APP_PATH="$ROOT_DIR/tests/regression/$APP"
+else
+    echo "Application folder not found: $APP"
+    exit 1
+fi
+
+CONFIGS="$CONFIGS $CONFIGS_EXTRA"
+export CONFIGS
+
+make -C "$ROOT_DIR/hw" config > /dev/null
+make -C "$ROOT_DIR/runtime/stub" > /dev/null
+
+if [ $REBUILD -eq 1 ]; then
+    make -C "$ROOT_DIR/runtime/rtlsim" clean-driver > /dev/null
+    make -C "$ROOT_DIR/runtime/simx" clean-driver > /dev/null
+fi
+if ! COSIM=1 make -C "$ROOT_DIR/runtime/rtlsim" > /dev/null; then
+    echo "rtlsim build failed"
+    exit 1
+fi
+if ! make -C "$ROOT_DIR/runtime/simx" > /dev/null; then
+    echo "simx build failed"
+    exit 1
+fi
+
+FIFO=$(mktemp -u /tmp/vortex_cosim.XXXXXX)
+mkfifo "$FIFO" || exit 1
+trap 'rm -f "$FIFO"' EXIT
+
+# the RTL writes the commit stream, simx reads and checks it
+VORTEX_COMMIT_LOG="$FIFO" OPTS="$ARGS" make -C $APP_PATH run-rtlsim > cosim_rtlsim.log 2>&1 &
+RTLSIM_PID=$!
+
+VORTEX_COSIM="$FIFO" OPTS="$ARGS" make -C $APP_PATH run-simx 2>&1 | tee cosim_simx.log
+status=0
+grep -q "cosim: .* PASSED" cosim_simx.log || status=1
+
+# simx stops reading at a divergence, do not wait on a blocked RTL run
+if [ $status -ne 0 ]; then
+    kill $RTLSIM_PID 2> /dev/null
+fi
+wait $RTLSIM_PID 2> /dev/null
+
+if [ $status -eq 0 ]; then
+    echo "cosim passed: $APP"
+else
+    echo "cosim failed: $APP, see cosim_simx.log and cosim_rtlsim.log"
+fi
+exit $status
@@ -0,0 +1,87 @@
+#!/bin/sh
+
+# Copyright © 2019-2023
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Measures the wall-clock time of an RTL simulation for each core count
+# and Verilator thread count, the build time is excluded.
+
+SCRIPT_DIR=$(dirname "$0")
+ROOT_DIR=$SCRIPT_DIR/..
+
+show_usage()
+{
+    echo "Vortex RTL Simulation Scaling v1.0"
+    echo "Usage: $0 [[--driver=#name] [--app=#app] [--args=#args] [--cores=#list] [--vl-threads=#list] [--hierarchical] [--help]]"
+}
+
+DRIVER=rtlsim
+APP=sgemmx
+ARGS=""
+CORES="4 8 16"
+VL_THREADS_LIST="1 2 4 8"
+HIERARCHICAL=""
+
+for i in "$@"; do
+    case $i in
+        --driver=*) DRIVER=${i#*=} ;;
+        --app=*)    APP=${i#*=} ;;
+        --args=*)   ARGS=${i#*=} ;;
+        --cores=*)  CORES=${i#*=} ;;
+        --vl-threads=*) VL_THREADS_LIST=${i#*=} ;;
+        --hierarchical) HIERARCHICAL=1 ;;
+        --help)     show_usage; exit 0 ;;
+        *)          show_usage; exit 1 ;;
+    esac
+done
+
+case $DRIVER in
+    rtlsim|opae|xrt) DRIVER_PATH="$ROOT_DIR/runtime/$DRIVER" ;;
+    *) echo "Invalid driver: $DRIVER"; exit 1 ;;
+esac
+
+if [ -d "$ROOT_DIR/tests/opencl/$APP" ]; then
+    APP_PATH="$ROOT_DIR/tests/opencl/$APP"
+elif [ -d "$ROOT_DIR/tests/regression/$APP" ]; then
+    APP_PATH="$ROOT_DIR/tests/regression/$APP"
+else
+    echo "Application folder not found: $APP"
+    exit 1
+fi
+
+make -C "$ROOT_DIR/hw" config > /dev/null
+make -C "$ROOT_DIR/runtime/stub" > /dev/null
+
+printf "%-8s %-12s %-12s %s\n" "cores" "vl_threads" "seconds" "speedup"
+
+for cores in $CORES; do
+    base=""
+    for threads in $VL_THREADS_LIST; do
+        make -C $DRIVER_PATH clean-driver > /dev/null
+        if ! CONFIGS="-DNUM_CORES=$cores" VL_THREADS=$threads HIERARCHICAL=$HIERARCHICAL make -C $DRIVER_PATH > /dev/null; then
+            echo "build failed: cores=$cores, vl_threads=$threads"
+            exit 1
+        fi
+
+        start=$(date +%s.%N)
+        if ! OPTS="$ARGS" make -C $APP_PATH run-$DRIVER > run_${cores}c_${threads}t.log 2>&1; then
+            echo "run failed: cores=$cores, vl_threads=$threads, see run_${cores}c_${threads}t.log"
+            exit 1
+        fi
+        end=$(date +%s.%N)
+
+        elapsed=$(echo "$end - $start" | bc)
+        [ -z "$base" ] && base=$elapsed
+        printf "%-8s %-12s %-12.1f %.2fx\n" $cores $threads $elapsed $(echo "$base / $elapsed" | bc -l)
+    done
+done
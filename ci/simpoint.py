@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+
+# Copyright © 2019-2023
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Selects the simulation points of a SimX profiling run (VORTEX_BBV), following
+# the SimPoint methodology: the basic block vectors are normalized, randomly
+# projected to a few dimensions and clustered with k-means, k being the
+# smallest whose BIC score reaches 90% of the best one. The intervals closest
+# to each cluster centroid are written with the cluster weight, several per
+# cluster so that SimX can estimate the sampling error.
+
+import sys
+import argparse
+import math
+import random
+
+def parse_args():
+    parser = argparse.ArgumentParser(description='SimX basic block vectors to simulation points.')
+    parser.add_argument('-o', '--output', default='simpoints.txt', help='Output simulation points file')
+    parser.add_argument('-k', '--max-k', type=int, default=10, help='Maximum number of clusters')
+    parser.add_argument('-n', '--samples', type=int, default=2, help='Simulation points per cluster')
+    parser.add_argument('-d', '--dims', type=int, default=15, help='Projected dimensions')
+    parser.add_argument('-s', '--seed', type=int, default=493575226, help='Random seed')
+    parser.add_argument('bbv', help='Input basic block vectors file')
+    return parser.parse_args()
+
+def read_bbv(filename):
+    vectors = []
+    with open(filename, 'r') as file:
+        for line in file:
+            line = line.strip()
+            if not line.startswith('T'):
+                continue
+            vector = {}
+            for entry in line[1:].split():
+                _, block, count = entry.split(':')
+                vector[int(block)] = int(count)
+            vectors.append(vector)
+    return vectors
+
+def project(vectors, dims, rng):
+    # each basic block gets a random direction
+    directions = {}
+    points = []
+    for vector in vectors:
+        total = sum(vector.values())
+        point = [0.0] * dims
+        for block, count in vector.items():
+            direction = directions.get(block)
+            if direction is None:
+                direction = [rng.uniform(-1, 1) for _ in range(dims)]
+                directions[block] = direction
+            weight = count / total
+            for i in range(dims):
+                point[i] += weight * direction[i]
+        points.append(point)
+    return points
+
+def distance2(a, b):
+    return sum((x - y) * (x - y) for x, y in zip(a, b))
+
+def kmeans(points, k, rng, iterations=100):
+    # k-means++ seeding
+    centroids = [rng.choice(points)]
+    while len(centroids) < k:
+        d2 = [min(distance2(p, c) for c in centroids) for p in points]
+        total = sum(d2)
+        if total == 0:
+            break
+        r = rng.uniform(0, total)
+        for p, d in zip(points, d2):
+            r -= d
+            if r <= 0:
+                centroids.append(p)
+                break
+    labels = [0] * len(points)
+    for _ in range(iterations):
+        changed = False
+        for i, p in enumerate(points):
+            label = min(range(len(centroids)), key=lambda c: distance2(p, centroids[c]))
+            if label != labels[i]:
+                labels[i] = label
+                changed = True
+        for c in range(len(centroids)):
+            members = [p for p, l in zip(points, labels) if l == c]
+            if members:
+                centroids[c] = [sum(x) / len(members) for x in zip(*members)]
+        if not changed:
+            break
+    return centroids, labels
+
+def bic(points, centroids, labels):
+    # Bayesian information criterion of a spherical gaussian mixture (x-means)
+    n = len(points)
+    k = len(centroids)
+    d = len(points[0])
+    if n <= k:
+        return -math.inf
+    sse = sum(distance2(p, centroids[l]) for p, l in zip(points, labels))
+    variance = max(sse / (d * (n - k)), 1e-12)
+    likelihood = 0.0
+    for c in range(k):
+        size = labels.count(c)
+        if size == 0:
+            continue
+        likelihood += size * math.log(size / n) \
+                    - size / 2 * math.log(2 * math.pi) \
+                    - size * d / 2 * math.log(variance) \
+                    - (size - k) / 2
+    parameters = (k - 1) + k * d + 1
+    return likelihood - parameters / 2 * math.log(n)
+
+def select(points, max_k, rng):
+    results = []
+    for k in range(1, min(max_k, len(points)) + 1):
+        centroids, labels = kmeans(points, k, rng)
+        results.append((bic(points, centroids, labels), centroids, labels))
+    scores = [r[0] for r in results]
+    lo, hi = min(scores), max(scores)
+    for score, centroids, labels in results:
+        if score >= lo + 0.9 * (hi - lo):
+            return centroids, labels
+    return results[-1][1], results[-1][2]
+
+def main():
+    args = parse_args()
+    rng = random.Random(args.seed)
+    vectors = read_bbv(args.bbv)
+    if not vectors:
+        print("Error: no interval in {}".format(args.bbv))
+        sys.exit(1)
+    points = project(vectors, args.dims, rng)
+    centroids, labels = select(points, args.max_k, rng)
+    simpoints = []
+    clusters = 0
+    for c, centroid in enumerate(centroids):
+        members = [i for i, l in enumerate(labels) if l == c]
+        if not members:
+            continue
+        weight = len(members) / len(points)
+        members.sort(key=lambda i: distance2(points[i], centroid))
+        for i in members[:args.samples]:
+            simpoints.append((i, clusters, weight))
+        clusters += 1
+    simpoints.sort()
+    with open(args.output, 'w') as file:
+        file.write("# interval cluster weight\n")
+        for interval, cluster, weight in simpoints:
+            file.write("{} {} {:.6f}\n".format(interval, cluster, weight))
+    print("Selected {} simulation points in {} clusters from {} intervals to {}".format(len(simpoints), clusters, len(points), args.output))
+
+if __name__ == "__main__":
+    main()
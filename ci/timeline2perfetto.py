@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+
+# Copyright © 2019-2023
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import sys
+import argparse
+import json
+import struct
+
+MAGIC = b'VXTL'
+VERSION = 1
+
+# must match sim/simx/timeline.h
+EVENT_FORMAT = '<QQHHBBH'
+EVENT_SIZE = struct.calcsize(EVENT_FORMAT)
+
+EV_TRACK_NAME = 0
+EV_ISSUE      = 1
+EV_STALL      = 2
+EV_DISPATCH   = 3
+EV_COMMIT     = 4
+EV_MISS_BEGIN = 5
+EV_MISS_END   = 6
+
+TRACK_BASE = 0x8000
+
+FU_NAMES = ['ALU', 'LSU', 'FPU', 'SFU', 'TCU']
+STALL_NAMES = ['ibuffer-stall', 'scoreboard-stall', 'operand-stall', 'dispatch-stall']
+# stall reasons blocked on a functional unit
+STALL_FU_REASONS = (1, 3)
+
+def parse_args():
+    parser = argparse.ArgumentParser(description='SimX timeline to Perfetto (Chrome JSON trace) converter.')
+    parser.add_argument('-o', '--output', default='timeline.json', help='Output trace file')
+    parser.add_argument('timeline', help='Input timeline file')
+    return parser.parse_args()
+
+def fu_name(fu_type):
+    return FU_NAMES[fu_type] if fu_type < len(FU_NAMES) else str(fu_type)
+
+def read_events(filename):
+    with open(filename, 'rb') as file:
+        data = file.read()
+    if data[:4] != MAGIC:
+        print("Error: invalid timeline file")
+        sys.exit(1)
+    version = struct.unpack_from('<I', data, 4)[0]
+    if version != VERSION:
+        print("Error: unsupported timeline version {}".format(version))
+        sys.exit(1)
+    offset = 8
+    while offset + EVENT_SIZE <= len(data):
+        event = struct.unpack_from(EVENT_FORMAT, data, offset)
+        offset += EVENT_SIZE
+        cycle, id, track, lane, type, arg, aux = event
+        if type == EV_TRACK_NAME:
+            name = data[offset:offset + aux].decode('utf-8')
+            offset += (aux + 7) & ~7
+            yield (cycle, id, track, lane, type, arg, name)
+        else:
+            yield event
+
+def convert(events):
+    trace = []
+    named = set()
+    track_names = {}
+    stalls = {}
+    spans = set()
+
+    def add_metadata(pid, tid, is_core):
+        if pid not in named:
+            named.add(pid)
+            name = "core{}".format(pid) if is_core else track_names.get(pid, "track{}".format(pid))
+            trace.append({'ph': 'M', 'name': 'process_name', 'pid': pid, 'args': {'name': name}})
+        if (pid, tid) not in named:
+            named.add((pid, tid))
+            name = ("warp{}" if is_core else "bank{}").format(tid)
+            trace.append({'ph': 'M', 'name': 'thread_name', 'pid': pid, 'tid': tid, 'args': {'name': name}})
+
+    def close_stall(uuid, cycle):
+        stall = stalls.pop(uuid, None)
+        if stall is not None:
+            stall['dur'] = max(cycle - stall['ts'], 1)
+            trace.append(stall)
+
+    for cycle, id, track, lane, type, arg, aux in events:
+        if type == EV_TRACK_NAME:
+            track_names[track] = aux
+            continue
+
+        is_core = track < TRACK_BASE
+        add_metadata(track, lane, is_core)
+        base = {'pid': track, 'tid': lane, 'ts': cycle}
+
+        if type == EV_ISSUE:
+            close_stall(id, cycle)
+            spans.add(('instr', id))
+            trace.append(dict(base, ph='b', cat='instr', name=fu_name(arg), id=id, args={'uuid': id}))
+        elif type == EV_STALL:
+            close_stall(id, cycle)
+            args = {'uuid': id}
+            if arg in STALL_FU_REASONS:
+                args['fu'] = fu_name(aux)
+            stalls[id] = dict(base, ph='X', cat='stall', name=STALL_NAMES[arg], args=args)
+        elif type == EV_DISPATCH:
+            close_stall(id, cycle)
+            trace.append(dict(base, ph='i', s='t', cat='instr', name="dispatch:" + fu_name(arg), args={'uuid': id}))
+        elif type == EV_COMMIT:
+            close_stall(id, cycle)
+            # skip instructions issued before the recording window
+            if ('instr', id) in spans:
+                spans.remove(('instr', id))
+                trace.append(dict(base, ph='e', cat='instr', name=fu_name(arg), id=id))
+        elif type == EV_MISS_BEGIN:
+            span_id = "{}:{}:{}".format(track, lane, aux)
+            spans.add(('cache', span_id))
+            trace.append(dict(base, ph='b', cat='cache', name='miss', id=span_id, args={'addr': hex(id)}))
+        elif type == EV_MISS_END:
+            span_id = "{}:{}:{}".format(track, lane, aux)
+            if ('cache', span_id) in spans:
+                spans.remove(('cache', span_id))
+                trace.append(dict(base, ph='e', cat='cache', name='miss', id=span_id))
+
+    # flush stalls cut by the end of the recording window
+    for stall in stalls.values():
+        stall['dur'] = 1
+        trace.append(stall)
+
+    return trace
+
+def main():
+    args = parse_args()
+    trace = convert(read_events(args.timeline))
+    with open(args.output, 'w') as file:
+        # timestamps are in cycles
+        json.dump({'traceEvents': trace, 'displayTimeUnit': 'ns', 'otherData': {'time_unit': 'cycles'}}, file)
+    print("Generated {} events to {}".format(len(trace), args.output))
+
+if __name__ == "__main__":
+    main()
@@ -51,8 +51,13 @@ extern "C" {
   void dpi_feq(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, svBitVecVal* fflags);
   void dpi_fmin(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, svBitVecVal* fflags);
   void dpi_fmax(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, svBitVecVal* fflags);
+
+  void dpi_fpu_lanes(bool enable, int op_type, int fmt, const svBitVecVal* frm, int64_t mask, const svOpenArrayHandle a, const svOpenArrayHandle b, const svOpenArrayHandle c, const svOpenArrayHandle result, svBitVecVal* fflags);
 }
 
+// These functions are called concurrently from multithreaded Verilator models:
+// rvfloats keeps no state and softfloat is built with thread-local flags.
+
 inline uint64_t nan_box(uint32_t value) {
 #ifdef XLEN_64
   return value | 0xffffffff00000000;
@@ -336,4 +341,136 @@ void dpi_fmax(bool enable, int dst_fmt, int64_t a, int64_t b, int64_t* result, s
   } else {
     *result = nan_box(rv_fmax_s(check_boxing(a), check_boxing(b), fflags));
   }
-}
\ No newline at end of file
+}
+// FPU operation encoding (see INST_FPU_* in VX_define.vh)
+enum {
+  FPU_ADD   = 0x0,
+  FPU_MUL   = 0x1,
+  FPU_MADD  = 0x2,
+  FPU_NMADD = 0x3,
+  FPU_DIV   = 0x4,
+  FPU_SQRT  = 0x5,
+  FPU_F2I   = 0x8,
+  FPU_F2U   = 0x9,
+  FPU_I2F   = 0xA,
+  FPU_U2F   = 0xB,
+  FPU_CMP   = 0xC,
+  FPU_F2F   = 0xD,
+  FPU_MISC  = 0xE
+};
+
+static void fpu_lane(int op_type, int f_fmt, int i_fmt, const svBitVecVal* frm, int64_t a, int64_t b, int64_t c, int64_t* result, svBitVecVal* fflags) {
+  switch (op_type) {
+  case FPU_ADD:
+    if (i_fmt) {
+      dpi_fsub(true, f_fmt, a, b, frm, result, fflags);
+    } else {
+      dpi_fadd(true, f_fmt, a, b, frm, result, fflags);
+    }
+    break;
+  case FPU_MUL:
+    dpi_fmul(true, f_fmt, a, b, frm, result, fflags);
+    break;
+  case FPU_MADD:
+    if (i_fmt) {
+      dpi_fmsub(true, f_fmt, a, b, c, frm, result, fflags);
+    } else {
+      dpi_fmadd(true, f_fmt, a, b, c, frm, result, fflags);
+    }
+    break;
+  case FPU_NMADD:
+    if (i_fmt) {
+      dpi_fnmsub(true, f_fmt, a, b, c, frm, result, fflags);
+    } else {
+      dpi_fnmadd(true, f_fmt, a, b, c, frm, result, fflags);
+    }
+    break;
+  case FPU_DIV:
+    dpi_fdiv(true, f_fmt, a, b, frm, result, fflags);
+    break;
+  case FPU_SQRT:
+    dpi_fsqrt(true, f_fmt, a, frm, result, fflags);
+    break;
+  case FPU_F2I:
+    dpi_ftoi(true, i_fmt, f_fmt, a, frm, result, fflags);
+    break;
+  case FPU_F2U:
+    dpi_ftou(true, i_fmt, f_fmt, a, frm, result, fflags);
+    break;
+  case FPU_I2F:
+    dpi_itof(true, f_fmt, i_fmt, a, frm, result, fflags);
+    break;
+  case FPU_U2F:
+    dpi_utof(true, f_fmt, i_fmt, a, frm, result, fflags);
+    break;
+  case FPU_F2F:
+    dpi_f2f(true, f_fmt, a, result);
+    break;
+  default:
+    // comparisons and MISC share the non-computational unit, selected by frm
+    switch (*frm & 0x7) {
+    case 0:
+      if (op_type == FPU_CMP) {
+        dpi_fle(true, f_fmt, a, b, result, fflags);
+      } else {
+        dpi_fsgnj(true, f_fmt, a, b, result);
+      }
+      break;
+    case 1:
+      if (op_type == FPU_CMP) {
+        dpi_flt(true, f_fmt, a, b, result, fflags);
+      } else {
+        dpi_fsgnjn(true, f_fmt, a, b, result);
+      }
+      break;
+    case 2:
+      if (op_type == FPU_CMP) {
+        dpi_feq(true, f_fmt, a, b, result, fflags);
+      } else {
+        dpi_fsgnjx(true, f_fmt, a, b, result);
+      }
+      break;
+    case 3:
+      dpi_fclss(true, f_fmt, a, result);
+      break;
+    case 4:
+      *result = f_fmt ? a : sext<uint64_t>(a, 32); // sign-extension
+      break;
+    case 5:
+      *result = f_fmt ? a : (a | 0xffffffff00000000); // nan-boxing
+      break;
+    case 6:
+      dpi_fmin(true, f_fmt, a, b, result, fflags);
+      break;
+    case 7:
+      dpi_fmax(true, f_fmt, a, b, result, fflags);
+      break;
+    }
+    break;
+  }
+}
+
+// Evaluates the selected operation on the active lanes of a request in a
+// single call, merging their exception flags.
+void dpi_fpu_lanes(bool enable, int op_type, int fmt, const svBitVecVal* frm, int64_t mask, const svOpenArrayHandle a, const svOpenArrayHandle b, const svOpenArrayHandle c, const svOpenArrayHandle result, svBitVecVal* fflags) {
+  if (!enable)
+    return;
+  int num_lanes = svSize(result, 1);
+  auto a_lanes = reinterpret_cast<const int64_t*>(svGetArrayPtr(a));
+  auto b_lanes = reinterpret_cast<const int64_t*>(svGetArrayPtr(b));
+  auto c_lanes = reinterpret_cast<const int64_t*>(svGetArrayPtr(c));
+  auto r_lanes = reinterpret_cast<int64_t*>(svGetArrayPtr(result));
+  int f_fmt = fmt & 0x1;
+  int i_fmt = (fmt >> 1) & 0x1;
+  svBitVecVal merged = 0;
+  for (int i = 0; i < num_lanes; ++i) {
+    if (!((mask >> i) & 0x1)) {
+      r_lanes[i] = 0;
+      continue;
+    }
+    svBitVecVal lane_fflags = 0;
+    fpu_lane(op_type, f_fmt, i_fmt, frm, a_lanes[i], b_lanes[i], c_lanes[i], &r_lanes[i], &lane_fflags);
+    merged |= lane_fflags;
+  }
+  *fflags = merged & 0x1f;
+}
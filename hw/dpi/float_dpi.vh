@@ -42,4 +42,6 @@ import "DPI-C" function void dpi_feq(input logic enable, input int dst_fmt, inpu
 import "DPI-C" function void dpi_fmin(input logic enable, input int dst_fmt, input longint a, input longint b, output longint result, output bit[4:0] fflags);
 import "DPI-C" function void dpi_fmax(input logic enable, input int dst_fmt, input longint a, input longint b, output longint result, output bit[4:0] fflags);
 
+import "DPI-C" function void dpi_fpu_lanes(input logic enable, input int op_type, input int fmt, input bit[2:0] frm, input longint mask, input longint a[], input longint b[], input longint c[], output longint result[], output bit[4:0] fflags);
+
 `endif
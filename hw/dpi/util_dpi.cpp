@@ -12,15 +12,20 @@
 // limitations under the License.
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include <unordered_map>
 #include <vector>
+#include <deque>
 #include <mutex>
+#include <atomic>
 #include <iostream>
 
 #include "svdpi.h"
 #include "verilated_vpi.h"
 
+#include <commit_log.h>
+
 #ifdef XLEN_64
 #define iword_t   int64_t
 #define uword_t   uint64_t
@@ -47,6 +52,10 @@ extern "C" {
   void dpi_trace(int level, const char* format, ...);
   void dpi_trace_start();
   void dpi_trace_stop();
+  void dpi_trace_pc(int64_t PC);
+
+  void dpi_commit_data(int lane, int64_t value);
+  void dpi_commit(int64_t uuid, int64_t PC, int64_t tmask, bool wb, int rd, bool eop);
 }
 
 bool sim_trace_enabled();
@@ -84,6 +93,9 @@ private:
   unsigned depth_;
 };
 
+// DPI calls may come from multiple Verilator threads (--threads-dpi all).
+// Instances are allocated during elaboration, before the simulation threads
+// start, and never move, so the per-cycle lookup needs no lock.
 class Instances {
 public:
   ShiftRegister& get(int inst) {
@@ -91,15 +103,14 @@ public:
   }
 
   int allocate() {
-    mutex_.lock();
+    std::lock_guard<std::mutex> lock(mutex_);
     int inst = instances_.size();
-    instances_.resize(inst + 1);
-    mutex_.unlock();
+    instances_.emplace_back();
     return inst;
   }
 
 private:
-  std::vector<ShiftRegister> instances_;
+  std::deque<ShiftRegister> instances_;
   std::mutex mutex_;
 };
 
@@ -118,6 +129,8 @@ void dpi_assert(int inst, bool cond, int delay) {
   auto status = sr.top();
   if (status) {
     printf("delayed assertion at %s!\n", svGetNameFromScope(svGetScope()));
+    // close the waveform files
+    Verilated::runExitCallbacks();
     std::abort();
   }
 }
@@ -202,3 +215,43 @@ void dpi_trace_start() {
 void dpi_trace_stop() {
   sim_trace_enable(false);
 }
+
+// VORTEX_TRACE_PC=<addr> starts tracing when an instruction at <addr> first commits
+static uint64_t trace_pc_init() {
+  auto pc_s = getenv("VORTEX_TRACE_PC");
+  return pc_s ? strtoull(pc_s, nullptr, 0) : -1ull;
+}
+
+static const uint64_t trace_pc = trace_pc_init();
+static std::atomic<bool> trace_pc_hit(false);
+
+void dpi_trace_pc(int64_t PC) {
+  if (uint64_t(PC) != trace_pc)
+    return;
+  if (trace_pc_hit.exchange(true))
+    return;
+  sim_trace_enable(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// register values of the commit being reported by the calling thread
+static thread_local std::vector<uint64_t> commit_data;
+
+void dpi_commit_data(int lane, int64_t value) {
+  if (lane >= (int)commit_data.size()) {
+    commit_data.resize(lane + 1);
+  }
+  commit_data[lane] = value;
+}
+
+void dpi_commit(int64_t uuid, int64_t PC, int64_t tmask, bool wb, int rd, bool eop) {
+  vortex::CommitLog::record_t record = {};
+  record.uuid  = uuid;
+  record.PC    = PC;
+  record.tmask = tmask;
+  record.rd    = rd;
+  record.type  = vortex::CommitLog::COMMIT;
+  record.wb    = wb;
+  vortex::CommitLog::instance().commit(record, commit_data.data(), eop);
+}
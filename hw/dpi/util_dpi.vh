@@ -29,5 +29,9 @@ import "DPI-C" function void dpi_assert(int inst, input logic cond, input int de
 import "DPI-C" function void dpi_trace(input int level, input string format /*verilator sformat*/);
 import "DPI-C" function void dpi_trace_start();
 import "DPI-C" function void dpi_trace_stop();
+import "DPI-C" function void dpi_trace_pc(input longint PC);
+
+import "DPI-C" function void dpi_commit_data(input int lane, input longint value);
+import "DPI-C" function void dpi_commit(input longint uuid, input longint PC, input longint tmask, input logic wb, input int rd, input logic eop);
 
 `endif
@@ -56,6 +56,9 @@
 `ifdef SCOPE
 `define UUID_ENABLE
 `define UUID_WIDTH      44
+`elsif COSIM_ENABLE
+`define UUID_ENABLE
+`define UUID_WIDTH      44
 `else
 `define UUID_WIDTH      1
 `endif
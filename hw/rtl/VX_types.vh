@@ -35,6 +35,8 @@
 `define VX_DCR_MPM_CLASS_NONE           0
 `define VX_DCR_MPM_CLASS_CORE           1
 `define VX_DCR_MPM_CLASS_MEM            2
+`define VX_DCR_MPM_CLASS_SIMT           3
+`define VX_DCR_MPM_CLASS_AMO            4
 
 // User Floating-Point CSRs ///////////////////////////////////////////////////
 
@@ -110,6 +112,13 @@
 `define VX_CSR_MPM_IFETCH_LT_H          12'hB91
 `define VX_CSR_MPM_LOAD_LT              12'hB12
 `define VX_CSR_MPM_LOAD_LT_H            12'hB92
+// PERF: functional units (simx only)
+`define VX_CSR_MPM_ALU_ST               12'hB13     // alu structural stalls
+`define VX_CSR_MPM_ALU_ST_H             12'hB93
+`define VX_CSR_MPM_FPU_ST               12'hB14     // fpu structural stalls
+`define VX_CSR_MPM_FPU_ST_H             12'hB94
+`define VX_CSR_MPM_SFU_ST               12'hB15     // sfu structural stalls
+`define VX_CSR_MPM_SFU_ST_H             12'hB95
 
 // Machine Performance-monitoring memory counters (class 2) ///////////////////
 
@@ -179,8 +188,45 @@
 `define VX_CSR_MPM_COALESCER_MISS       12'hB1F     // coalescer misses
 `define VX_CSR_MPM_COALESCER_MISS_H     12'hB9F
 
-// Machine Performance-monitoring memory counters (class 3) ///////////////////
-// <Add your own counters: use addresses hB03..B1F, hB83..hB9F>
+// Machine Performance-monitoring SIMT counters (class 3) /////////////////////
+// Only simx implements these counters.
+
+// PERF: divergence
+`define VX_CSR_MPM_SPLITS               12'hB03     // executed splits
+`define VX_CSR_MPM_SPLITS_H             12'hB83
+`define VX_CSR_MPM_SPLITS_DIV           12'hB04     // divergent splits
+`define VX_CSR_MPM_SPLITS_DIV_H         12'hB84
+`define VX_CSR_MPM_SPLIT_LANES          12'hB05     // active lanes at splits
+`define VX_CSR_MPM_SPLIT_LANES_H        12'hB85
+`define VX_CSR_MPM_RECONV_DIST          12'hB06     // instructions from divergence to reconvergence
+`define VX_CSR_MPM_RECONV_DIST_H        12'hB86
+`define VX_CSR_MPM_ACTIVE_LANES         12'hB07     // active lanes over all instructions
+`define VX_CSR_MPM_ACTIVE_LANES_H       12'hB87
+
+// Machine Performance-monitoring atomics counters (class 4) //////////////////
+// The memory counters (class 2) are full, the atomics get their own class.
+// Only simx implements these counters.
+
+// PERF: lmem
+`define VX_CSR_MPM_LMEM_AMOS            12'hB03     // atomic operations
+`define VX_CSR_MPM_LMEM_AMOS_H          12'hB83
+`define VX_CSR_MPM_LMEM_AMO_ST          12'hB04     // atomic bank stalls
+`define VX_CSR_MPM_LMEM_AMO_ST_H        12'hB84
+// PERF: dcache
+`define VX_CSR_MPM_DCACHE_AMOS          12'hB05     // atomic operations
+`define VX_CSR_MPM_DCACHE_AMOS_H        12'hB85
+`define VX_CSR_MPM_DCACHE_AMO_ST        12'hB06     // atomic line stalls
+`define VX_CSR_MPM_DCACHE_AMO_ST_H      12'hB86
+// PERF: l2cache
+`define VX_CSR_MPM_L2CACHE_AMOS         12'hB07     // atomic operations
+`define VX_CSR_MPM_L2CACHE_AMOS_H       12'hB87
+`define VX_CSR_MPM_L2CACHE_AMO_ST       12'hB08     // atomic line stalls
+`define VX_CSR_MPM_L2CACHE_AMO_ST_H     12'hB88
+// PERF: l3cache
+`define VX_CSR_MPM_L3CACHE_AMOS         12'hB09     // atomic operations
+`define VX_CSR_MPM_L3CACHE_AMOS_H       12'hB89
+`define VX_CSR_MPM_L3CACHE_AMO_ST       12'hB0A     // atomic line stalls
+`define VX_CSR_MPM_L3CACHE_AMO_ST_H     12'hB8A
 
 // Machine Information Registers //////////////////////////////////////////////
 
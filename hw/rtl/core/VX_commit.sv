@@ -173,6 +173,36 @@ module VX_commit import VX_gpu_pkg::*; #(
         assign commit_arb_if[i].ready = 1'b1; // writeback has no backpressure
     end
 
+`ifdef COSIM_ENABLE
+    // export the commit stream for co-simulation
+    for (genvar i = 0; i < `ISSUE_WIDTH; ++i) begin : g_cosim
+        always @(posedge clk) begin
+            if (~reset && per_issue_commit_fire[i]) begin
+                for (integer j = 0; j < `NUM_THREADS; ++j) begin
+                    dpi_commit_data(j, 64'(commit_arb_if[i].data.data[j]));
+                end
+                dpi_commit(64'(commit_arb_if[i].data.uuid),
+                           64'({commit_arb_if[i].data.PC, 1'b0}),
+                           64'(commit_arb_if[i].data.tmask),
+                           commit_arb_if[i].data.wb,
+                           32'(commit_arb_if[i].data.rd),
+                           commit_arb_if[i].data.eop);
+            end
+        end
+    end
+`endif
+
+`ifdef VCD_OUTPUT
+    // waveform capture trigger
+    for (genvar i = 0; i < `ISSUE_WIDTH; ++i) begin : g_trace_pc
+        always @(posedge clk) begin
+            if (~reset && per_issue_commit_fire[i] && per_issue_commit_eop[i]) begin
+                dpi_trace_pc(64'({commit_arb_if[i].data.PC, 1'b0}));
+            end
+        end
+    end
+`endif
+
 `ifdef DBG_TRACE_PIPELINE
     for (genvar i = 0; i < `ISSUE_WIDTH; ++i) begin : g_trace
         for (genvar j = 0; j < `NUM_EX_UNITS; ++j) begin : g_j
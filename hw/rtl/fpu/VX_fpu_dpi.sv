@@ -73,114 +73,65 @@ module VX_fpu_dpi import VX_fpu_pkg::*; #(
     fflags_t div_fflags, sqrt_fflags;
 
     reg [FPC_BITS-1:0] core_select;
+    reg is_div, is_fcmp;
 
-    reg is_fadd, is_fsub, is_fmul, is_fmadd, is_fmsub, is_fnmadd, is_fnmsub;
-    reg is_div, is_fcmp, is_itof, is_utof, is_ftoi, is_ftou, is_f2f;
+    `STATIC_ASSERT(NUM_LANES <= 64, ("invalid parameter"));
 
-    reg [NUM_LANES-1:0][63:0] operands [3];
+    longint operands_a [NUM_LANES];
+    longint operands_b [NUM_LANES];
+    longint operands_c [NUM_LANES];
 
     always @(*) begin
         for (integer i = 0; i < NUM_LANES; ++i) begin
-            operands[0][i] = 64'(dataa[i]);
-            operands[1][i] = 64'(datab[i]);
-            operands[2][i] = 64'(datac[i]);
+            operands_a[i] = 64'(dataa[i]);
+            operands_b[i] = 64'(datab[i]);
+            operands_c[i] = 64'(datac[i]);
         end
     end
 
-    wire f_fmt = fmt[0];
-    wire i_fmt = fmt[1];
+    wire [63:0] lane_mask = 64'(mask_in);
 
     always @(*) begin
-        is_fadd   = 0;
-        is_fsub   = 0;
-        is_fmul   = 0;
-        is_fmadd  = 0;
-        is_fmsub  = 0;
-        is_fnmadd = 0;
-        is_fnmsub = 0;
-        is_div    = 0;
-        is_fcmp   = 0;
-        is_itof   = 0;
-        is_utof   = 0;
-        is_ftoi   = 0;
-        is_ftou   = 0;
-        is_f2f    = 0;
-
+        is_div  = 0;
+        is_fcmp = 0;
         case (op_type)
-            `INST_FPU_ADD:   begin core_select = FPU_FMA; is_fadd = ~i_fmt; is_fsub = i_fmt; end
-            `INST_FPU_MADD:  begin core_select = FPU_FMA; is_fmadd = ~i_fmt; is_fmsub = i_fmt; end
-            `INST_FPU_NMADD: begin core_select = FPU_FMA; is_fnmadd = ~i_fmt; is_fnmsub = i_fmt; end
-            `INST_FPU_MUL:   begin core_select = FPU_FMA; is_fmul = 1; end
+            `INST_FPU_ADD,
+            `INST_FPU_MADD,
+            `INST_FPU_NMADD,
+            `INST_FPU_MUL:   core_select = FPU_FMA;
             `INST_FPU_DIV:   begin core_select = FPU_DIVSQRT; is_div = 1; end
-            `INST_FPU_SQRT:  begin core_select = FPU_DIVSQRT; end
+            `INST_FPU_SQRT:  core_select = FPU_DIVSQRT;
             `INST_FPU_CMP:   begin core_select = FPU_NCP; is_fcmp = 1; end
-            `INST_FPU_F2I:   begin core_select = FPU_CVT; is_ftoi = 1; end
-            `INST_FPU_F2U:   begin core_select = FPU_CVT; is_ftou = 1; end
-            `INST_FPU_I2F:   begin core_select = FPU_CVT; is_itof = 1; end
-            `INST_FPU_U2F:   begin core_select = FPU_CVT; is_utof = 1; end
-            `INST_FPU_F2F:   begin core_select = FPU_CVT; is_f2f  = 1; end
-            default:         begin core_select = FPU_NCP; end
+            `INST_FPU_F2I,
+            `INST_FPU_F2U,
+            `INST_FPU_I2F,
+            `INST_FPU_U2F,
+            `INST_FPU_F2F:   core_select = FPU_CVT;
+            default:         core_select = FPU_NCP;
         endcase
     end
 
+    // Each unit evaluates only the requested operation on the active lanes
+    // with a single DPI call per request.
+
     generate
     begin : g_fma
 
         reg [NUM_LANES-1:0][`XLEN-1:0] result_fma;
-        reg [NUM_LANES-1:0][63:0] result_fadd;
-        reg [NUM_LANES-1:0][63:0] result_fsub;
-        reg [NUM_LANES-1:0][63:0] result_fmul;
-        reg [NUM_LANES-1:0][63:0] result_fmadd;
-        reg [NUM_LANES-1:0][63:0] result_fmsub;
-        reg [NUM_LANES-1:0][63:0] result_fnmadd;
-        reg [NUM_LANES-1:0][63:0] result_fnmsub;
-
-        fflags_t [NUM_LANES-1:0] fflags_fma;
-        fflags_t [NUM_LANES-1:0] fflags_fadd;
-        fflags_t [NUM_LANES-1:0] fflags_fsub;
-        fflags_t [NUM_LANES-1:0] fflags_fmul;
-        fflags_t [NUM_LANES-1:0] fflags_fmadd;
-        fflags_t [NUM_LANES-1:0] fflags_fmsub;
-        fflags_t [NUM_LANES-1:0] fflags_fnmadd;
-        fflags_t [NUM_LANES-1:0] fflags_fnmsub;
+        longint result_lanes [NUM_LANES];
+        fflags_t fflags_fma;
 
         wire fma_valid = (valid_in && core_select == FPU_FMA);
         wire fma_ready = per_core_ready_out[FPU_FMA] || ~per_core_valid_out[FPU_FMA];
         wire fma_fire  = fma_valid && fma_ready;
 
         always @(*) begin
+            dpi_fpu_lanes(fma_fire, int'(op_type), int'(fmt), frm, lane_mask, operands_a, operands_b, operands_c, result_lanes, fflags_fma);
             for (integer i = 0; i < NUM_LANES; ++i) begin
-                dpi_fadd   (fma_fire, int'(f_fmt), operands[0][i], operands[1][i], frm, result_fadd[i], fflags_fadd[i]);
-                dpi_fsub   (fma_fire, int'(f_fmt), operands[0][i], operands[1][i], frm, result_fsub[i], fflags_fsub[i]);
-                dpi_fmul   (fma_fire, int'(f_fmt), operands[0][i], operands[1][i], frm, result_fmul[i], fflags_fmul[i]);
-                dpi_fmadd  (fma_fire, int'(f_fmt), operands[0][i], operands[1][i], operands[2][i], frm, result_fmadd[i], fflags_fmadd[i]);
-                dpi_fmsub  (fma_fire, int'(f_fmt), operands[0][i], operands[1][i], operands[2][i], frm, result_fmsub[i], fflags_fmsub[i]);
-                dpi_fnmadd (fma_fire, int'(f_fmt), operands[0][i], operands[1][i], operands[2][i], frm, result_fnmadd[i], fflags_fnmadd[i]);
-                dpi_fnmsub (fma_fire, int'(f_fmt), operands[0][i], operands[1][i], operands[2][i], frm, result_fnmsub[i], fflags_fnmsub[i]);
-
-                result_fma[i] = is_fadd   ? result_fadd[i][`XLEN-1:0] :
-                                is_fsub   ? result_fsub[i][`XLEN-1:0] :
-                                is_fmul   ? result_fmul[i][`XLEN-1:0] :
-                                is_fmadd  ? result_fmadd[i][`XLEN-1:0] :
-                                is_fmsub  ? result_fmsub[i][`XLEN-1:0] :
-                                is_fnmadd ? result_fnmadd[i][`XLEN-1:0] :
-                                is_fnmsub ? result_fnmsub[i][`XLEN-1:0] :
-                                            '0;
-
-                fflags_fma[i] = is_fadd   ? fflags_fadd[i] :
-                                is_fsub   ? fflags_fsub[i] :
-                                is_fmul   ? fflags_fmul[i] :
-                                is_fmadd  ? fflags_fmadd[i] :
-                                is_fmsub  ? fflags_fmsub[i] :
-                                is_fnmadd ? fflags_fnmadd[i] :
-                                is_fnmsub ? fflags_fnmsub[i] :
-                                            '0;
+                result_fma[i] = result_lanes[i][`XLEN-1:0];
             end
         end
 
-        fflags_t fflags_merged;
-        `FPU_MERGE_FFLAGS(fflags_merged, fflags_fma, mask_in, NUM_LANES);
-
         VX_shift_register #(
             .DATAW  (1 + TAG_WIDTH + NUM_LANES * `XLEN + $bits(fflags_t)),
             .DEPTH  (`LATENCY_FMA),
@@ -189,7 +140,7 @@ module VX_fpu_dpi import VX_fpu_pkg::*; #(
             .clk      (clk),
             .reset    (reset),
             .enable   (fma_ready),
-            .data_in  ({fma_valid, tag_in, result_fma, fflags_merged}),
+            .data_in  ({fma_valid, tag_in, result_fma, fflags_fma}),
             .data_out ({per_core_valid_out[FPU_FMA], per_core_tag_out[FPU_FMA], per_core_result[FPU_FMA], per_core_fflags[FPU_FMA]})
         );
 
@@ -202,24 +153,21 @@ module VX_fpu_dpi import VX_fpu_pkg::*; #(
     generate
     begin : g_fdiv
 
-        reg [NUM_LANES-1:0][`XLEN-1:0] result_fdiv_r;
-        reg [NUM_LANES-1:0][63:0] result_fdiv;
-        fflags_t [NUM_LANES-1:0] fflags_fdiv;
+        reg [NUM_LANES-1:0][`XLEN-1:0] result_fdiv;
+        longint result_lanes [NUM_LANES];
+        fflags_t fflags_fdiv;
 
         wire fdiv_valid = (valid_in && core_select == FPU_DIVSQRT) && is_div;
         wire fdiv_ready = div_ready_out || ~div_valid_out;
         wire fdiv_fire  = fdiv_valid && fdiv_ready;
 
         always @(*) begin
+            dpi_fpu_lanes(fdiv_fire, int'(op_type), int'(fmt), frm, lane_mask, operands_a, operands_b, operands_c, result_lanes, fflags_fdiv);
             for (integer i = 0; i < NUM_LANES; ++i) begin
-                dpi_fdiv (fdiv_fire, int'(f_fmt), operands[0][i], operands[1][i], frm, result_fdiv[i], fflags_fdiv[i]);
-                result_fdiv_r[i] = result_fdiv[i][`XLEN-1:0];
+                result_fdiv[i] = result_lanes[i][`XLEN-1:0];
             end
         end
 
-        fflags_t fflags_merged;
-        `FPU_MERGE_FFLAGS(fflags_merged, fflags_fdiv, mask_in, NUM_LANES);
-
         VX_shift_register #(
             .DATAW  (1 + TAG_WIDTH + NUM_LANES * `XLEN + $bits(fflags_t)),
             .DEPTH  (`LATENCY_FDIV),
@@ -228,7 +176,7 @@ module VX_fpu_dpi import VX_fpu_pkg::*; #(
             .clk      (clk),
             .reset    (reset),
             .enable   (fdiv_ready),
-            .data_in  ({fdiv_valid, tag_in, result_fdiv_r, fflags_merged}),
+            .data_in  ({fdiv_valid, tag_in, result_fdiv, fflags_fdiv}),
             .data_out ({div_valid_out, div_tag_out, div_result, div_fflags})
         );
 
@@ -241,24 +189,21 @@ module VX_fpu_dpi import VX_fpu_pkg::*; #(
     generate
     begin : g_fsqrt
 
-        reg [NUM_LANES-1:0][`XLEN-1:0] result_fsqrt_r;
-        reg [NUM_LANES-1:0][63:0] result_fsqrt;
-        fflags_t [NUM_LANES-1:0] fflags_fsqrt;
+        reg [NUM_LANES-1:0][`XLEN-1:0] result_fsqrt;
+        longint result_lanes [NUM_LANES];
+        fflags_t fflags_fsqrt;
 
         wire fsqrt_valid = (valid_in && core_select == FPU_DIVSQRT) && ~is_div;
         wire fsqrt_ready = sqrt_ready_out || ~sqrt_valid_out;
         wire fsqrt_fire  = fsqrt_valid && fsqrt_ready;
 
         always @(*) begin
+            dpi_fpu_lanes(fsqrt_fire, int'(op_type), int'(fmt), frm, lane_mask, operands_a, operands_b, operands_c, result_lanes, fflags_fsqrt);
             for (integer i = 0; i < NUM_LANES; ++i) begin
-                dpi_fsqrt (fsqrt_fire, int'(f_fmt), operands[0][i], frm, result_fsqrt[i], fflags_fsqrt[i]);
-                result_fsqrt_r[i] = result_fsqrt[i][`XLEN-1:0];
+                result_fsqrt[i] = result_lanes[i][`XLEN-1:0];
             end
         end
 
-        fflags_t fflags_merged;
-        `FPU_MERGE_FFLAGS(fflags_merged, fflags_fsqrt, mask_in, NUM_LANES);
-
         VX_shift_register #(
             .DATAW  (1 + TAG_WIDTH + NUM_LANES * `XLEN + $bits(fflags_t)),
             .DEPTH  (`LATENCY_FSQRT),
@@ -267,7 +212,7 @@ module VX_fpu_dpi import VX_fpu_pkg::*; #(
             .clk      (clk),
             .reset    (reset),
             .enable   (fsqrt_ready),
-            .data_in  ({fsqrt_valid, tag_in, result_fsqrt_r, fflags_merged}),
+            .data_in  ({fsqrt_valid, tag_in, result_fsqrt, fflags_fsqrt}),
             .data_out ({sqrt_valid_out, sqrt_tag_out, sqrt_result, sqrt_fflags})
         );
 
@@ -281,48 +226,20 @@ module VX_fpu_dpi import VX_fpu_pkg::*; #(
     begin : g_fcvt
 
         reg [NUM_LANES-1:0][`XLEN-1:0] result_fcvt;
-        reg [NUM_LANES-1:0][63:0] result_itof;
-        reg [NUM_LANES-1:0][63:0] result_utof;
-        reg [NUM_LANES-1:0][63:0] result_ftoi;
-        reg [NUM_LANES-1:0][63:0] result_ftou;
-        reg [NUM_LANES-1:0][63:0] result_f2f;
-
-        fflags_t [NUM_LANES-1:0] fflags_fcvt;
-        fflags_t [NUM_LANES-1:0] fflags_itof;
-        fflags_t [NUM_LANES-1:0] fflags_utof;
-        fflags_t [NUM_LANES-1:0] fflags_ftoi;
-        fflags_t [NUM_LANES-1:0] fflags_ftou;
+        longint result_lanes [NUM_LANES];
+        fflags_t fflags_fcvt;
 
         wire fcvt_valid = (valid_in && core_select == FPU_CVT);
         wire fcvt_ready = per_core_ready_out[FPU_CVT] || ~per_core_valid_out[FPU_CVT];
         wire fcvt_fire  = fcvt_valid && fcvt_ready;
 
         always @(*) begin
+            dpi_fpu_lanes(fcvt_fire, int'(op_type), int'(fmt), frm, lane_mask, operands_a, operands_b, operands_c, result_lanes, fflags_fcvt);
             for (integer i = 0; i < NUM_LANES; ++i) begin
-                dpi_itof (fcvt_fire, int'(f_fmt), int'(i_fmt), operands[0][i], frm, result_itof[i], fflags_itof[i]);
-                dpi_utof (fcvt_fire, int'(f_fmt), int'(i_fmt), operands[0][i], frm, result_utof[i], fflags_utof[i]);
-                dpi_ftoi (fcvt_fire, int'(i_fmt), int'(f_fmt), operands[0][i], frm, result_ftoi[i], fflags_ftoi[i]);
-                dpi_ftou (fcvt_fire, int'(i_fmt), int'(f_fmt), operands[0][i], frm, result_ftou[i], fflags_ftou[i]);
-                dpi_f2f  (fcvt_fire, int'(f_fmt), operands[0][i], result_f2f[i]);
-
-                result_fcvt[i] = is_itof ? result_itof[i][`XLEN-1:0] :
-                                is_utof ? result_utof[i][`XLEN-1:0] :
-                                is_ftoi ? result_ftoi[i][`XLEN-1:0] :
-                                is_ftou ? result_ftou[i][`XLEN-1:0] :
-                                is_f2f  ? result_f2f[i][`XLEN-1:0] :
-                                        '0;
-
-                fflags_fcvt[i] = is_itof ? fflags_itof[i] :
-                                is_utof ? fflags_utof[i] :
-                                is_ftoi ? fflags_ftoi[i] :
-                                is_ftou ? fflags_ftou[i] :
-                                       '0;
+                result_fcvt[i] = result_lanes[i][`XLEN-1:0];
             end
         end
 
-        fflags_t fflags_merged;
-        `FPU_MERGE_FFLAGS(fflags_merged, fflags_fcvt, mask_in, NUM_LANES);
-
         VX_shift_register #(
             .DATAW  (1 + TAG_WIDTH + NUM_LANES * `XLEN + $bits(fflags_t)),
             .DEPTH  (`LATENCY_FCVT),
@@ -331,7 +248,7 @@ module VX_fpu_dpi import VX_fpu_pkg::*; #(
             .clk      (clk),
             .reset    (reset),
             .enable   (fcvt_ready),
-            .data_in  ({fcvt_valid, tag_in, result_fcvt, fflags_merged}),
+            .data_in  ({fcvt_valid, tag_in, result_fcvt, fflags_fcvt}),
             .data_out ({per_core_valid_out[FPU_CVT], per_core_tag_out[FPU_CVT], per_core_result[FPU_CVT], per_core_fflags[FPU_CVT]})
         );
 
@@ -344,66 +261,21 @@ module VX_fpu_dpi import VX_fpu_pkg::*; #(
     generate
     begin : g_fncp
 
-        reg [NUM_LANES-1:0][`XLEN-1:0]  result_fncp;
-        reg [NUM_LANES-1:0][63:0] result_fclss;
-        reg [NUM_LANES-1:0][63:0] result_flt;
-        reg [NUM_LANES-1:0][63:0] result_fle;
-        reg [NUM_LANES-1:0][63:0] result_feq;
-        reg [NUM_LANES-1:0][63:0] result_fmin;
-        reg [NUM_LANES-1:0][63:0] result_fmax;
-        reg [NUM_LANES-1:0][63:0] result_fsgnj;
-        reg [NUM_LANES-1:0][63:0] result_fsgnjn;
-        reg [NUM_LANES-1:0][63:0] result_fsgnjx;
-        reg [NUM_LANES-1:0][63:0] result_fmvx;
-        reg [NUM_LANES-1:0][63:0] result_fmvf;
-
-        fflags_t [NUM_LANES-1:0] fflags_fncp;
-        fflags_t [NUM_LANES-1:0] fflags_flt;
-        fflags_t [NUM_LANES-1:0] fflags_fle;
-        fflags_t [NUM_LANES-1:0] fflags_feq;
-        fflags_t [NUM_LANES-1:0] fflags_fmin;
-        fflags_t [NUM_LANES-1:0] fflags_fmax;
+        reg [NUM_LANES-1:0][`XLEN-1:0] result_fncp;
+        longint result_lanes [NUM_LANES];
+        fflags_t fflags_fncp;
 
         wire fncp_valid = (valid_in && core_select == FPU_NCP);
         wire fncp_ready = per_core_ready_out[FPU_NCP] || ~per_core_valid_out[FPU_NCP];
         wire fncp_fire  = fncp_valid && fncp_ready;
 
         always @(*) begin
+            dpi_fpu_lanes(fncp_fire, int'(op_type), int'(fmt), frm, lane_mask, operands_a, operands_b, operands_c, result_lanes, fflags_fncp);
             for (integer i = 0; i < NUM_LANES; ++i) begin
-                dpi_fclss  (fncp_fire, int'(f_fmt), operands[0][i], result_fclss[i]);
-                dpi_fle    (fncp_fire, int'(f_fmt), operands[0][i], operands[1][i], result_fle[i], fflags_fle[i]);
-                dpi_flt    (fncp_fire, int'(f_fmt), operands[0][i], operands[1][i], result_flt[i], fflags_flt[i]);
-                dpi_feq    (fncp_fire, int'(f_fmt), operands[0][i], operands[1][i], result_feq[i], fflags_feq[i]);
-                dpi_fmin   (fncp_fire, int'(f_fmt), operands[0][i], operands[1][i], result_fmin[i], fflags_fmin[i]);
-                dpi_fmax   (fncp_fire, int'(f_fmt), operands[0][i], operands[1][i], result_fmax[i], fflags_fmax[i]);
-                dpi_fsgnj  (fncp_fire, int'(f_fmt), operands[0][i], operands[1][i], result_fsgnj[i]);
-                dpi_fsgnjn (fncp_fire, int'(f_fmt), operands[0][i], operands[1][i], result_fsgnjn[i]);
-                dpi_fsgnjx (fncp_fire, int'(f_fmt), operands[0][i], operands[1][i], result_fsgnjx[i]);
-                result_fmvx[i] = f_fmt ? operands[0][i] : 64'($signed(operands[0][i][31:0]));      // sign-extension
-                result_fmvf[i] = f_fmt ? operands[0][i] : (operands[0][i] | 64'hffffffff00000000); // nan-boxing
+                result_fncp[i] = result_lanes[i][`XLEN-1:0];
             end
         end
 
-        always @(*) begin
-            result_fncp = 'x;
-            fflags_fncp = 'x;
-            for (integer i = 0; i < NUM_LANES; ++i) begin
-                case (frm)
-                0:  begin result_fncp[i] = is_fcmp ? result_fle[i][`XLEN-1:0] : result_fsgnj[i][`XLEN-1:0];  fflags_fncp[i] = fflags_fle[i]; end
-                1:  begin result_fncp[i] = is_fcmp ? result_flt[i][`XLEN-1:0] : result_fsgnjn[i][`XLEN-1:0]; fflags_fncp[i] = fflags_flt[i]; end
-                2:  begin result_fncp[i] = is_fcmp ? result_feq[i][`XLEN-1:0] : result_fsgnjx[i][`XLEN-1:0]; fflags_fncp[i] = fflags_feq[i]; end
-                3:  begin result_fncp[i] = result_fclss[i][`XLEN-1:0]; end
-                4:  begin result_fncp[i] = result_fmvx[i][`XLEN-1:0]; end
-                5:  begin result_fncp[i] = result_fmvf[i][`XLEN-1:0]; end
-                6:  begin result_fncp[i] = result_fmin[i][`XLEN-1:0]; fflags_fncp[i] = fflags_fmin[i]; end
-                7:  begin result_fncp[i] = result_fmax[i][`XLEN-1:0]; fflags_fncp[i] = fflags_fmax[i]; end
-                endcase
-            end
-        end
-
-        fflags_t fflags_merged;
-        `FPU_MERGE_FFLAGS(fflags_merged, fflags_fncp, mask_in, NUM_LANES);
-
         wire has_fflags_fncp = (frm >= 6) || is_fcmp;
 
         VX_shift_register #(
@@ -414,7 +286,7 @@ module VX_fpu_dpi import VX_fpu_pkg::*; #(
             .clk      (clk),
             .reset    (reset),
             .enable   (fncp_ready),
-            .data_in  ({fncp_valid, tag_in, has_fflags_fncp, result_fncp, fflags_merged}),
+            .data_in  ({fncp_valid, tag_in, has_fflags_fncp, result_fncp, fflags_fncp}),
             .data_out ({per_core_valid_out[FPU_NCP], per_core_tag_out[FPU_NCP], per_core_has_fflags[FPU_NCP], per_core_result[FPU_NCP], per_core_fflags[FPU_NCP]})
         );
 
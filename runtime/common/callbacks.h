@@ -48,6 +48,9 @@ typedef struct {
   // get device memory info
   int (*mem_info) (vx_device_h hdevice, uint64_t* mem_free, uint64_t* mem_used);
 
+  // get device memory allocator statistics
+  int (*mem_stats) (vx_device_h hdevice, uint32_t stats_id, uint64_t* value);
+
   // Copy bytes from host to device memory
   int (*copy_to_dev) (vx_buffer_h hbuffer, const void* host_ptr, uint64_t dst_offset, uint64_t size);
 
@@ -69,6 +72,18 @@ typedef struct {
   // query device performance counter
   int (*mpm_query) (vx_device_h hdevice, uint32_t addr, uint32_t core_id, uint64_t* value);
 
+  // start sampling all performance stream counters
+  int (*perf_stream_open) (vx_device_h hdevice, uint64_t interval);
+
+  // read pending samples of VX_PERF_STREAM_NUM_COUNTERS values
+  int (*perf_stream_read) (vx_device_h hdevice, uint64_t* values, uint32_t max_samples, uint32_t* num_samples);
+
+  // stop sampling performance stream counters
+  int (*perf_stream_close) (vx_device_h hdevice);
+
+  // preload a memory range into the caches before the next start
+  int (*cache_warm) (vx_device_h hdevice, uint64_t addr, uint64_t size, uint32_t level);
+
 } callbacks_t;
 
 int vx_dev_init(callbacks_t* callbacks);
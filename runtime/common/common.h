@@ -19,6 +19,7 @@
 #include <VX_types.h>
 #include <callbacks.h>
 #include <mem_alloc.h>
+#include <perf_stream.h>
 
 #include <cstdint>
 #include <unordered_map>
@@ -28,6 +29,8 @@
 
 #define RAM_PAGE_SIZE     4096 // Please use MEM_PAGE_SIZE in VX_config.h
 
+#define PERF_STREAM_CAPACITY 16384 // samples
+
 #define ALLOC_BASE_ADDR   USER_BASE_ADDR
 
 #if (XLEN == 64)
@@ -75,4 +78,41 @@ inline uint64_t aligned_size(uint64_t size, uint64_t alignment) {
 inline bool is_aligned(uint64_t addr, uint64_t alignment) {
   assert(0 == (alignment & (alignment - 1)));
   return 0 == (addr & (alignment - 1));
+}
+
+inline int get_mem_stats(const vortex::MemoryAllocator& allocator, uint32_t stats_id, uint64_t* value) {
+  switch (stats_id) {
+  case VX_MEM_STATS_PEAK_USED:
+    *value = allocator.peak();
+    break;
+  case VX_MEM_STATS_LARGEST_FREE:
+    *value = allocator.largestFree();
+    break;
+  case VX_MEM_STATS_FRAGMENTATION:
+    *value = uint64_t(allocator.fragmentation() * 100.0 + 0.5);
+    break;
+  case VX_MEM_STATS_NUM_ALLOCS:
+    *value = allocator.allocations();
+    break;
+  default:
+    printf("[VXDRV] Error: invalid memory stats id: %d\n", stats_id);
+    return -1;
+  }
+  return 0;
+}
+
+inline int read_perf_stream(vortex::PerfStream* stream, uint64_t* values, uint32_t max_samples, uint32_t* num_samples) {
+  static_assert(vortex::PerfStream::NUM_COUNTERS == VX_PERF_STREAM_NUM_COUNTERS, "invalid perf stream counters");
+  if (nullptr == stream)
+    return -1;
+  uint32_t count = 0;
+  vortex::PerfStream::sample_t sample;
+  while (count < max_samples && stream->pop(&sample)) {
+    for (uint32_t i = 0; i < VX_PERF_STREAM_NUM_COUNTERS; ++i) {
+      *values++ = sample.values[i];
+    }
+    ++count;
+  }
+  *num_samples = count;
+  return 0;
 }
\ No newline at end of file
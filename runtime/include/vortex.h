@@ -39,6 +39,27 @@ typedef void* vx_buffer_h;
 #define VX_CAPS_TC_SIZE             0xA
 #define VX_CAPS_TC_NUM              0xB
 
+// device memory stats ids
+#define VX_MEM_STATS_PEAK_USED      0x0
+#define VX_MEM_STATS_LARGEST_FREE   0x1
+#define VX_MEM_STATS_FRAGMENTATION  0x2   // percent of free memory outside the largest free block
+#define VX_MEM_STATS_NUM_ALLOCS     0x3
+
+// performance stream counter ids
+#define VX_PERF_STREAM_CYCLES         0
+#define VX_PERF_STREAM_INSTRS         1
+#define VX_PERF_STREAM_SCHED_STALLS   2
+#define VX_PERF_STREAM_IBUF_STALLS    3
+#define VX_PERF_STREAM_SCRB_STALLS    4
+#define VX_PERF_STREAM_ICACHE_MISSES  5
+#define VX_PERF_STREAM_DCACHE_MISSES  6
+#define VX_PERF_STREAM_L2CACHE_MISSES 7
+#define VX_PERF_STREAM_L3CACHE_MISSES 8
+#define VX_PERF_STREAM_MEM_READS      9
+#define VX_PERF_STREAM_MEM_WRITES     10
+#define VX_PERF_STREAM_MEM_LATENCY    11
+#define VX_PERF_STREAM_NUM_COUNTERS   12
+
 // device isa flags
 #define VX_ISA_STD_A                (1ull << ISA_STD_A)
 #define VX_ISA_STD_C                (1ull << ISA_STD_C)
@@ -98,6 +119,9 @@ int vx_mem_address(vx_buffer_h hbuffer, uint64_t* address);
 // get device memory info
 int vx_mem_info(vx_device_h hdevice, uint64_t* mem_free, uint64_t* mem_used);
 
+// get device memory allocator statistics
+int vx_mem_stats(vx_device_h hdevice, uint32_t stats_id, uint64_t* value);
+
 // Copy bytes from host to device memory
 int vx_copy_to_dev(vx_buffer_h hbuffer, const void* host_ptr, uint64_t dst_offset, uint64_t size);
 
@@ -119,12 +143,26 @@ int vx_dcr_write(vx_device_h hdevice, uint32_t addr, uint32_t value);
 // query device performance counter
 int vx_mpm_query(vx_device_h hdevice, uint32_t addr, uint32_t core_id, uint64_t* value);
 
+// sample the selected counters (mask of VX_PERF_STREAM_* bits) every interval cycles while the device runs
+int vx_perf_stream_open(vx_device_h hdevice, uint64_t interval, uint32_t counters);
+
+// read pending samples, each holds the selected cumulative counters in id order
+int vx_perf_stream_read(vx_device_h hdevice, uint64_t* values, uint32_t max_samples, uint32_t* num_samples);
+
+// stop sampling performance counters
+int vx_perf_stream_close(vx_device_h hdevice);
+
+// preload the device memory range into the caches before the next start,
+// from level 1 (core caches), 2 (L2) or 3 (L3) down (simulation only)
+int vx_cache_warm(vx_device_h hdevice, uint64_t addr, uint64_t size, uint32_t level);
+
 ////////////////////////////// UTILITY FUNCTIONS //////////////////////////////
 
-// upload bytes to device
+// upload kernel image (ELF or vxbin) to device
+// identical images are cached and stay resident until the device is closed
 int vx_upload_kernel_bytes(vx_device_h hdevice, const void* content, uint64_t size, vx_buffer_h* hbuffer);
 
-// upload file to device
+// upload kernel file (ELF or vxbin) to device
 int vx_upload_kernel_file(vx_device_h hdevice, const char* filename, vx_buffer_h* hbuffer);
 
 // upload bytes to device
@@ -133,12 +171,20 @@ int vx_upload_bytes(vx_device_h hdevice, const void* content, uint64_t size, vx_
 // upload file to device
 int vx_upload_file(vx_device_h hdevice, const char* filename, vx_buffer_h* hbuffer);
 
+// upload kernel arguments and start device execution
+// the argument block stays at a fixed device address so relaunching only
+// transfers the arguments, waits for the previous launch to complete first
+int vx_launch(vx_device_h hdevice, vx_buffer_h hkernel, const void* args, uint64_t size);
+
 // calculate cooperative threads array occupancy
 int vx_check_occupancy(vx_device_h hdevice, uint32_t group_size, uint32_t* max_localmem);
 
 // performance counters
 int vx_dump_perf(vx_device_h hdevice, FILE* stream);
 
+// write pending performance stream samples as CSV rows of per-interval deltas
+int vx_perf_stream_dump(vx_device_h hdevice, FILE* stream);
+
 #ifdef __cplusplus
 }
 #endif
@@ -142,6 +142,10 @@ public:
     return 0;
   }
 
+  int mem_stats(uint32_t stats_id, uint64_t* value) const {
+    return get_mem_stats(global_mem_, stats_id, value);
+  }
+
   int upload(uint64_t dest_addr, const void* src, uint64_t size) {
     uint64_t asize = aligned_size(size, CACHE_BLOCK_SIZE);
     if (dest_addr + asize > GLOBAL_MEM_SIZE)
@@ -190,15 +194,15 @@ public:
       future_.wait();
     }
 
-    // set kernel info
-    this->dcr_write(VX_DCR_BASE_STARTUP_ADDR0, krnl_addr & 0xffffffff);
-    this->dcr_write(VX_DCR_BASE_STARTUP_ADDR1, krnl_addr >> 32);
-    this->dcr_write(VX_DCR_BASE_STARTUP_ARG0, args_addr & 0xffffffff);
-    this->dcr_write(VX_DCR_BASE_STARTUP_ARG1, args_addr >> 32);
+    // set kernel info, skipping registers that already hold the value
+    this->dcr_update(VX_DCR_BASE_STARTUP_ADDR0, krnl_addr & 0xffffffff);
+    this->dcr_update(VX_DCR_BASE_STARTUP_ADDR1, krnl_addr >> 32);
+    this->dcr_update(VX_DCR_BASE_STARTUP_ARG0, args_addr & 0xffffffff);
+    this->dcr_update(VX_DCR_BASE_STARTUP_ARG1, args_addr >> 32);
 
     // start new run
     future_ = std::async(std::launch::async, [&]{
-      processor_.run();
+      return processor_.run();
     });
 
     // clear mpm cache
@@ -220,7 +224,8 @@ public:
       if (0 == timeout_sec--)
         return -1;
     }
-    return 0;
+    // report a failed run once
+    return future_.get();
   }
 
   int dcr_write(uint32_t addr, uint32_t value) {
@@ -236,6 +241,13 @@ public:
     return dcrs_.read(addr, value);
   }
 
+  int dcr_update(uint32_t addr, uint32_t value) {
+    uint32_t cached;
+    if (0 == dcrs_.read(addr, &cached) && cached == value)
+      return 0;
+    return this->dcr_write(addr, value);
+  }
+
   int mpm_query(uint32_t addr, uint32_t core_id, uint64_t* value) {
     uint32_t offset = addr - VX_CSR_MPM_BASE;
     if (offset > 31)
@@ -250,14 +262,42 @@ public:
     return 0;
   }
 
+  int perf_stream_open(uint64_t interval) {
+    if (future_.valid()) {
+      future_.wait(); // ensure prior run completed
+    }
+    perf_stream_ = std::make_shared<PerfStream>(interval, PERF_STREAM_CAPACITY);
+    processor_.attach_perf_stream(perf_stream_.get());
+    return 0;
+  }
+
+  int perf_stream_read(uint64_t* values, uint32_t max_samples, uint32_t* num_samples) {
+    return read_perf_stream(perf_stream_.get(), values, max_samples, num_samples);
+  }
+
+  int perf_stream_close() {
+    if (future_.valid()) {
+      future_.wait(); // ensure prior run completed
+    }
+    processor_.attach_perf_stream(nullptr);
+    perf_stream_ = nullptr;
+    return 0;
+  }
+
+  int cache_warm(uint64_t /*addr*/, uint64_t /*size*/, uint32_t /*level*/) {
+    printf("[VXDRV] Error: cache warming is not supported on this device\n");
+    return -1;
+  }
+
 private:
 
   RAM                 ram_;
   Processor           processor_;
   MemoryAllocator     global_mem_;
   DeviceConfig        dcrs_;
-  std::future<void>   future_;
+  std::future<int>    future_;
   std::unordered_map<uint32_t, std::array<uint64_t, 32>> mpm_cache_;
+  std::shared_ptr<PerfStream> perf_stream_;
 };
 
 #include <callbacks.inc>
\ No newline at end of file
@@ -19,8 +19,11 @@
 #include <cstring>
 #include <vector>
 #include <unordered_map>
+#include <algorithm>
+#include <mutex>
 #include <vortex.h>
 #include <assert.h>
+#include <elf.h>
 
 class ProfilingMode {
 public:
@@ -46,39 +49,478 @@ int get_profiling_mode() {
   return gProfilingMode.perf_class();
 }
 
-extern int vx_upload_kernel_bytes(vx_device_h hdevice, const void* content, uint64_t size, vx_buffer_h* hbuffer) {
-  if (nullptr == hdevice || nullptr == content || size <= 8 || nullptr == hbuffer)
+// some counters are only implemented by the simx driver
+static bool is_simx_driver() {
+  auto driver_s = getenv("VORTEX_DRIVER");
+  return (driver_s == nullptr) || (strcmp(driver_s, "simx") == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+struct kernel_segment_t {
+  uint64_t vaddr;
+  uint64_t offset;
+  uint64_t filesz;
+  uint64_t memsz;
+  bool     writable;
+};
+
+struct kernel_reloc_t {
+  uint64_t vaddr;   // patched location
+  uint64_t value;   // link-time value (S + A)
+  uint32_t type;
+};
+
+struct kernel_image_t {
+  bool     is_elf;
+  bool     is_64bit;
+  bool     relocatable;
+  uint64_t min_vma;
+  uint64_t max_vma;
+  uint64_t align;
+  std::vector<kernel_segment_t> segments;
+  std::vector<kernel_reloc_t> relocs;
+
+  kernel_image_t()
+    : is_elf(false)
+    , is_64bit(false)
+    , relocatable(false)
+    , min_vma(0)
+    , max_vma(0)
+    , align(1)
+  {}
+
+  uint64_t size() const {
+    return max_vma - min_vma;
+  }
+};
+
+struct elf32_traits_t {
+  typedef Elf32_Ehdr Ehdr;
+  typedef Elf32_Phdr Phdr;
+  typedef Elf32_Shdr Shdr;
+  typedef Elf32_Sym  Sym;
+  typedef Elf32_Rela Rela;
+  static uint32_t r_sym(uint64_t info) { return ELF32_R_SYM(info); }
+  static uint32_t r_type(uint64_t info) { return ELF32_R_TYPE(info); }
+};
+
+struct elf64_traits_t {
+  typedef Elf64_Ehdr Ehdr;
+  typedef Elf64_Phdr Phdr;
+  typedef Elf64_Shdr Shdr;
+  typedef Elf64_Sym  Sym;
+  typedef Elf64_Rela Rela;
+  static uint32_t r_sym(uint64_t info) { return ELF64_R_SYM(info); }
+  static uint32_t r_type(uint64_t info) { return ELF64_R_TYPE(info); }
+};
+
+template <typename T>
+int parse_elf_image(const uint8_t* bytes, uint64_t size, kernel_image_t* image) {
+  typedef typename T::Ehdr Ehdr;
+  typedef typename T::Phdr Phdr;
+  typedef typename T::Shdr Shdr;
+  typedef typename T::Sym  Sym;
+  typedef typename T::Rela Rela;
+
+  if (size < sizeof(Ehdr))
+    return -1;
+  auto ehdr = reinterpret_cast<const Ehdr*>(bytes);
+  if (ehdr->e_machine != EM_RISCV) {
+    printf("error: invalid kernel ELF machine type: %d\n", ehdr->e_machine);
+    return -1;
+  }
+  if (ehdr->e_phentsize != sizeof(Phdr)
+   || (ehdr->e_phoff + uint64_t(ehdr->e_phnum) * sizeof(Phdr)) > size) {
+    printf("error: invalid kernel ELF program headers\n");
+    return -1;
+  }
+
+  // collect loadable segments
+  image->min_vma = UINT64_MAX;
+  image->max_vma = 0;
+  auto phdrs = reinterpret_cast<const Phdr*>(bytes + ehdr->e_phoff);
+  for (uint32_t i = 0; i < ehdr->e_phnum; ++i) {
+    auto& phdr = phdrs[i];
+    if (phdr.p_type != PT_LOAD || phdr.p_memsz == 0)
+      continue;
+    if ((phdr.p_offset + phdr.p_filesz) > size || phdr.p_filesz > phdr.p_memsz) {
+      printf("error: invalid kernel ELF segment #%d\n", i);
+      return -1;
+    }
+    image->segments.push_back({phdr.p_vaddr, phdr.p_offset, phdr.p_filesz, phdr.p_memsz, (phdr.p_flags & PF_W) != 0});
+    image->min_vma = std::min<uint64_t>(image->min_vma, phdr.p_vaddr);
+    image->max_vma = std::max<uint64_t>(image->max_vma, phdr.p_vaddr + phdr.p_memsz);
+    image->align = std::max<uint64_t>(image->align, phdr.p_align);
+  }
+  if (image->segments.empty()) {
+    printf("error: kernel ELF has no loadable segment\n");
+    return -1;
+  }
+
+  // the device starts execution at the kernel buffer address
+  if (ehdr->e_entry != image->min_vma) {
+    printf("error: kernel entry point 0x%lx is not at image base 0x%lx\n", (uint64_t)ehdr->e_entry, image->min_vma);
+    return -1;
+  }
+
+  // collect absolute relocations (available when linked with --emit-relocs)
+  if (ehdr->e_shoff != 0
+   && ehdr->e_shentsize == sizeof(Shdr)
+   && (ehdr->e_shoff + uint64_t(ehdr->e_shnum) * sizeof(Shdr)) <= size) {
+    auto shdrs = reinterpret_cast<const Shdr*>(bytes + ehdr->e_shoff);
+    for (uint32_t i = 0; i < ehdr->e_shnum; ++i) {
+      auto& shdr = shdrs[i];
+      if (shdr.sh_type != SHT_RELA
+       || shdr.sh_info >= ehdr->e_shnum
+       || shdr.sh_link >= ehdr->e_shnum)
+        continue;
+      if (0 == (shdrs[shdr.sh_info].sh_flags & SHF_ALLOC))
+        continue;
+      auto& symtab = shdrs[shdr.sh_link];
+      if ((shdr.sh_offset + shdr.sh_size) > size
+       || (symtab.sh_offset + symtab.sh_size) > size)
+        continue;
+      auto relas = reinterpret_cast<const Rela*>(bytes + shdr.sh_offset);
+      auto syms = reinterpret_cast<const Sym*>(bytes + symtab.sh_offset);
+      uint64_t num_relas = shdr.sh_size / sizeof(Rela);
+      uint64_t num_syms = symtab.sh_size / sizeof(Sym);
+      for (uint64_t j = 0; j < num_relas; ++j) {
+        auto& rela = relas[j];
+        uint32_t type = T::r_type(rela.r_info);
+        uint64_t value;
+        switch (type) {
+        case R_RISCV_RELATIVE:
+          value = rela.r_addend;
+          break;
+        case R_RISCV_32:
+        case R_RISCV_64:
+        case R_RISCV_HI20:
+        case R_RISCV_LO12_I:
+        case R_RISCV_LO12_S: {
+          uint32_t sym_idx = T::r_sym(rela.r_info);
+          if (sym_idx >= num_syms)
+            return -1;
+          auto& sym = syms[sym_idx];
+          if (sym.st_shndx == SHN_ABS || sym.st_shndx == SHN_UNDEF)
+            continue; // absolute values do not move
+          value = sym.st_value + rela.r_addend;
+        } break;
+        default:
+          continue; // pc-relative relocations are position independent
+        }
+        image->relocs.push_back({rela.r_offset, value, type});
+      }
+      image->relocatable = true;
+    }
+  }
+
+  image->is_elf = true;
+  image->is_64bit = (sizeof(Ehdr) == sizeof(Elf64_Ehdr));
+  return 0;
+}
+
+int parse_kernel_image(const uint8_t* bytes, uint64_t size, kernel_image_t* image) {
+  if (size > EI_NIDENT && 0 == memcmp(bytes, ELFMAG, SELFMAG)) {
+    switch (bytes[EI_CLASS]) {
+    case ELFCLASS32: return parse_elf_image<elf32_traits_t>(bytes, size, image);
+    case ELFCLASS64: return parse_elf_image<elf64_traits_t>(bytes, size, image);
+    default:
+      printf("error: invalid kernel ELF class\n");
+      return -1;
+    }
+  }
+
+  // vxbin format: {min_vma, max_vma, raw binary}
+  if (size <= 16)
     return -1;
+  auto header = reinterpret_cast<const uint64_t*>(bytes);
+  image->min_vma = header[0];
+  image->max_vma = header[1];
+  if (image->max_vma < image->min_vma
+   || (size - 16) > image->size())
+    return -1;
+  image->segments.push_back({image->min_vma, 16, size - 16, image->size(), false});
+  return 0;
+}
 
-  auto bytes = reinterpret_cast<const uint64_t*>(content);
+// patch relocated instructions and data inside a segment copy
+void apply_relocs(const kernel_image_t& image, const kernel_segment_t& segment, int64_t delta, uint8_t* data) {
+  for (auto& reloc : image.relocs) {
+    if (reloc.vaddr < segment.vaddr || reloc.vaddr >= (segment.vaddr + segment.filesz))
+      continue;
+    auto ptr = data + (reloc.vaddr - segment.vaddr);
+    uint64_t value = reloc.value + delta;
+    uint32_t insn;
+    memcpy(&insn, ptr, sizeof(uint32_t));
+    switch (reloc.type) {
+    case R_RISCV_RELATIVE:
+      if (image.is_64bit) {
+        memcpy(ptr, &value, sizeof(uint64_t));
+        continue;
+      }
+      [[fallthrough]];
+    case R_RISCV_32:
+      insn = uint32_t(value);
+      break;
+    case R_RISCV_64:
+      memcpy(ptr, &value, sizeof(uint64_t));
+      continue;
+    case R_RISCV_HI20:
+      insn = (insn & 0xfff) | ((uint32_t(value) + 0x800) & 0xfffff000);
+      break;
+    case R_RISCV_LO12_I:
+      insn = (insn & 0x000fffff) | ((uint32_t(value) & 0xfff) << 20);
+      break;
+    case R_RISCV_LO12_S:
+      insn = (insn & 0x01fff07f) | ((uint32_t(value) & 0xfe0) << 20) | ((uint32_t(value) & 0x1f) << 7);
+      break;
+    default:
+      continue;
+    }
+    memcpy(ptr, &insn, sizeof(uint32_t));
+  }
+}
 
-  auto min_vma = *bytes++;
-  auto max_vma = *bytes++;
-  auto bin_size = size - 2 * 8;
-  auto runtime_size = (max_vma - min_vma);
+int zero_fill(vx_buffer_h hbuffer, uint64_t offset, uint64_t size) {
+  static const uint8_t zeros[RAM_PAGE_SIZE] = {};
+  while (size != 0) {
+    uint64_t chunk = std::min<uint64_t>(size, sizeof(zeros));
+    CHECK_ERR(vx_copy_to_dev(hbuffer, zeros, offset, chunk), {
+      return err;
+    });
+    offset += chunk;
+    size -= chunk;
+  }
+  return 0;
+}
 
+// upload the image's segments into a buffer based at the image's min_vma + delta
+int upload_segments(vx_buffer_h hbuffer, const uint8_t* bytes, const kernel_image_t& image, int64_t delta, bool writable_only) {
+  std::vector<uint8_t> patched;
+  for (auto& segment : image.segments) {
+    if (writable_only && !segment.writable)
+      continue;
+    uint64_t offset = segment.vaddr - image.min_vma;
+    auto data = bytes + segment.offset;
+    if (delta != 0 && !image.relocs.empty()) {
+      patched.assign(data, data + segment.filesz);
+      apply_relocs(image, segment, delta, patched.data());
+      data = patched.data();
+    }
+    if (segment.filesz != 0) {
+      CHECK_ERR(vx_copy_to_dev(hbuffer, data, offset, segment.filesz), {
+        return err;
+      });
+    }
+    if (image.is_elf && segment.memsz > segment.filesz) {
+      CHECK_ERR(zero_fill(hbuffer, offset + segment.filesz, segment.memsz - segment.filesz), {
+        return err;
+      });
+    }
+  }
+  return 0;
+}
+
+int load_kernel_image(vx_device_h hdevice, const uint8_t* bytes, const kernel_image_t& image, uint64_t base_addr, vx_buffer_h* hbuffer) {
   vx_buffer_h _hbuffer;
-  CHECK_ERR(vx_mem_reserve(hdevice, min_vma, runtime_size, 0, &_hbuffer), {
+  CHECK_ERR(vx_mem_reserve(hdevice, base_addr, image.size(), 0, &_hbuffer), {
     return err;
   });
 
-  // mask binary region as read-only
-  CHECK_ERR(vx_mem_access(_hbuffer, 0, bin_size, VX_MEM_READ), {
+  if (image.is_elf) {
+    // set access rights per segment
+    for (auto& segment : image.segments) {
+      int flags = segment.writable ? VX_MEM_READ_WRITE : VX_MEM_READ;
+      CHECK_ERR(vx_mem_access(_hbuffer, segment.vaddr - image.min_vma, segment.memsz, flags), {
+        vx_mem_free(_hbuffer);
+        return err;
+      });
+    }
+  } else {
+    auto bin_size = image.segments.at(0).filesz;
+
+    // mask binary region as read-only
+    CHECK_ERR(vx_mem_access(_hbuffer, 0, bin_size, VX_MEM_READ), {
+      vx_mem_free(_hbuffer);
+      return err;
+    });
+
+    // mark global variables region as read-write
+    CHECK_ERR(vx_mem_access(_hbuffer, bin_size, image.size() - bin_size, VX_MEM_READ_WRITE), {
+      vx_mem_free(_hbuffer);
+      return err;
+    });
+  }
+
+  CHECK_ERR(upload_segments(_hbuffer, bytes, image, base_addr - image.min_vma, false), {
     vx_mem_free(_hbuffer);
     return err;
   });
 
-  // mark global variables region as read-write
-  CHECK_ERR(vx_mem_access(_hbuffer, bin_size, runtime_size - bin_size, VX_MEM_READ_WRITE), {
-    vx_mem_free(_hbuffer);
+  *hbuffer = _hbuffer;
+
+  return 0;
+}
+
+// Resident kernel images, keyed by content hash.
+// Buffers stay on the device after vx_mem_free() so that uploading the same
+// kernel again only refreshes its writable segments.
+class KernelCache {
+public:
+  struct entry_t {
+    vx_device_h device;
+    uint64_t    hash;
+    uint64_t    size;
+    uint64_t    base_addr;
+    uint64_t    end_addr;
+    vx_buffer_h buffer;
+    uint32_t    refs;
+  };
+
+  std::mutex mutex;
+  std::list<entry_t> entries;
+
+  static uint64_t hash(const uint8_t* bytes, uint64_t size) {
+    // FNV-1a
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (uint64_t i = 0; i < size; ++i) {
+      h = (h ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return h;
+  }
+
+  entry_t* find(vx_device_h device, uint64_t hash, uint64_t size) {
+    for (auto& entry : entries) {
+      if (entry.device == device && entry.hash == hash && entry.size == size)
+        return &entry;
+    }
+    return nullptr;
+  }
+
+  entry_t* find(vx_buffer_h buffer) {
+    for (auto& entry : entries) {
+      if (entry.buffer == buffer)
+        return &entry;
+    }
+    return nullptr;
+  }
+};
+
+KernelCache& kernel_cache() {
+  static KernelCache gKernelCache;
+  return gKernelCache;
+}
+
+}
+
+// called by vx_mem_free(), return true if the buffer is a cached kernel
+bool kernel_cache_release(vx_buffer_h hbuffer) {
+  auto& cache = kernel_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto entry = cache.find(hbuffer);
+  if (nullptr == entry)
+    return false;
+  if (entry->refs != 0) {
+    --entry->refs;
+  }
+  return true;
+}
+
+// called by vx_dev_close(), release all cached kernels of the device
+void kernel_cache_flush(vx_device_h hdevice) {
+  std::vector<vx_buffer_h> buffers;
+  {
+    auto& cache = kernel_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    for (auto it = cache.entries.begin(); it != cache.entries.end();) {
+      if (it->device == hdevice) {
+        buffers.push_back(it->buffer);
+        it = cache.entries.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (auto buffer : buffers) {
+    vx_mem_free(buffer);
+  }
+}
+
+extern int vx_upload_kernel_bytes(vx_device_h hdevice, const void* content, uint64_t size, vx_buffer_h* hbuffer) {
+  if (nullptr == hdevice || nullptr == content || size <= 8 || nullptr == hbuffer)
+    return -1;
+
+  auto bytes = reinterpret_cast<const uint8_t*>(content);
+
+  kernel_image_t image;
+  CHECK_ERR(parse_kernel_image(bytes, size, &image), {
     return err;
   });
 
-  CHECK_ERR(vx_copy_to_dev(_hbuffer, bytes, 0, bin_size), {
-    vx_mem_free(_hbuffer);
+  auto& cache = kernel_cache();
+  std::unique_lock<std::mutex> lock(cache.mutex);
+
+  auto hash = KernelCache::hash(bytes, size);
+
+  // resident kernel: only refresh its writable segments
+  auto entry = cache.find(hdevice, hash, size);
+  if (entry) {
+    int64_t delta = entry->base_addr - image.min_vma;
+    CHECK_ERR(upload_segments(entry->buffer, bytes, image, delta, image.is_elf), {
+      return err;
+    });
+    ++entry->refs;
+    *hbuffer = entry->buffer;
+    return 0;
+  }
+
+  // evict unused kernels overlapping the link address range
+  // and find the next free address if a kernel in use is in the way
+  uint64_t base_addr = image.min_vma;
+  uint64_t end_addr = image.max_vma;
+  std::vector<vx_buffer_h> evicted;
+  bool conflict = false;
+  uint64_t next_addr = 0;
+  for (auto it = cache.entries.begin(); it != cache.entries.end();) {
+    if (it->device == hdevice) {
+      next_addr = std::max(next_addr, it->end_addr);
+      if (it->base_addr < end_addr && base_addr < it->end_addr) {
+        if (it->refs == 0) {
+          evicted.push_back(it->buffer);
+          it = cache.entries.erase(it);
+          continue;
+        }
+        conflict = true;
+      }
+    }
+    ++it;
+  }
+  lock.unlock();
+  for (auto buffer : evicted) {
+    vx_mem_free(buffer);
+  }
+
+  if (conflict) {
+    if (!image.relocatable) {
+      printf("error: kernel address range [0x%lx-0x%lx] is in use by another kernel, link with --emit-relocs to enable relocation\n", base_addr, end_addr);
+      return -1;
+    }
+    auto align = std::max<uint64_t>(image.align, RAM_PAGE_SIZE);
+    base_addr = aligned_size(next_addr, align);
+    end_addr = base_addr + image.size();
+  }
+
+  vx_buffer_h _hbuffer;
+  CHECK_ERR(load_kernel_image(hdevice, bytes, image, base_addr, &_hbuffer), {
     return err;
   });
 
+  lock.lock();
+  cache.entries.push_back({hdevice, hash, size, base_addr, end_addr, _hbuffer, 1});
+
   *hbuffer = _hbuffer;
 
   return 0;
@@ -156,6 +598,85 @@ extern int vx_upload_file(vx_device_h hdevice, const char* filename, vx_buffer_h
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+// Per-device argument block reused by vx_launch().
+// Keeping it at a fixed address lets the backends skip the startup DCR writes
+// when the same kernel is launched again.
+class LaunchArgs {
+public:
+  struct entry_t {
+    vx_buffer_h buffer;
+    uint64_t    size;
+  };
+
+  std::mutex mutex;
+  std::unordered_map<vx_device_h, entry_t> entries;
+};
+
+LaunchArgs& launch_args() {
+  static LaunchArgs gLaunchArgs;
+  return gLaunchArgs;
+}
+
+}
+
+// called by vx_dev_close(), release the device argument block
+void launch_args_flush(vx_device_h hdevice) {
+  vx_buffer_h buffer = nullptr;
+  {
+    auto& args = launch_args();
+    std::lock_guard<std::mutex> lock(args.mutex);
+    auto it = args.entries.find(hdevice);
+    if (it == args.entries.end())
+      return;
+    buffer = it->second.buffer;
+    args.entries.erase(it);
+  }
+  vx_mem_free(buffer);
+}
+
+extern int vx_launch(vx_device_h hdevice, vx_buffer_h hkernel, const void* args, uint64_t size) {
+  if (nullptr == hdevice || nullptr == hkernel || (0 != size && nullptr == args))
+    return -1;
+
+  // the previous launch may still be reading the argument block
+  CHECK_ERR(vx_ready_wait(hdevice, VX_MAX_TIMEOUT), {
+    return err;
+  });
+
+  vx_buffer_h hargs;
+  {
+    auto& cache = launch_args();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto& entry = cache.entries[hdevice];
+    if (nullptr == entry.buffer || entry.size < size) {
+      // grow the argument block, its address only changes here
+      if (entry.buffer) {
+        vx_mem_free(entry.buffer);
+        entry.buffer = nullptr;
+      }
+      uint64_t asize = aligned_size(std::max<uint64_t>(size, 1), CACHE_BLOCK_SIZE);
+      CHECK_ERR(vx_mem_alloc(hdevice, asize, VX_MEM_READ, &entry.buffer), {
+        cache.entries.erase(hdevice);
+        return err;
+      });
+      entry.size = asize;
+    }
+    hargs = entry.buffer;
+  }
+
+  if (size != 0) {
+    CHECK_ERR(vx_copy_to_dev(hargs, args, 0, size), {
+      return err;
+    });
+  }
+
+  return vx_start(hdevice, hkernel, hargs);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
   uint64_t total_instrs = 0;
   uint64_t total_cycles = 0;
@@ -188,6 +709,9 @@ extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
   uint64_t scrb_lsu = 0;
   uint64_t scrb_csrs = 0;
   uint64_t scrb_wctl = 0;
+  uint64_t fu_alu_stalls = 0;
+  uint64_t fu_fpu_stalls = 0;
+  uint64_t fu_sfu_stalls = 0;
   uint64_t ifetches = 0;
   uint64_t loads = 0;
   uint64_t stores = 0;
@@ -200,6 +724,8 @@ extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
   uint64_t l2cache_write_misses = 0;
   uint64_t l2cache_bank_stalls = 0;
   uint64_t l2cache_mshr_stalls = 0;
+  uint64_t l2cache_amos = 0;
+  uint64_t l2cache_amo_stalls = 0;
   // PERF: l3cache
   uint64_t l3cache_reads = 0;
   uint64_t l3cache_writes = 0;
@@ -207,17 +733,30 @@ extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
   uint64_t l3cache_write_misses = 0;
   uint64_t l3cache_bank_stalls = 0;
   uint64_t l3cache_mshr_stalls = 0;
+  uint64_t l3cache_amos = 0;
+  uint64_t l3cache_amo_stalls = 0;
   // PERF: memory
   uint64_t mem_reads = 0;
   uint64_t mem_writes = 0;
   uint64_t mem_lat = 0;
   uint64_t mem_bank_stalls = 0;
+  // PERF: divergence
+  uint64_t splits = 0;
+  uint64_t splits_div = 0;
+  uint64_t split_lanes = 0;
+  uint64_t reconv_dist = 0;
+  uint64_t active_lanes = 0;
 
   uint64_t num_cores;
   CHECK_ERR(vx_dev_caps(hdevice, VX_CAPS_NUM_CORES, &num_cores), {
     return err;
   });
 
+  uint64_t num_threads;
+  CHECK_ERR(vx_dev_caps(hdevice, VX_CAPS_NUM_THREADS, &num_threads), {
+    return err;
+  });
+
   uint64_t isa_flags;
   CHECK_ERR(vx_dev_caps(hdevice, VX_CAPS_ISA_FLAGS, &isa_flags), {
     return err;
@@ -234,7 +773,18 @@ extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
   bool l3cache_enable = isa_flags & VX_ISA_EXT_L3CACHE;
   bool lmem_enable    = isa_flags & VX_ISA_EXT_LMEM;
 
+  // the functional unit stalls are only counted by simx
+  bool fu_stalls_enable = is_simx_driver();
+
   auto perf_class = get_profiling_mode();
+  if (perf_class == VX_DCR_MPM_CLASS_SIMT && !is_simx_driver()) {
+    fprintf(stream, "PERF: SIMT counters are not supported on this device\n");
+    perf_class = VX_DCR_MPM_CLASS_NONE;
+  }
+  if (perf_class == VX_DCR_MPM_CLASS_AMO && !is_simx_driver()) {
+    fprintf(stream, "PERF: atomics counters are not supported on this device\n");
+    perf_class = VX_DCR_MPM_CLASS_NONE;
+  }
 
   for (unsigned core_id = 0; core_id < num_cores; ++core_id) {
     uint64_t cycles_per_core;
@@ -345,6 +895,27 @@ extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
         }
         opds_stalls += opds_stalls_per_core;
       }
+      // functional unit structural stalls
+      if (fu_stalls_enable) {
+        uint64_t alu_stalls_per_core;
+        CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_ALU_ST, core_id, &alu_stalls_per_core), {
+          return err;
+        });
+        uint64_t fpu_stalls_per_core;
+        CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_FPU_ST, core_id, &fpu_stalls_per_core), {
+          return err;
+        });
+        uint64_t sfu_stalls_per_core;
+        CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_SFU_ST, core_id, &sfu_stalls_per_core), {
+          return err;
+        });
+        if (num_cores > 1) {
+          fprintf(stream, "PERF: core%d: functional unit stalls (alu=%ld, fpu=%ld, sfu=%ld)\n", core_id, alu_stalls_per_core, fpu_stalls_per_core, sfu_stalls_per_core);
+        }
+        fu_alu_stalls += alu_stalls_per_core;
+        fu_fpu_stalls += fpu_stalls_per_core;
+        fu_sfu_stalls += sfu_stalls_per_core;
+      }
       // PERF: memory
       // ifetches
       {
@@ -555,6 +1126,89 @@ extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
         });
       }
     } break;
+    case VX_DCR_MPM_CLASS_SIMT: {
+      // PERF: divergence
+      uint64_t splits_per_core;
+      CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_SPLITS, core_id, &splits_per_core), {
+        return err;
+      });
+      uint64_t splits_div_per_core;
+      CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_SPLITS_DIV, core_id, &splits_div_per_core), {
+        return err;
+      });
+      uint64_t split_lanes_per_core;
+      CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_SPLIT_LANES, core_id, &split_lanes_per_core), {
+        return err;
+      });
+      uint64_t reconv_dist_per_core;
+      CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_RECONV_DIST, core_id, &reconv_dist_per_core), {
+        return err;
+      });
+      uint64_t active_lanes_per_core;
+      CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_ACTIVE_LANES, core_id, &active_lanes_per_core), {
+        return err;
+      });
+      if (num_cores > 1) {
+        fprintf(stream, "PERF: core%d: splits=%ld (divergent=%d%%, active lanes=%d%%)\n", core_id, splits_per_core
+          , calcAvgPercent(splits_div_per_core, splits_per_core)
+          , calcAvgPercent(split_lanes_per_core, splits_per_core * num_threads));
+        fprintf(stream, "PERF: core%d: reconvergence distance=%d instrs\n", core_id, int(caclAverage(reconv_dist_per_core, splits_div_per_core)));
+        fprintf(stream, "PERF: core%d: SIMT efficiency=%d%%\n", core_id, calcAvgPercent(active_lanes_per_core, instrs_per_core * num_threads));
+      }
+      splits += splits_per_core;
+      splits_div += splits_div_per_core;
+      split_lanes += split_lanes_per_core;
+      reconv_dist += reconv_dist_per_core;
+      active_lanes += active_lanes_per_core;
+    } break;
+    case VX_DCR_MPM_CLASS_AMO: {
+      if (lmem_enable) {
+        // PERF: lmem
+        uint64_t lmem_amos;
+        CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_LMEM_AMOS, core_id, &lmem_amos), {
+          return err;
+        });
+        uint64_t lmem_amo_stalls;
+        CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_LMEM_AMO_ST, core_id, &lmem_amo_stalls), {
+          return err;
+        });
+        fprintf(stream, "PERF: core%d: lmem amos=%ld (stalls=%ld)\n", core_id, lmem_amos, lmem_amo_stalls);
+      }
+      if (dcache_enable) {
+        // PERF: Dcache
+        uint64_t dcache_amos;
+        CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_DCACHE_AMOS, core_id, &dcache_amos), {
+          return err;
+        });
+        uint64_t dcache_amo_stalls;
+        CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_DCACHE_AMO_ST, core_id, &dcache_amo_stalls), {
+          return err;
+        });
+        fprintf(stream, "PERF: core%d: dcache amos=%ld (stalls=%ld)\n", core_id, dcache_amos, dcache_amo_stalls);
+      }
+      if (l2cache_enable) {
+        // PERF: L2cache
+        uint64_t tmp;
+        CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_L2CACHE_AMOS, core_id, &tmp), {
+          return err;
+        });
+        l2cache_amos += tmp;
+
+        CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_L2CACHE_AMO_ST, core_id, &tmp), {
+          return err;
+        });
+        l2cache_amo_stalls += tmp;
+      }
+      if (0 == core_id && l3cache_enable) {
+        // PERF: L3cache
+        CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_L3CACHE_AMOS, core_id, &l3cache_amos), {
+          return err;
+        });
+        CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_L3CACHE_AMO_ST, core_id, &l3cache_amo_stalls), {
+          return err;
+        });
+      }
+    } break;
     default:
       break;
     }
@@ -589,6 +1243,9 @@ extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
       , calcAvgPercent(scrb_wctl, scrb_total)
     );
     fprintf(stream, "PERF: operands stalls=%ld (%d%%)\n", opds_stalls, opds_percent);
+    if (fu_stalls_enable) {
+      fprintf(stream, "PERF: functional unit stalls (alu=%ld, fpu=%ld, sfu=%ld)\n", fu_alu_stalls, fu_fpu_stalls, fu_sfu_stalls);
+    }
     fprintf(stream, "PERF: ifetches=%ld\n", ifetches);
     fprintf(stream, "PERF: loads=%ld\n", loads);
     fprintf(stream, "PERF: stores=%ld\n", stores);
@@ -637,6 +1294,23 @@ extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
       fprintf(stream, "PERF: memory bank stalls=%ld (utilization=%d%%)\n", mem_bank_stalls, mem_bank_utilization);
     }
   } break;
+  case VX_DCR_MPM_CLASS_SIMT: {
+    fprintf(stream, "PERF: splits=%ld (divergent=%d%%, active lanes=%d%%)\n", splits
+      , calcAvgPercent(splits_div, splits)
+      , calcAvgPercent(split_lanes, splits * num_threads));
+    fprintf(stream, "PERF: reconvergence distance=%d instrs\n", int(caclAverage(reconv_dist, splits_div)));
+    fprintf(stream, "PERF: SIMT efficiency=%d%%\n", calcAvgPercent(active_lanes, total_instrs * num_threads));
+  } break;
+  case VX_DCR_MPM_CLASS_AMO: {
+    if (l2cache_enable) {
+      l2cache_amos /= num_cores;
+      l2cache_amo_stalls /= num_cores;
+      fprintf(stream, "PERF: l2cache amos=%ld (stalls=%ld)\n", l2cache_amos, l2cache_amo_stalls);
+    }
+    if (l3cache_enable) {
+      fprintf(stream, "PERF: l3cache amos=%ld (stalls=%ld)\n", l3cache_amos, l3cache_amo_stalls);
+    }
+  } break;
   default:
     break;
   }
@@ -649,6 +1323,153 @@ extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
   return 0;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Per-device performance stream selection and CSV writer state.
+class PerfStreams {
+public:
+  struct entry_t {
+    uint32_t counters;
+    bool     header;
+    uint64_t last[VX_PERF_STREAM_NUM_COUNTERS];
+  };
+
+  std::mutex mutex;
+  std::unordered_map<vx_device_h, entry_t> entries;
+};
+
+PerfStreams& perf_streams() {
+  static PerfStreams gPerfStreams;
+  return gPerfStreams;
+}
+
+const char* perf_stream_names[VX_PERF_STREAM_NUM_COUNTERS] = {
+  "cycles",
+  "instrs",
+  "sched_stalls",
+  "ibuf_stalls",
+  "scrb_stalls",
+  "icache_misses",
+  "dcache_misses",
+  "l2cache_misses",
+  "l3cache_misses",
+  "mem_reads",
+  "mem_writes",
+  "mem_latency"
+};
+
+}
+
+// called by vx_perf_stream_open() and vx_perf_stream_close()
+void perf_stream_reset(vx_device_h hdevice, uint32_t counters) {
+  auto& streams = perf_streams();
+  std::lock_guard<std::mutex> lock(streams.mutex);
+  if (0 == counters) {
+    streams.entries.erase(hdevice);
+    return;
+  }
+  auto& entry = streams.entries[hdevice];
+  entry.counters = counters;
+  entry.header = false;
+  memset(entry.last, 0, sizeof(entry.last));
+}
+
+uint32_t perf_stream_counters(vx_device_h hdevice) {
+  auto& streams = perf_streams();
+  std::lock_guard<std::mutex> lock(streams.mutex);
+  auto it = streams.entries.find(hdevice);
+  if (it == streams.entries.end())
+    return 0;
+  return it->second.counters;
+}
+
+extern int vx_perf_stream_dump(vx_device_h hdevice, FILE* stream) {
+  if (nullptr == hdevice || nullptr == stream)
+    return -1;
+
+  uint32_t counters = perf_stream_counters(hdevice);
+  if (0 == counters)
+    return -1;
+
+  uint32_t num_columns = 0;
+  uint32_t columns[VX_PERF_STREAM_NUM_COUNTERS];
+  for (uint32_t i = 0; i < VX_PERF_STREAM_NUM_COUNTERS; ++i) {
+    if ((counters >> i) & 0x1) {
+      columns[num_columns++] = i;
+    }
+  }
+
+  bool has_ipc = ((counters >> VX_PERF_STREAM_CYCLES) & 0x1)
+              && ((counters >> VX_PERF_STREAM_INSTRS) & 0x1);
+
+  // snapshot the writer state, samples are read without holding the lock
+  PerfStreams::entry_t entry;
+  {
+    auto& streams = perf_streams();
+    std::lock_guard<std::mutex> lock(streams.mutex);
+    entry = streams.entries.at(hdevice);
+  }
+
+  if (!entry.header) {
+    for (uint32_t c = 0; c < num_columns; ++c) {
+      fprintf(stream, "%s%s", (c ? "," : ""), perf_stream_names[columns[c]]);
+    }
+    if (has_ipc) {
+      fprintf(stream, ",ipc");
+    }
+    fprintf(stream, "\n");
+    entry.header = true;
+  }
+
+  // the cycle count is printed as a timestamp, other counters as deltas
+  // from the previous sample, counters restart from zero on each run
+  std::vector<uint64_t> values(64 * num_columns);
+  for (;;) {
+    uint32_t num_samples;
+    CHECK_ERR(vx_perf_stream_read(hdevice, values.data(), 64, &num_samples), {
+      return err;
+    });
+    for (uint32_t s = 0; s < num_samples; ++s) {
+      uint64_t sample[VX_PERF_STREAM_NUM_COUNTERS] = {};
+      for (uint32_t c = 0; c < num_columns; ++c) {
+        sample[columns[c]] = values[s * num_columns + c];
+      }
+      uint64_t delta[VX_PERF_STREAM_NUM_COUNTERS];
+      for (uint32_t i = 0; i < VX_PERF_STREAM_NUM_COUNTERS; ++i) {
+        delta[i] = (sample[i] >= entry.last[i]) ? (sample[i] - entry.last[i]) : sample[i];
+      }
+      for (uint32_t c = 0; c < num_columns; ++c) {
+        uint32_t i = columns[c];
+        fprintf(stream, "%s%ld", (c ? "," : ""), (i == VX_PERF_STREAM_CYCLES) ? sample[i] : delta[i]);
+      }
+      if (has_ipc) {
+        uint64_t cycles = delta[VX_PERF_STREAM_CYCLES];
+        uint64_t instrs = delta[VX_PERF_STREAM_INSTRS];
+        fprintf(stream, ",%f", cycles ? (double(instrs) / cycles) : 0.0);
+      }
+      fprintf(stream, "\n");
+      memcpy(entry.last, sample, sizeof(sample));
+    }
+    if (num_samples < 64)
+      break;
+  }
+
+  fflush(stream);
+
+  {
+    auto& streams = perf_streams();
+    std::lock_guard<std::mutex> lock(streams.mutex);
+    auto it = streams.entries.find(hdevice);
+    if (it != streams.entries.end() && it->second.counters == counters) {
+      it->second = entry;
+    }
+  }
+
+  return 0;
+}
+
 int vx_check_occupancy(vx_device_h hdevice, uint32_t group_size, uint32_t* max_localmem) {
    // check group size
   uint64_t warps_per_core, threads_per_warp;
@@ -21,6 +21,11 @@
 #include <iostream>
 
 int get_profiling_mode();
+bool kernel_cache_release(vx_buffer_h hbuffer);
+void kernel_cache_flush(vx_device_h hdevice);
+void launch_args_flush(vx_device_h hdevice);
+void perf_stream_reset(vx_device_h hdevice, uint32_t counters);
+uint32_t perf_stream_counters(vx_device_h hdevice);
 
 static int dcr_initialize(vx_device_h hdevice) {
   const uint64_t startup_addr(STARTUP_ADDR);
@@ -98,6 +103,9 @@ extern int vx_dev_open(vx_device_h* hdevice) {
 
 extern int vx_dev_close(vx_device_h hdevice) {
   vx_dump_perf(hdevice, stdout);
+  perf_stream_reset(hdevice, 0);
+  launch_args_flush(hdevice);
+  kernel_cache_flush(hdevice);
   int ret = (g_callbacks.dev_close)(hdevice);
   dlclose(g_drv_handle);
   return ret;
@@ -116,6 +124,9 @@ extern int vx_mem_reserve(vx_device_h hdevice, uint64_t address, uint64_t size,
 }
 
 extern int vx_mem_free(vx_buffer_h hbuffer) {
+  // cached kernels stay resident until the device is closed
+  if (kernel_cache_release(hbuffer))
+    return 0;
   return (g_callbacks.mem_free)(hbuffer);
 }
 
@@ -131,6 +142,10 @@ extern int vx_mem_info(vx_device_h hdevice, uint64_t* mem_free, uint64_t* mem_us
   return (g_callbacks.mem_info)(hdevice, mem_free, mem_used);
 }
 
+extern int vx_mem_stats(vx_device_h hdevice, uint32_t stats_id, uint64_t* value) {
+  return (g_callbacks.mem_stats)(hdevice, stats_id, value);
+}
+
 extern int vx_copy_to_dev(vx_buffer_h hbuffer, const void* host_ptr, uint64_t dst_offset, uint64_t size) {
   return (g_callbacks.copy_to_dev)(hbuffer, host_ptr, dst_offset, size);
 }
@@ -142,9 +157,13 @@ extern int vx_copy_from_dev(void* host_ptr, vx_buffer_h hbuffer, uint64_t src_of
 extern int vx_start(vx_device_h hdevice, vx_buffer_h hkernel, vx_buffer_h harguments) {
   int profiling_mode = get_profiling_mode();
   if (profiling_mode != 0) {
-    CHECK_ERR(vx_dcr_write(hdevice, VX_DCR_BASE_MPM_CLASS, profiling_mode), {
-      return err;
-    });
+    uint32_t mpm_class;
+    if (0 != vx_dcr_read(hdevice, VX_DCR_BASE_MPM_CLASS, &mpm_class)
+     || mpm_class != uint32_t(profiling_mode)) {
+      CHECK_ERR(vx_dcr_write(hdevice, VX_DCR_BASE_MPM_CLASS, profiling_mode), {
+        return err;
+      });
+    }
   }
   return (g_callbacks.start)(hdevice, hkernel, harguments);
 }
@@ -180,4 +199,48 @@ extern int vx_mpm_query(vx_device_h hdevice, uint32_t addr, uint32_t core_id, ui
   } else {
     return (g_callbacks.mpm_query)(hdevice, addr, core_id, value);
   }
-}
\ No newline at end of file
+}
+
+extern int vx_perf_stream_open(vx_device_h hdevice, uint64_t interval, uint32_t counters) {
+  if (0 == counters || 0 != (counters >> VX_PERF_STREAM_NUM_COUNTERS))
+    return -1;
+  CHECK_ERR((g_callbacks.perf_stream_open)(hdevice, interval), {
+    return err;
+  });
+  perf_stream_reset(hdevice, counters);
+  return 0;
+}
+
+extern int vx_perf_stream_read(vx_device_h hdevice, uint64_t* values, uint32_t max_samples, uint32_t* num_samples) {
+  uint32_t counters = perf_stream_counters(hdevice);
+  if (0 == counters || nullptr == values || nullptr == num_samples)
+    return -1;
+  // keep only the selected counters of each sample
+  uint64_t sample[VX_PERF_STREAM_NUM_COUNTERS];
+  uint32_t count = 0;
+  while (count < max_samples) {
+    uint32_t n;
+    CHECK_ERR((g_callbacks.perf_stream_read)(hdevice, sample, 1, &n), {
+      return err;
+    });
+    if (0 == n)
+      break;
+    for (uint32_t i = 0; i < VX_PERF_STREAM_NUM_COUNTERS; ++i) {
+      if ((counters >> i) & 0x1) {
+        *values++ = sample[i];
+      }
+    }
+    ++count;
+  }
+  *num_samples = count;
+  return 0;
+}
+
+extern int vx_perf_stream_close(vx_device_h hdevice) {
+  perf_stream_reset(hdevice, 0);
+  return (g_callbacks.perf_stream_close)(hdevice);
+}
+
+extern int vx_cache_warm(vx_device_h hdevice, uint64_t addr, uint64_t size, uint32_t level) {
+  return (g_callbacks.cache_warm)(hdevice, addr, size, level);
+}
@@ -420,6 +420,10 @@ public:
     return 0;
   }
 
+  int mem_stats(uint32_t stats_id, uint64_t* value) const {
+    return get_mem_stats(global_mem_, stats_id, value);
+  }
+
   int write_register(uint32_t addr, uint32_t value) {
   #ifdef CPP_API
     xrtKernel_.write_register(addr, value);
@@ -537,17 +541,17 @@ public:
   }
 
   int start(uint64_t krnl_addr, uint64_t args_addr) {
-    // set kernel info
-    CHECK_ERR(this->dcr_write(VX_DCR_BASE_STARTUP_ADDR0, krnl_addr & 0xffffffff), {
+    // set kernel info, skipping registers that already hold the value
+    CHECK_ERR(this->dcr_update(VX_DCR_BASE_STARTUP_ADDR0, krnl_addr & 0xffffffff), {
       return err;
     });
-    CHECK_ERR(this->dcr_write(VX_DCR_BASE_STARTUP_ADDR1, krnl_addr >> 32), {
+    CHECK_ERR(this->dcr_update(VX_DCR_BASE_STARTUP_ADDR1, krnl_addr >> 32), {
       return err;
     });
-    CHECK_ERR(this->dcr_write(VX_DCR_BASE_STARTUP_ARG0, args_addr & 0xffffffff), {
+    CHECK_ERR(this->dcr_update(VX_DCR_BASE_STARTUP_ARG0, args_addr & 0xffffffff), {
       return err;
     });
-    CHECK_ERR(this->dcr_write(VX_DCR_BASE_STARTUP_ARG1, args_addr >> 32), {
+    CHECK_ERR(this->dcr_update(VX_DCR_BASE_STARTUP_ARG1, args_addr >> 32), {
       return err;
     });
 
@@ -608,6 +612,13 @@ public:
     return dcrs_.read(addr, value);
   }
 
+  int dcr_update(uint32_t addr, uint32_t value) {
+    uint32_t cached;
+    if (0 == dcrs_.read(addr, &cached) && cached == value)
+      return 0;
+    return this->dcr_write(addr, value);
+  }
+
   int mpm_query(uint32_t addr, uint32_t core_id, uint64_t *value) {
     uint32_t offset = addr - VX_CSR_MPM_BASE;
     if (offset > 31)
@@ -622,6 +633,24 @@ public:
     return 0;
   }
 
+  int perf_stream_open(uint64_t /*interval*/) {
+    printf("[VXDRV] Error: performance streaming is not supported on this device\n");
+    return -1;
+  }
+
+  int perf_stream_read(uint64_t* /*values*/, uint32_t /*max_samples*/, uint32_t* /*num_samples*/) {
+    return -1;
+  }
+
+  int perf_stream_close() {
+    return -1;
+  }
+
+  int cache_warm(uint64_t /*addr*/, uint64_t /*size*/, uint32_t /*level*/) {
+    printf("[VXDRV] Error: cache warming is not supported on this device\n");
+    return -1;
+  }
+
 private:
 
   MemoryAllocator global_mem_;
@@ -0,0 +1,206 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace vortex {
+
+// Instruction commit stream used for co-simulation.
+// The RTL simulator writes one record per committed instruction and SimX
+// replays the same program against it (see sim/simx/cosim.h).
+// Instructions are identified by their uuid, (global warp id << 32) | count
+// of instructions the warp issued since reset, so records can be matched
+// regardless of the order in which the two models complete them.
+// Records are in host byte order; register writes carry one 64-bit value per
+// thread of the warp after the record.
+class CommitLog {
+public:
+  enum Type : uint8_t {
+    COMMIT  = 0,
+    RUN_END = 1,
+  };
+
+  struct header_t {
+    char     magic[4];
+    uint32_t version;
+    uint32_t num_threads;
+    uint32_t xlen;
+  };
+
+  struct record_t {
+    uint64_t uuid;
+    uint64_t PC;
+    uint64_t tmask;
+    uint32_t rd;    // register index, floating-point registers start at 32
+    uint8_t  type;
+    uint8_t  wb;
+    uint16_t reserved;
+  };
+
+  static constexpr uint32_t VERSION = 1;
+
+  // the writer is enabled from the environment:
+  //   VORTEX_COMMIT_LOG=<path>   write the commit stream to <path> (a file or a fifo)
+  static CommitLog& instance() {
+    static CommitLog log;
+    return log;
+  }
+
+  bool enabled() const {
+    return file_ != nullptr;
+  }
+
+  void open(uint32_t num_threads, uint32_t xlen) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_ || path_ == nullptr)
+      return;
+    file_ = fopen(path_, "wb");
+    if (file_ == nullptr) {
+      printf("error: cannot open commit log: %s\n", path_);
+      path_ = nullptr;
+      return;
+    }
+    num_threads_ = num_threads;
+    header_t header = {{'V', 'X', 'C', 'L'}, VERSION, num_threads, xlen};
+    fwrite(&header, sizeof(header), 1, file_);
+  }
+
+  // add a commit packet, packets of an instruction are merged until its last one
+  void commit(const record_t& record, const uint64_t* data, bool eop) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_ == nullptr)
+      return;
+    auto it = partial_.find(record.uuid);
+    if (it == partial_.end()) {
+      if (eop) {
+        this->write(record, data);
+        return;
+      }
+      auto& entry = partial_[record.uuid];
+      entry.record = record;
+      entry.data.assign(data, data + num_threads_);
+      return;
+    }
+    auto& entry = it->second;
+    for (uint32_t i = 0; i < num_threads_; ++i) {
+      if ((record.tmask >> i) & 0x1) {
+        entry.data[i] = data[i];
+      }
+    }
+    entry.record.tmask |= record.tmask;
+    if (eop) {
+      this->write(entry.record, entry.data.data());
+      partial_.erase(it);
+    }
+  }
+
+  // mark the end of a kernel run, uuids restart from zero on the next one
+  void end_run() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_ == nullptr)
+      return;
+    record_t record = {};
+    record.type = RUN_END;
+    fwrite(&record, sizeof(record), 1, file_);
+    fflush(file_);
+  }
+
+private:
+
+  struct partial_t {
+    record_t record;
+    std::vector<uint64_t> data;
+  };
+
+  CommitLog() : path_(getenv("VORTEX_COMMIT_LOG")), file_(nullptr), num_threads_(0) {}
+
+  ~CommitLog() {
+    if (file_) {
+      fclose(file_);
+    }
+  }
+
+  void write(const record_t& record, const uint64_t* data) {
+    fwrite(&record, sizeof(record), 1, file_);
+    if (record.wb) {
+      fwrite(data, sizeof(uint64_t), num_threads_, file_);
+    }
+  }
+
+  const char* path_;
+  FILE* file_;
+  uint32_t num_threads_;
+  std::unordered_map<uint64_t, partial_t> partial_;
+  std::mutex mutex_;
+};
+
+// Sequential reader of a commit stream
+class CommitLogReader {
+public:
+  CommitLogReader() : file_(nullptr), num_threads_(0) {}
+
+  ~CommitLogReader() {
+    if (file_) {
+      fclose(file_);
+    }
+  }
+
+  // blocks until the writer opens the stream when <path> is a fifo
+  int open(const char* path, uint32_t num_threads, uint32_t xlen) {
+    file_ = fopen(path, "rb");
+    if (file_ == nullptr) {
+      printf("error: cannot open commit log: %s\n", path);
+      return -1;
+    }
+    CommitLog::header_t header;
+    if (1 != fread(&header, sizeof(header), 1, file_)
+     || memcmp(header.magic, "VXCL", 4) != 0
+     || header.version != CommitLog::VERSION) {
+      printf("error: invalid commit log: %s\n", path);
+      return -1;
+    }
+    if (header.num_threads != num_threads || header.xlen != xlen) {
+      printf("error: commit log configuration mismatch: num_threads=%d, xlen=%d, expected num_threads=%d, xlen=%d\n",
+        header.num_threads, header.xlen, num_threads, xlen);
+      return -1;
+    }
+    num_threads_ = num_threads;
+    return 0;
+  }
+
+  // next record, false at the end of the stream
+  bool read(CommitLog::record_t* record, std::vector<uint64_t>* data) {
+    if (1 != fread(record, sizeof(CommitLog::record_t), 1, file_))
+      return false;
+    data->resize(num_threads_);
+    if (record->wb) {
+      if (num_threads_ != fread(data->data(), sizeof(uint64_t), num_threads_, file_))
+        return false;
+    }
+    return true;
+  }
+
+private:
+  FILE* file_;
+  uint32_t num_threads_;
+};
+
+}
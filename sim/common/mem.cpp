@@ -19,6 +19,12 @@
 #include "util.h"
 #include <VX_config.h>
 #include <bitset>
+#include <algorithm>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace vortex;
 
@@ -441,13 +447,15 @@ void RAM::clear() {
   for (auto& page : pages_) {
     delete[] page.second;
   }
+  pages_.clear();
+  last_page_ = nullptr;
 }
 
 uint64_t RAM::size() const {
   return uint64_t(pages_.size()) << page_bits_;
 }
 
-uint8_t *RAM::get(uint64_t address) const {
+uint8_t *RAM::get(uint64_t address, bool init) const {
   if (capacity_ != 0 && address >= capacity_) {
     throw OutOfRange();
   }
@@ -464,9 +472,11 @@ uint8_t *RAM::get(uint64_t address) const {
       page = it->second;
     } else {
       uint8_t *ptr = new uint8_t[page_size];
-      // set uninitialized data to "baadf00d"
-      for (uint32_t i = 0; i < page_size; ++i) {
-        ptr[i] = (0xbaadf00d >> ((i & 0x3) * 8)) & 0xff;
+      if (init) {
+        // set uninitialized data to "baadf00d"
+        for (uint32_t i = 0; i < page_size; ++i) {
+          ptr[i] = (0xbaadf00d >> ((i & 0x3) * 8)) & 0xff;
+        }
       }
       pages_.emplace(page_index, ptr);
       page = ptr;
@@ -483,9 +493,15 @@ void RAM::read(void* data, uint64_t addr, uint64_t size) {
   if (check_acl_ && acl_mngr_.check(addr, size, 0x1) == false) {
     throw BadAddress();
   }
+  // copy one page span at a time
   uint8_t* d = (uint8_t*)data;
-  for (uint64_t i = 0; i < size; i++) {
-    d[i] = *this->get(addr + i);
+  uint64_t page_size = uint64_t(1) << page_bits_;
+  while (size != 0) {
+    uint64_t span = std::min<uint64_t>(size, page_size - (addr & (page_size - 1)));
+    memcpy(d, this->get(addr), span);
+    d += span;
+    addr += span;
+    size -= span;
   }
 }
 
@@ -493,9 +509,16 @@ void RAM::write(const void* data, uint64_t addr, uint64_t size) {
   if (check_acl_ && acl_mngr_.check(addr, size, 0x2) == false) {
     throw BadAddress();
   }
+  // copy one page span at a time
   const uint8_t* d = (const uint8_t*)data;
-  for (uint64_t i = 0; i < size; i++) {
-    *this->get(addr + i) = d[i];
+  uint64_t page_size = uint64_t(1) << page_bits_;
+  while (size != 0) {
+    uint64_t span = std::min<uint64_t>(size, page_size - (addr & (page_size - 1)));
+    // whole pages need no initialization
+    memcpy(this->get(addr, span != page_size), d, span);
+    d += span;
+    addr += span;
+    size -= span;
   }
 }
 
@@ -506,88 +529,152 @@ void RAM::set_acl(uint64_t addr, uint64_t size, int flags) {
   acl_mngr_.set(addr, size, flags);
 }
 
-void RAM::loadBinImage(const char* filename, uint64_t destination) {
-  std::ifstream ifs(filename);
-  if (!ifs) {
-    std::cout << "error: " << filename << " not found" << std::endl;
-    std::abort();
+void RAM::for_each_page(const std::function<void(uint64_t addr, const uint8_t* data, uint32_t size)>& callback) const {
+  std::vector<uint64_t> indices;
+  indices.reserve(pages_.size());
+  for (auto& page : pages_) {
+    indices.push_back(page.first);
+  }
+  std::sort(indices.begin(), indices.end());
+  for (auto index : indices) {
+    callback(index << page_bits_, pages_.at(index), 1 << page_bits_);
   }
+}
 
-  ifs.seekg(0, ifs.end);
-  size_t size = ifs.tellg();
-  std::vector<uint8_t> content(size);
-  ifs.seekg(0, ifs.beg);
-  ifs.read((char*)content.data(), size);
+namespace {
 
-  this->clear();
-  this->write(content.data(), destination, size);
-}
+// read-only mapping of a whole file
+class MappedFile {
+public:
+  MappedFile(const char* filename) : data_(nullptr), size_(0) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+      std::cout << "error: " << filename << " not found" << std::endl;
+      std::abort();
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      std::cout << "error: cannot read " << filename << std::endl;
+      std::abort();
+    }
+    size_ = st.st_size;
+    if (size_ != 0) {
+      void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        std::cout << "error: cannot map " << filename << std::endl;
+        std::abort();
+      }
+      madvise(data, size_, MADV_SEQUENTIAL);
+      data_ = (const uint8_t*)data;
+    }
+    close(fd);
+  }
 
-void RAM::loadHexImage(const char* filename) {
-  auto hti = [&](char c)->uint32_t {
-    if (c >= 'A' && c <= 'F')
-      return c - 'A' + 10;
-    if (c >= 'a' && c <= 'f')
-      return c - 'a' + 10;
-    return c - '0';
-  };
-
-  auto hToI = [&](const char *c, uint32_t size)->uint32_t {
-    uint32_t value = 0;
-    for (uint32_t i = 0; i < size; i++) {
-      value += hti(c[i]) << ((size - i - 1) * 4);
+  ~MappedFile() {
+    if (data_) {
+      munmap((void*)data_, size_);
     }
-    return value;
-  };
+  }
 
-  std::ifstream ifs(filename);
-  if (!ifs) {
-    std::cout << "error: " << filename << " not found" << std::endl;
-    std::abort();
+  const uint8_t* data() const {
+    return data_;
   }
 
-  ifs.seekg(0, ifs.end);
-  size_t size = ifs.tellg();
-  std::vector<char> content(size);
-  ifs.seekg(0, ifs.beg);
-  ifs.read(content.data(), size);
+  size_t size() const {
+    return size_;
+  }
 
-  uint32_t offset = 0;
-  char *line = content.data();
+private:
+  const uint8_t* data_;
+  size_t size_;
+};
 
+// hexadecimal digit values, 0xff for other characters
+struct HexTable {
+  uint8_t values[256];
+  HexTable() {
+    memset(values, 0xff, sizeof(values));
+    for (int i = 0; i < 10; ++i) {
+      values['0' + i] = i;
+    }
+    for (int i = 0; i < 6; ++i) {
+      values['a' + i] = 10 + i;
+      values['A' + i] = 10 + i;
+    }
+  }
+};
+
+const HexTable hex_table;
+
+// parse <digits> hex characters, false on a malformed or truncated field
+inline bool parse_hex(const uint8_t* p, const uint8_t* end, uint32_t digits, uint32_t* value) {
+  if (end - p < (ptrdiff_t)digits)
+    return false;
+  uint32_t result = 0;
+  for (uint32_t i = 0; i < digits; ++i) {
+    uint32_t digit = hex_table.values[p[i]];
+    if (digit > 0xf)
+      return false;
+    result = (result << 4) | digit;
+  }
+  *value = result;
+  return true;
+}
+
+}
+
+void RAM::loadBinImage(const char* filename, uint64_t destination) {
+  MappedFile file(filename);
+  this->clear();
+  this->write(file.data(), destination, file.size());
+}
+
+void RAM::loadHexImage(const char* filename) {
+  MappedFile file(filename);
   this->clear();
 
-  while (true) {
-    if (line[0] == ':') {
-      uint32_t byteCount = hToI(line + 1, 2);
-      uint32_t nextAddr = hToI(line + 3, 4) + offset;
-      uint32_t key = hToI(line + 7, 2);
+  // Intel HEX records
+  const uint8_t* p = file.data();
+  const uint8_t* end = p + file.size();
+  uint32_t offset = 0;
+  uint8_t buffer[256];
+  while (p < end) {
+    auto eol = (const uint8_t*)memchr(p, '\n', end - p);
+    if (eol == nullptr) {
+      eol = end;
+    }
+    uint32_t byteCount, addr, key;
+    if (*p == ':'
+     && parse_hex(p + 1, eol, 2, &byteCount)
+     && parse_hex(p + 3, eol, 4, &addr)
+     && parse_hex(p + 7, eol, 2, &key)) {
+      const uint8_t* data = p + 9;
       switch (key) {
-      case 0:
-        for (uint32_t i = 0; i < byteCount; i++) {
-          uint32_t addr  = nextAddr + i;
-          uint32_t value = hToI(line + 9 + i * 2, 2);
-          *this->get(addr) = value;
+      case 0: {
+        uint32_t i = 0;
+        for (; i < byteCount; ++i) {
+          uint32_t value;
+          if (!parse_hex(data + i * 2, eol, 2, &value))
+            break;
+          buffer[i] = value;
         }
-        break;
+        this->write(buffer, uint64_t(addr) + offset, i);
+      } break;
       case 2:
-        offset = hToI(line + 9, 4) << 4;
+        if (parse_hex(data, eol, 4, &offset)) {
+          offset <<= 4;
+        }
         break;
       case 4:
-        offset = hToI(line + 9, 4) << 16;
+        if (parse_hex(data, eol, 4, &offset)) {
+          offset <<= 16;
+        }
         break;
       default:
         break;
       }
     }
-    while (*line != '\n' && size != 0) {
-      ++line;
-      --size;
-    }
-    if (size <= 1)
-      break;
-    ++line;
-    --size;
+    p = eol + 1;
   }
 }
 
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -376,13 +377,17 @@ public:
 
   void set_acl(uint64_t addr, uint64_t size, int flags);
 
+  // visit the allocated pages in address order
+  void for_each_page(const std::function<void(uint64_t addr, const uint8_t* data, uint32_t size)>& callback) const;
+
   void enable_acl(bool enable) {
     check_acl_ = enable;
   }
 
 private:
 
-  uint8_t *get(uint64_t address) const;
+  // <init> fills new pages with the uninitialized data pattern
+  uint8_t *get(uint64_t address, bool init = true) const;
 
   uint64_t capacity_;
   uint32_t page_bits_;
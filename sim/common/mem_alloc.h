@@ -16,9 +16,17 @@
 #include <cstdint>
 #include <assert.h>
 #include <stdio.h>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
 
 namespace vortex {
 
+// Segregated-fit device memory allocator.
+// Free blocks smaller than a page are binned into power-of-two size classes,
+// larger free blocks are kept in a size-ordered tree for best-fit lookup.
+// An address-ordered index of free blocks is used for coalescing on release.
 class MemoryAllocator {
 public:
   MemoryAllocator(
@@ -30,34 +38,27 @@ public:
     , capacity_(capacity)
     , pageAlign_(pageAlign)
     , blockAlign_(blockAlign)
-    , pages_(nullptr)
+    , numClasses_(log2floor(pageAlign))
+    , classMask_(0)
     , allocated_(0)
-  {}
-
-  ~MemoryAllocator() {
-    // Free allocated pages
-    page_t* currPage = pages_;
-    while (currPage) {
-      auto nextPage = currPage->next;
-      #ifdef VM_ENABLE
-      block_t* currblock = currPage->findfirstUsedBlock();
-      block_t* nextblock;
-      while (currblock) {
-        nextblock= currblock->nextUsed;
-        currPage->release(currblock);
-        currblock = nextblock;
-      }
-      #endif
-      delete currPage;
-      currPage = nextPage;
+    , peak_(0)
+  {
+    assert(0 == (pageAlign & (pageAlign - 1)));
+    assert(0 == (blockAlign & (blockAlign - 1)));
+    assert(blockAlign <= pageAlign);
+    assert(numClasses_ <= 64);
+    if (capacity != 0) {
+      this->insertFreeBlock(baseAddress, capacity);
     }
   }
 
-  uint32_t baseAddress() const {
+  ~MemoryAllocator() {}
+
+  uint64_t baseAddress() const {
     return baseAddress_;
   }
 
-  uint32_t capacity() const {
+  uint64_t capacity() const {
     return capacity_;
   }
 
@@ -69,6 +70,41 @@ public:
     return allocated_;
   }
 
+  // highest allocated size since creation
+  uint64_t peak() const {
+    return peak_;
+  }
+
+  // number of live allocations
+  uint64_t allocations() const {
+    return usedBlocks_.size();
+  }
+
+  // size of the largest contiguous free block
+  uint64_t largestFree() const {
+    if (!largeBlocks_.empty())
+      return largeBlocks_.rbegin()->first;
+    if (classMask_ == 0)
+      return 0;
+    // the highest non-empty class holds the largest small blocks
+    uint64_t largest = 0;
+    auto& bin = sizeClasses_[63 - __builtin_clzll(classMask_)];
+    for (auto addr : bin) {
+      auto size = freeBlocks_.at(addr);
+      if (size > largest)
+        largest = size;
+    }
+    return largest;
+  }
+
+  // external fragmentation as a ratio of free space not in the largest free block
+  double fragmentation() const {
+    uint64_t total = this->free();
+    if (total == 0)
+      return 0.0;
+    return 1.0 - double(this->largestFree()) / double(total);
+  }
+
   int reserve(uint64_t addr, uint64_t size) {
     if (size == 0) {
       printf("error: invalid arguments\n");
@@ -79,27 +115,36 @@ public:
     size = alignSize(size, pageAlign_);
 
     // Check if the reservation is within memory capacity bounds
-    if (addr + size > baseAddress_ + capacity_) {
-      printf("error: address range out of bounds - requested=0x%lx, base+capacity=0x%lx\n", (addr + size), (baseAddress_ +capacity_));
+    if (addr < baseAddress_ || addr + size > baseAddress_ + capacity_) {
+      printf("error: address range out of bounds - requested=[0x%lx-0x%lx], range=[0x%lx-0x%lx]\n", addr, (addr + size), baseAddress_, (baseAddress_ + capacity_));
       return -1;
     }
 
-    // Ensure the reservation does not overlap with existing pages
-    uint64_t overlapStart, overlapEnd;
-    if (hasPageOverlap(addr, size, &overlapStart, &overlapEnd)) {
-      printf("error: address range overlaps with existing allocation - requested=[0x%lx-0x%lx], existing=[0x%lx, 0x%lx]\n", addr, addr+size, overlapStart, overlapEnd);
+    // The reservation must lie within a single free block
+    auto it = freeBlocks_.upper_bound(addr);
+    if (it == freeBlocks_.begin()) {
+      printf("error: address range overlaps with existing allocation - requested=[0x%lx-0x%lx]\n", addr, addr+size);
+      return -1;
+    }
+    --it;
+    uint64_t blockAddr = it->first;
+    uint64_t blockSize = it->second;
+    if (addr + size > blockAddr + blockSize) {
+      printf("error: address range overlaps with existing allocation - requested=[0x%lx-0x%lx]\n", addr, addr+size);
       return -1;
     }
 
-    // allocate a new page for segment
-    auto newPage = this->createPage(addr, size);
-
-    // allocate space on free block
-    auto freeBlock = newPage->findFreeBlock(size);
-    newPage->allocate(size, freeBlock);
+    // Split the free block around the reserved range
+    this->removeFreeBlock(blockAddr, blockSize);
+    if (addr > blockAddr) {
+      this->insertFreeBlock(blockAddr, addr - blockAddr);
+    }
+    uint64_t blockEnd = blockAddr + blockSize;
+    if (blockEnd > addr + size) {
+      this->insertFreeBlock(addr + size, blockEnd - (addr + size));
+    }
 
-    // Update allocated size
-    allocated_ += size;
+    this->insertUsedBlock(addr, size);
 
     return 0;
   }
@@ -110,434 +155,161 @@ public:
       return -1;
     }
 
-    // Align allocation size
-    size = alignSize(size, blockAlign_);
-
-    // Walk thru all pages to find a free block
-    block_t* freeBlock = nullptr;
-    auto currPage = pages_;
-    while (currPage) {
-      freeBlock = currPage->findFreeBlock(size);
-      if (freeBlock != nullptr)
-        break;
-      currPage = currPage->next;
+    // Align allocation size, page-sized allocations are page-aligned
+    uint64_t alignment = (size >= pageAlign_) ? pageAlign_ : blockAlign_;
+    size = alignSize(size, alignment);
+
+    // Find a free block
+    uint64_t blockAddr, blockSize;
+    bool found = (alignment == pageAlign_)
+      ? this->findPageBlock(size, &blockAddr, &blockSize)
+      : this->findFreeBlock(size, &blockAddr, &blockSize);
+    if (!found) {
+      printf("error: out of memory (requested=0x%lx, free=0x%lx, largest=0x%lx)\n", size, this->free(), this->largestFree());
+      return -1;
     }
 
-    // Allocate a new page if no free block is found
-    if (freeBlock == nullptr) {
-      auto pageSize = alignSize(size, pageAlign_);
-      uint64_t pageAddr;
-      if (!this->findNextAddress(pageSize, &pageAddr)) {
-        printf("error: out of memory (Can't find next address)\n");
-        return -1;
-      }
-      currPage = this->createPage(pageAddr, pageSize);
-      if (nullptr == currPage) {
-        printf("error: out of memory (Can't create a page)\n");
-        return -1;
-      }
-      freeBlock = currPage->findFreeBlock(size);
+    // Split off the unaligned head of the free block
+    this->removeFreeBlock(blockAddr, blockSize);
+    uint64_t allocAddr = alignSize(blockAddr, alignment);
+    if (allocAddr > blockAddr) {
+      this->insertFreeBlock(blockAddr, allocAddr - blockAddr);
     }
 
-    // allocate space on free block
-    currPage->allocate(size, freeBlock);
+    // Split the free block if the remainder is usable
+    uint64_t extraBytes = (blockAddr + blockSize) - (allocAddr + size);
+    if (extraBytes >= blockAlign_) {
+      this->insertFreeBlock(allocAddr + size, extraBytes);
+    } else {
+      size += extraBytes;
+    }
 
-    // Return the free block address
-    *addr = freeBlock->addr;
+    this->insertUsedBlock(allocAddr, size);
 
-    // Update allocated size
-    allocated_ += size;
+    // Return the block address
+    *addr = allocAddr;
 
     return 0;
   }
 
   int release(uint64_t addr) {
-    // Walk all pages to find the pointer
-    block_t* usedBlock = nullptr;
-    auto currPage = pages_;
-    while (currPage) {
-      usedBlock = currPage->findUsedBlock(addr);
-      if (usedBlock != nullptr)
-        break;
-      currPage = currPage->next;
-    }
-
-    // found the corresponding block?
-    if (nullptr == usedBlock) {
+    // find the corresponding block
+    auto it = usedBlocks_.find(addr);
+    if (it == usedBlocks_.end()) {
       printf("warning: release address not found: 0x%lx\n", addr);
       return -1;
     }
 
-    auto size = usedBlock->size;
-
-    // release the used block
-    currPage->release(usedBlock);
-
-    // Free the page if empty
-    if (currPage->empty()) {
-      this->deletePage(currPage);
-    }
+    auto size = it->second;
+    usedBlocks_.erase(it);
 
     // update allocated size
     allocated_ -= size;
 
-    return 0;
-  }
-
-private:
-
-  struct block_t {
-    block_t* nextFreeS;
-    block_t* prevFreeS;
-
-    block_t* nextFreeM;
-    block_t* prevFreeM;
-
-    block_t* nextUsed;
-    block_t* prevUsed;
-
-    uint64_t addr;
-    uint64_t size;
-
-    block_t(uint64_t addr, uint64_t size)
-      : nextFreeS(nullptr)
-      , prevFreeS(nullptr)
-      , nextFreeM(nullptr)
-      , prevFreeM(nullptr)
-      , nextUsed(nullptr)
-      , prevUsed(nullptr)
-      , addr(addr)
-      , size(size)
-    {}
-  };
-
-  struct page_t {
-    page_t*  next;
-    uint64_t addr;
-    uint64_t size;
-
-    page_t(uint64_t addr, uint64_t size, uint32_t blockAlign) :
-      next(nullptr),
-      addr(addr),
-      size(size),
-      blockAlign_(blockAlign),
-      usedList_(nullptr) {
-      freeSList_ = freeMList_ = new block_t(addr, size);
-    }
-
-    ~page_t() {
-      // The page should be empty
-      assert(nullptr == usedList_);
-      assert(freeMList_
-          && (nullptr == freeMList_->nextFreeM)
-          && (nullptr == freeMList_->prevFreeM));
-      delete freeMList_;
-    }
-
-    bool empty() const {
-      return (usedList_ == nullptr);
-    }
-
-    void allocate(uint64_t size, block_t* freeBlock) {
-      // Remove the block from the free lists
-      this->removeFreeMList(freeBlock);
-      this->removeFreeSList(freeBlock);
-
-      // If the free block we have found is larger than what we are looking for,
-      // we may be able to split our free block in two.
-      uint64_t extraBytes = freeBlock->size - size;
-      if (extraBytes >= blockAlign_) {
-        // Reduce the free block size to the requested value
-        freeBlock->size = size;
-
-        // Allocate a new block to contain the extra buffer
-        auto nextAddr = freeBlock->addr + size;
-        auto newBlock = new block_t(nextAddr, extraBytes);
-
-        // Add the new block to the free lists
-        this->insertFreeMList(newBlock);
-        this->insertFreeSList(newBlock);
-      }
-
-      // Insert the free block into the used list
-      this->insertUsedList(freeBlock);
-    }
-
-    void release(block_t* usedBlock) {
-      // Remove the block from the used list
-      this->removeUsedList(usedBlock);
-
-      // Insert the block into the free M-list.
-      this->insertFreeMList(usedBlock);
-
-      // Check if we can merge adjacent free blocks from the left.
-      if (usedBlock->prevFreeM) {
-        // Calculate the previous address
-        auto prevAddr = usedBlock->prevFreeM->addr + usedBlock->prevFreeM->size;
-        if (usedBlock->addr == prevAddr) {
-          auto prevBlock = usedBlock->prevFreeM;
-
-          // Merge the blocks to the left
-          prevBlock->size += usedBlock->size;
-          prevBlock->nextFreeM = usedBlock->nextFreeM;
-          if (prevBlock->nextFreeM) {
-            prevBlock->nextFreeM->prevFreeM = prevBlock;
-          }
-
-          // Detach previous block from the free S-list since size increased
-          this->removeFreeSList(prevBlock);
-
-          // reset usedBlock
-          delete usedBlock;
-          usedBlock = prevBlock;
-        }
-      }
-
-      // Check if we can merge adjacent free blocks from the right.
-      if (usedBlock->nextFreeM) {
-        // Calculate the next allocation start address
-        auto nextAddr = usedBlock->addr + usedBlock->size;
-        if (usedBlock->nextFreeM->addr == nextAddr) {
-          auto nextBlock = usedBlock->nextFreeM;
-
-          // Merge the blocks to the right
-          usedBlock->size += nextBlock->size;
-          usedBlock->nextFreeM = nextBlock->nextFreeM;
-          if (usedBlock->nextFreeM) {
-            usedBlock->nextFreeM->prevFreeM = usedBlock;
-          }
-
-          // Delete next block
-          this->removeFreeSList(nextBlock);
-          delete nextBlock;
-        }
-      }
-
-      // Insert the block into the free S-list.
-      this->insertFreeSList(usedBlock);
-    }
-
-    block_t* findFreeBlock(uint64_t size) {
-      auto freeBlock = freeSList_;
-      if (freeBlock) {
-        // The free S-list is already sorted with the largest block first
-        // Quick check if the head block has enough space.
-        if (freeBlock->size >= size) {
-          // Find the smallest matching block in the S-list
-          while (freeBlock->nextFreeS && (freeBlock->nextFreeS->size >= size)) {
-            freeBlock = freeBlock->nextFreeS;
-          }
-          // Return the free block
-          return freeBlock;
-        }
-      }
-      return nullptr;
+    // Merge with the adjacent free block to the right
+    auto next = freeBlocks_.find(addr + size);
+    if (next != freeBlocks_.end()) {
+      auto nextSize = next->second;
+      this->removeFreeBlock(addr + size, nextSize);
+      size += nextSize;
     }
 
-    block_t* findUsedBlock(uint64_t addr) {
-      if (addr >= this->addr && addr < (this->addr + this->size)) {
-        auto useBlock = usedList_;
-        while (useBlock) {
-          if (useBlock->addr == addr)
-            return useBlock;
-          useBlock = useBlock->nextUsed;
-        }
+    // Merge with the adjacent free block to the left
+    auto prev = freeBlocks_.lower_bound(addr);
+    if (prev != freeBlocks_.begin()) {
+      --prev;
+      if (prev->first + prev->second == addr) {
+        auto prevAddr = prev->first;
+        auto prevSize = prev->second;
+        this->removeFreeBlock(prevAddr, prevSize);
+        addr = prevAddr;
+        size += prevSize;
       }
-      return nullptr;
     }
-#ifdef VM_ENABLE 
-    block_t* findfirstUsedBlock() {
-      return usedList_;
-    }
-#endif
-
-  private:
 
-    void insertUsedList(block_t* block) {
-      block->nextUsed = usedList_;
-      if (usedList_) {
-        usedList_->prevUsed = block;
-      }
-      usedList_ = block;
-    }
+    this->insertFreeBlock(addr, size);
 
-    void removeUsedList(block_t* block) {
-      if (block->prevUsed) {
-        block->prevUsed->nextUsed = block->nextUsed;
-      } else {
-        usedList_ = block->nextUsed;
-      }
-      if (block->nextUsed) {
-        block->nextUsed->prevUsed = block->prevUsed;
-      }
-      block->nextUsed = nullptr;
-      block->prevUsed = nullptr;
-    }
+    return 0;
+  }
 
-    void insertFreeMList(block_t* block) {
-      block_t* currBlock = freeMList_;
-      block_t* prevBlock = nullptr;
-      while (currBlock && (currBlock->addr < block->addr)) {
-        prevBlock = currBlock;
-        currBlock = currBlock->nextFreeM;
-      }
-      block->nextFreeM = currBlock;
-      block->prevFreeM = prevBlock;
-      if (prevBlock) {
-        prevBlock->nextFreeM = block;
-      } else {
-        freeMList_ = block;
-      }
-      if (currBlock) {
-        currBlock->prevFreeM = block;
-      }
-    }
+private:
 
-    void removeFreeMList(block_t* block) {
-      if (block->prevFreeM) {
-        block->prevFreeM->nextFreeM = block->nextFreeM;
-      } else {
-        freeMList_ = block->nextFreeM;
-      }
-      if (block->nextFreeM) {
-        block->nextFreeM->prevFreeM = block->prevFreeM;
+  bool findFreeBlock(uint64_t size, uint64_t* addr, uint64_t* blockSize) const {
+    // Small requests: any block in a class at or above ceil(log2(size)) fits,
+    // pick the lowest address in the smallest such class.
+    uint32_t cls = log2ceil(size);
+    if (cls < numClasses_) {
+      uint64_t mask = classMask_ & (~0ull << cls);
+      if (mask != 0) {
+        auto& bin = sizeClasses_[__builtin_ctzll(mask)];
+        *addr = *bin.begin();
+        *blockSize = freeBlocks_.at(*addr);
+        return true;
       }
-      block->nextFreeM = nullptr;
-      block->prevFreeM = nullptr;
     }
 
-    void insertFreeSList(block_t* block) {
-      block_t* currBlock = freeSList_;
-      block_t* prevBlock = nullptr;
-      while (currBlock && (currBlock->size > block->size)) {
-        prevBlock = currBlock;
-        currBlock = currBlock->nextFreeS;
-      }
-      block->nextFreeS = currBlock;
-      block->prevFreeS = prevBlock;
-      if (prevBlock) {
-        prevBlock->nextFreeS = block;
-      } else {
-        freeSList_ = block;
-      }
-      if (currBlock) {
-        currBlock->prevFreeS = block;
-      }
-    }
+    // Large requests: best fit from the size-ordered tree
+    auto it = largeBlocks_.lower_bound(std::make_pair(size, uint64_t(0)));
+    if (it == largeBlocks_.end())
+      return false;
+    *blockSize = it->first;
+    *addr = it->second;
+    return true;
+  }
 
-    void removeFreeSList(block_t* block) {
-      if (block->prevFreeS) {
-        block->prevFreeS->nextFreeS = block->nextFreeS;
-      } else {
-        freeSList_ = block->nextFreeS;
-      }
-      if (block->nextFreeS) {
-        block->nextFreeS->prevFreeS = block->prevFreeS;
+  // best fit among the large blocks holding a page-aligned range of <size>
+  bool findPageBlock(uint64_t size, uint64_t* addr, uint64_t* blockSize) const {
+    for (auto it = largeBlocks_.lower_bound(std::make_pair(size, uint64_t(0))); it != largeBlocks_.end(); ++it) {
+      uint64_t offset = alignSize(it->second, pageAlign_) - it->second;
+      if (it->first - offset >= size) {
+        *blockSize = it->first;
+        *addr = it->second;
+        return true;
       }
-      block->nextFreeS = nullptr;
-      block->prevFreeS = nullptr;
     }
+    return false;
+  }
 
-    // block alignment
-    uint32_t blockAlign_;
-
-    // List of used blocks
-    block_t* usedList_;
-
-    // List with blocks sorted by decreasing sizes
-    // Used for block lookup during memory allocation.
-    block_t* freeSList_;
-
-    // List with blocks sorted by increasing memory addresses
-    // Used for block merging during memory release.
-    block_t* freeMList_;
-  };
-
-  page_t* createPage(uint64_t addr, uint64_t size) {
-    // Allocate object
-    auto newPage = new page_t(addr, size, blockAlign_);
-
-    // Insert the new page into the list in address sorted order
-    if (pages_ == nullptr || pages_->addr > newPage->addr) {
-      newPage->next = pages_;
-      pages_ = newPage;
+  void insertFreeBlock(uint64_t addr, uint64_t size) {
+    freeBlocks_.emplace(addr, size);
+    if (size < pageAlign_) {
+      auto cls = log2floor(size);
+      sizeClasses_[cls].insert(addr);
+      classMask_ |= (1ull << cls);
     } else {
-      page_t* current = pages_;
-      while (current->next != nullptr && current->next->addr < newPage->addr) {
-        current = current->next;
-      }
-      newPage->next = current->next;
-      current->next = newPage;
+      largeBlocks_.emplace(size, addr);
     }
-
-    return newPage;
   }
 
-  void deletePage(page_t* page) {
-    // Remove the page from the list
-    page_t* prevPage = nullptr;
-    auto currPage = pages_;
-    while (currPage) {
-      if (currPage == page) {
-        if (prevPage) {
-          prevPage->next = currPage->next;
-        } else {
-          pages_ = currPage->next;
-        }
-        break;
+  void removeFreeBlock(uint64_t addr, uint64_t size) {
+    freeBlocks_.erase(addr);
+    if (size < pageAlign_) {
+      auto cls = log2floor(size);
+      auto& bin = sizeClasses_[cls];
+      bin.erase(addr);
+      if (bin.empty()) {
+        classMask_ &= ~(1ull << cls);
       }
-      prevPage = currPage;
-      currPage = currPage->next;
+    } else {
+      largeBlocks_.erase(std::make_pair(size, addr));
     }
-    // Delete the page
-    delete page;
   }
 
-  bool findNextAddress(uint64_t size, uint64_t* addr) {
-    if (pages_ == nullptr) {
-      *addr = baseAddress_; 
-      return true;
-    }
-
-    page_t* current = pages_;
-    uint64_t endOfLastPage = baseAddress_;
-
-    while (current != nullptr) {
-      uint64_t startOfCurrentPage = current->addr;
-      if ((endOfLastPage + size) <= startOfCurrentPage) {
-        *addr = endOfLastPage;
-        return true;
-      }
-      // Update the end of the last page to the end of the current page
-      // Move to the next page in the sorted list
-      endOfLastPage = current->addr + current->size;
-      current = current->next;
-    }
-    
-    // If no suitable gap is found, place the new page at the end of the last page
-    // Check if the allocator has enough capacity
-    if ((endOfLastPage + size) <= (baseAddress_ + capacity_)) {
-      *addr = endOfLastPage;
-      return true;
+  void insertUsedBlock(uint64_t addr, uint64_t size) {
+    usedBlocks_.emplace(addr, size);
+    allocated_ += size;
+    if (allocated_ > peak_) {
+      peak_ = allocated_;
     }
+  }
 
-    return false;
+  static uint32_t log2floor(uint64_t value) {
+    assert(value != 0);
+    return 63 - __builtin_clzll(value);
   }
 
-  bool hasPageOverlap(uint64_t start, uint64_t size, uint64_t* overlapStart, uint64_t* overlapEnd) {
-    page_t* current = pages_;
-    while (current != nullptr) {
-      uint64_t pageStart = current->addr;
-      uint64_t pageEnd = pageStart + current->size;
-      uint64_t end = start + size;
-      if ((start <= pageEnd) && (end >= pageStart)) {
-        *overlapStart = pageStart;
-        *overlapEnd = pageEnd;
-        return true;
-      }
-      current = current->next;
-    }
-    return false;
+  static uint32_t log2ceil(uint64_t value) {
+    return (value > 1) ? log2floor(value - 1) + 1 : 0;
   }
 
   static uint64_t alignSize(uint64_t size, uint64_t alignment) {
@@ -549,9 +321,23 @@ private:
   uint64_t capacity_;
   uint32_t pageAlign_;
   uint32_t blockAlign_;
-  page_t*  pages_;
-  uint64_t nextAddress_;
+
+  // free blocks sorted by address, used for coalescing
+  std::map<uint64_t, uint64_t> freeBlocks_;
+
+  // free blocks smaller than a page, binned by power-of-two size class
+  std::set<uint64_t> sizeClasses_[64];
+  uint32_t numClasses_;
+  uint64_t classMask_;
+
+  // free blocks of a page or more, sorted by (size, address) for best-fit
+  std::set<std::pair<uint64_t, uint64_t>> largeBlocks_;
+
+  // allocated blocks
+  std::unordered_map<uint64_t, uint64_t> usedBlocks_;
+
   uint64_t allocated_;
+  uint64_t peak_;
 };
 
 } // namespace vortex
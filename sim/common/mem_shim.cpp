@@ -0,0 +1,112 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mem_shim.h"
+#include <assert.h>
+#include "util.h"
+
+using namespace vortex;
+
+MemShim::MemShim(uint32_t num_banks, uint32_t block_size, uint32_t queue_size, DramSim* dram_sim)
+  : banks_(num_banks)
+  , buffer_(uint64_t(num_banks) * queue_size * block_size)
+  , block_size_(block_size)
+  , queue_size_(queue_size)
+  , dram_sim_(dram_sim)
+  , ram_(nullptr) {
+  assert(ispow2(queue_size));
+  assert(block_size <= 64); // byte enables are 64-bit
+  for (uint32_t b = 0; b < num_banks; ++b) {
+    auto& queue = banks_[b];
+    queue.slots.resize(queue_size);
+    queue.issues.resize(queue_size);
+    for (uint32_t i = 0; i < queue_size; ++i) {
+      queue.slots[i].data = buffer_.data() + (uint64_t(b) * queue_size + i) * block_size;
+    }
+  }
+  this->reset();
+}
+
+MemShim::~MemShim() {
+  //--
+}
+
+void MemShim::reset() {
+  for (auto& queue : banks_) {
+    queue.head = 0;
+    queue.size = 0;
+    queue.issue_head = 0;
+    queue.issue_size = 0;
+  }
+}
+
+MemShim::req_t* MemShim::allocate(uint32_t bank, uint64_t addr, uint64_t tag, bool write) {
+  auto& queue = banks_[bank];
+  assert(queue.size < queue_size_);
+  auto& req = queue.slots[(queue.head + queue.size) & (queue_size_ - 1)];
+  ++queue.size;
+  req.addr  = addr;
+  req.tag   = tag;
+  req.write = write;
+  req.ready = false;
+  return &req;
+}
+
+void MemShim::issue(uint32_t bank, uint64_t addr, req_t* req, bool write) {
+  auto& queue = banks_[bank];
+  assert(queue.issue_size < queue_size_);
+  queue.issues[(queue.issue_head + queue.issue_size) & (queue_size_ - 1)] = {addr, req, write};
+  ++queue.issue_size;
+}
+
+void MemShim::read(uint32_t bank, uint64_t addr, uint64_t tag) {
+  auto req = this->allocate(bank, addr, tag, false);
+  ram_->read(req->data, addr, block_size_);
+  this->issue(bank, addr, req, false);
+}
+
+void MemShim::write(uint32_t bank, uint64_t addr, const uint8_t* data, uint64_t byteen, uint64_t tag, bool posted) {
+  // update RAM one contiguous run of enabled bytes at a time
+  uint32_t i = 0;
+  while (i < block_size_) {
+    if (!((byteen >> i) & 0x1)) {
+      ++i;
+      continue;
+    }
+    uint32_t start = i;
+    while (i < block_size_ && ((byteen >> i) & 0x1)) {
+      ++i;
+    }
+    ram_->write(data + start, addr + start, i - start);
+  }
+  auto req = posted ? nullptr : this->allocate(bank, addr, tag, true);
+  this->issue(bank, addr, req, true);
+}
+
+void MemShim::tick() {
+  for (auto& queue : banks_) {
+    if (queue.issue_size == 0)
+      continue;
+    auto& issue = queue.issues[queue.issue_head];
+    if (issue.req) {
+      dram_sim_->send_request(issue.addr, issue.write, [](void* arg) {
+        // mark completed request as ready
+        reinterpret_cast<req_t*>(arg)->ready = true;
+      }, issue.req);
+    } else {
+      dram_sim_->send_request(issue.addr, issue.write, nullptr, nullptr);
+    }
+    queue.issue_head = (queue.issue_head + 1) & (queue_size_ - 1);
+    --queue.issue_size;
+  }
+}
@@ -0,0 +1,106 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "mem.h"
+#include "dram_sim.h"
+
+namespace vortex {
+
+// Device memory bus model shared by the RTL simulators.
+// Each bank owns a fixed ring of preallocated request slots kept in arrival
+// order, so the bus never allocates while the simulation runs.
+// Reads snapshot their block from RAM when accepted and complete when the
+// DRAM model responds; writes update RAM when accepted.
+// Posted writes only go to the DRAM model and never produce a response.
+class MemShim {
+public:
+  struct req_t {
+    uint8_t* data;  // block data of reads
+    uint64_t addr;  // byte address
+    uint64_t tag;
+    bool     write;
+    bool     ready;
+  };
+
+  MemShim(uint32_t num_banks, uint32_t block_size, uint32_t queue_size, DramSim* dram_sim);
+  ~MemShim();
+
+  void attach_ram(RAM* ram) {
+    ram_ = ram;
+  }
+
+  void reset();
+
+  // true if the bank cannot accept <count> more requests
+  bool full(uint32_t bank, uint32_t count = 1) const {
+    auto& queue = banks_[bank];
+    return (queue.size + count > queue_size_)
+        || (queue.issue_size + count > queue_size_);
+  }
+
+  void read(uint32_t bank, uint64_t addr, uint64_t tag);
+
+  void write(uint32_t bank, uint64_t addr, const uint8_t* data, uint64_t byteen, uint64_t tag, bool posted = false);
+
+  // oldest request of the bank if it has completed, nullptr otherwise
+  const req_t* front(uint32_t bank) const {
+    auto& queue = banks_[bank];
+    if (queue.size == 0)
+      return nullptr;
+    auto& req = queue.slots[queue.head];
+    return req.ready ? &req : nullptr;
+  }
+
+  void pop(uint32_t bank) {
+    auto& queue = banks_[bank];
+    queue.head = (queue.head + 1) & (queue_size_ - 1);
+    --queue.size;
+  }
+
+  // send the oldest unsent request of each bank to the DRAM model
+  void tick();
+
+private:
+
+  struct issue_t {
+    uint64_t addr;
+    req_t*   req;  // nullptr for posted writes
+    bool     write;
+  };
+
+  struct bank_t {
+    std::vector<req_t>   slots;
+    std::vector<issue_t> issues;
+    uint32_t head;
+    uint32_t size;
+    uint32_t issue_head;
+    uint32_t issue_size;
+  };
+
+  req_t* allocate(uint32_t bank, uint64_t addr, uint64_t tag, bool write);
+
+  void issue(uint32_t bank, uint64_t addr, req_t* req, bool write);
+
+  std::vector<bank_t> banks_;
+  std::vector<uint8_t> buffer_;
+  uint32_t block_size_;
+  uint32_t queue_size_;
+  DramSim* dram_sim_;
+  RAM* ram_;
+};
+
+}
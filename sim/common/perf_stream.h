@@ -0,0 +1,102 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <vector>
+#include <assert.h>
+
+namespace vortex {
+
+// Periodic performance counter samples handed from the simulator thread
+// (producer) to the runtime (consumer) through a single-producer
+// single-consumer lock-free ring buffer.
+// Counter values are cumulative since the start of the run.
+class PerfStream {
+public:
+  enum Counter {
+    CYCLES,
+    INSTRS,
+    SCHED_STALLS,
+    IBUF_STALLS,
+    SCRB_STALLS,
+    ICACHE_MISSES,
+    DCACHE_MISSES,
+    L2CACHE_MISSES,
+    L3CACHE_MISSES,
+    MEM_READS,
+    MEM_WRITES,
+    MEM_LATENCY,
+    NUM_COUNTERS
+  };
+
+  struct sample_t {
+    uint64_t values[NUM_COUNTERS];
+  };
+
+  PerfStream(uint64_t interval, uint32_t capacity)
+    : buffer_(capacity)
+    , mask_(capacity - 1)
+    , interval_(interval)
+    , head_(0)
+    , tail_(0)
+    , dropped_(0)
+  {
+    assert(interval != 0);
+    assert(capacity != 0 && 0 == (capacity & (capacity - 1)));
+  }
+
+  // sampling period in device cycles
+  uint64_t interval() const {
+    return interval_;
+  }
+
+  // producer side, drops the sample if the consumer fell behind
+  bool push(const sample_t& sample) {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) > mask_) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    buffer_[tail & mask_] = sample;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // consumer side
+  bool pop(sample_t* sample) {
+    auto head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire))
+      return false;
+    *sample = buffer_[head & mask_];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // number of samples lost to overflow
+  uint64_t dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::vector<sample_t> buffer_;
+  uint64_t mask_;
+  uint64_t interval_;
+  alignas(64) std::atomic<uint64_t> head_;
+  alignas(64) std::atomic<uint64_t> tail_;
+  std::atomic<uint64_t> dropped_;
+};
+
+} // namespace vortex
@@ -13,6 +13,10 @@
 
 #include "rvfloats.h"
 #include <stdio.h>
+#include <string.h>
+#include <cmath>
+#include <cfenv>
+#include <cfloat>
 
 extern "C" {
 #include <softfloat.h>
@@ -35,11 +39,70 @@ inline void rv_init(uint32_t frm) {
   softfloat_roundingMode = frm;
 }
 
+// Host floating-point fast path.
+// Under round-to-nearest-even, the host IEEE arithmetic and exception flags match
+// softfloat for basic operations, except for NaN payloads and tiny results.
+// Those cases and the other rounding modes return false and are left to softfloat.
+// Hosts evaluating with excess precision (x87) always use softfloat.
+#if !defined(DISABLE_HOST_FP) && (FLT_EVAL_METHOD == 0)
+
+template <typename F, typename B>
+inline F host_float(B x) { F f; memcpy(&f, &x, sizeof(F)); return f; }
+
+template <typename B, typename F>
+inline B host_bits(F x) { B b; memcpy(&b, &x, sizeof(B)); return b; }
+
+inline uint32_t host_fflags(int excepts) {
+  uint32_t fflags = 0;
+  if (excepts & FE_INEXACT)   fflags |= softfloat_flag_inexact;
+  if (excepts & FE_UNDERFLOW) fflags |= softfloat_flag_underflow;
+  if (excepts & FE_OVERFLOW)  fflags |= softfloat_flag_overflow;
+  if (excepts & FE_DIVBYZERO) fflags |= softfloat_flag_infinite;
+  if (excepts & FE_INVALID)   fflags |= softfloat_flag_invalid;
+  return fflags;
+}
+
+template <typename F, typename B, int MANT_BITS, typename Op>
+inline bool host_fp(B* r, uint32_t frm, uint32_t* fflags, const Op& op, B a, B b = 0, B c = 0) {
+  if (frm != softfloat_round_near_even)
+    return false;
+  // volatile accesses keep the operation between the flag accesses
+  volatile F x = host_float<F>(a), y = host_float<F>(b), z = host_float<F>(c);
+  std::feclearexcept(FE_ALL_EXCEPT);
+  volatile F v = op(x, y, z);
+  int excepts = std::fetestexcept(FE_ALL_EXCEPT);
+  auto bits = host_bits<B>((F)v);
+  B mant_mask = (B(1) << MANT_BITS) - 1;
+  B exp = (bits >> MANT_BITS) & ((B(1) << (sizeof(B) * 8 - 1 - MANT_BITS)) - 1);
+  B exp_max = (B(1) << (sizeof(B) * 8 - 1 - MANT_BITS)) - 1;
+  if ((exp == exp_max && (bits & mant_mask) != 0) // NaN
+   || (exp == 0 && (bits & mant_mask) != 0)       // subnormal
+   || (excepts & FE_UNDERFLOW))
+    return false;
+  *r = bits;
+  if (fflags) { *fflags = host_fflags(excepts); }
+  return true;
+}
+
+#define HOST_FP_S(...) \
+  { uint32_t r; if (host_fp<float, uint32_t, 23>(&r, frm, fflags, __VA_ARGS__)) return r; }
+
+#define HOST_FP_D(...) \
+  { uint64_t r; if (host_fp<double, uint64_t, 52>(&r, frm, fflags, __VA_ARGS__)) return r; }
+
+#else
+
+#define HOST_FP_S(...)
+#define HOST_FP_D(...)
+
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 uint32_t rv_fadd_s(uint32_t a, uint32_t b, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_S([](auto x, auto y, auto) { return x + y; }, a, b);
   rv_init(frm);
   auto r = f32_add(to_float32_t(a), to_float32_t(b));
   if (fflags) { *fflags = softfloat_exceptionFlags; }
@@ -47,6 +110,7 @@ uint32_t rv_fadd_s(uint32_t a, uint32_t b, uint32_t frm, uint32_t* fflags) {
 }
 
 uint64_t rv_fadd_d(uint64_t a, uint64_t b, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_D([](auto x, auto y, auto) { return x + y; }, a, b);
   rv_init(frm);
   auto r = f64_add(to_float64_t(a), to_float64_t(b));
   if (fflags) { *fflags = softfloat_exceptionFlags; }
@@ -54,6 +118,7 @@ uint64_t rv_fadd_d(uint64_t a, uint64_t b, uint32_t frm, uint32_t* fflags) {
 }
 
 uint32_t rv_fsub_s(uint32_t a, uint32_t b, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_S([](auto x, auto y, auto) { return x - y; }, a, b);
   rv_init(frm);
   auto r = f32_sub(to_float32_t(a), to_float32_t(b));
   if (fflags) { *fflags = softfloat_exceptionFlags; }
@@ -61,6 +126,7 @@ uint32_t rv_fsub_s(uint32_t a, uint32_t b, uint32_t frm, uint32_t* fflags) {
 }
 
 uint64_t rv_fsub_d(uint64_t a, uint64_t b, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_D([](auto x, auto y, auto) { return x - y; }, a, b);
   rv_init(frm);
   auto r = f64_sub(to_float64_t(a), to_float64_t(b));
   if (fflags) { *fflags = softfloat_exceptionFlags; }
@@ -68,6 +134,7 @@ uint64_t rv_fsub_d(uint64_t a, uint64_t b, uint32_t frm, uint32_t* fflags) {
 }
 
 uint32_t rv_fmul_s(uint32_t a, uint32_t b, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_S([](auto x, auto y, auto) { return x * y; }, a, b);
   rv_init(frm);
   auto r = f32_mul(to_float32_t(a), to_float32_t(b));
   if (fflags) { *fflags = softfloat_exceptionFlags; }
@@ -75,6 +142,7 @@ uint32_t rv_fmul_s(uint32_t a, uint32_t b, uint32_t frm, uint32_t* fflags) {
 }
 
 uint64_t rv_fmul_d(uint64_t a, uint64_t b, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_D([](auto x, auto y, auto) { return x * y; }, a, b);
   rv_init(frm);
   auto r = f64_mul(to_float64_t(a), to_float64_t(b));
   if (fflags) { *fflags = softfloat_exceptionFlags; }
@@ -82,6 +150,7 @@ uint64_t rv_fmul_d(uint64_t a, uint64_t b, uint32_t frm, uint32_t* fflags) {
 }
 
 uint32_t rv_fmadd_s(uint32_t a, uint32_t b, uint32_t c, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_S([](auto x, auto y, auto z) { return std::fma(x, y, z); }, a, b, c);
   rv_init(frm);
   auto r = f32_mulAdd(to_float32_t(a), to_float32_t(b), to_float32_t(c));
   if (fflags) { *fflags = softfloat_exceptionFlags; }
@@ -89,6 +158,7 @@ uint32_t rv_fmadd_s(uint32_t a, uint32_t b, uint32_t c, uint32_t frm, uint32_t*
 }
 
 uint64_t rv_fmadd_d(uint64_t a, uint64_t b, uint64_t c, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_D([](auto x, auto y, auto z) { return std::fma(x, y, z); }, a, b, c);
   rv_init(frm);
   auto r = f64_mulAdd(to_float64_t(a), to_float64_t(b), to_float64_t(c));
   if (fflags) { *fflags = softfloat_exceptionFlags; }
@@ -96,6 +166,7 @@ uint64_t rv_fmadd_d(uint64_t a, uint64_t b, uint64_t c, uint32_t frm, uint32_t*
 }
 
 uint32_t rv_fmsub_s(uint32_t a, uint32_t b, uint32_t c, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_S([](auto x, auto y, auto z) { return std::fma(x, y, -z); }, a, b, c);
   rv_init(frm);
   auto c_neg = c ^ F32_SIGN;
   auto r = f32_mulAdd(to_float32_t(a), to_float32_t(b), to_float32_t(c_neg));
@@ -104,6 +175,7 @@ uint32_t rv_fmsub_s(uint32_t a, uint32_t b, uint32_t c, uint32_t frm, uint32_t*
 }
 
 uint64_t rv_fmsub_d(uint64_t a, uint64_t b, uint64_t c, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_D([](auto x, auto y, auto z) { return std::fma(x, y, -z); }, a, b, c);
   rv_init(frm);
   auto c_neg = c ^ F64_SIGN;
   auto r = f64_mulAdd(to_float64_t(a), to_float64_t(b), to_float64_t(c_neg));
@@ -112,6 +184,7 @@ uint64_t rv_fmsub_d(uint64_t a, uint64_t b, uint64_t c, uint32_t frm, uint32_t*
 }
 
 uint32_t rv_fnmadd_s(uint32_t a, uint32_t b, uint32_t c, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_S([](auto x, auto y, auto z) { return std::fma(-x, y, -z); }, a, b, c);
   rv_init(frm);
   auto a_neg = a ^ F32_SIGN;
   auto c_neg = c ^ F32_SIGN;
@@ -121,6 +194,7 @@ uint32_t rv_fnmadd_s(uint32_t a, uint32_t b, uint32_t c, uint32_t frm, uint32_t*
 }
 
 uint64_t rv_fnmadd_d(uint64_t a, uint64_t b, uint64_t c, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_D([](auto x, auto y, auto z) { return std::fma(-x, y, -z); }, a, b, c);
   rv_init(frm);
   auto a_neg = a ^ F64_SIGN;
   auto c_neg = c ^ F64_SIGN;
@@ -130,6 +204,7 @@ uint64_t rv_fnmadd_d(uint64_t a, uint64_t b, uint64_t c, uint32_t frm, uint32_t*
 }
 
 uint32_t rv_fnmsub_s(uint32_t a, uint32_t b, uint32_t c, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_S([](auto x, auto y, auto z) { return std::fma(-x, y, z); }, a, b, c);
   rv_init(frm);
   auto a_neg = a ^ F32_SIGN;
   auto r = f32_mulAdd(to_float32_t(a_neg), to_float32_t(b), to_float32_t(c));
@@ -138,6 +213,7 @@ uint32_t rv_fnmsub_s(uint32_t a, uint32_t b, uint32_t c, uint32_t frm, uint32_t*
 }
 
 uint64_t rv_fnmsub_d(uint64_t a, uint64_t b, uint64_t c, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_D([](auto x, auto y, auto z) { return std::fma(-x, y, z); }, a, b, c);
   rv_init(frm);
   auto a_neg = a ^ F64_SIGN;
   auto r = f64_mulAdd(to_float64_t(a_neg), to_float64_t(b), to_float64_t(c));
@@ -146,6 +222,7 @@ uint64_t rv_fnmsub_d(uint64_t a, uint64_t b, uint64_t c, uint32_t frm, uint32_t*
 }
 
 uint32_t rv_fdiv_s(uint32_t a, uint32_t b, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_S([](auto x, auto y, auto) { return x / y; }, a, b);
   rv_init(frm);
   auto r = f32_div(to_float32_t(a), to_float32_t(b));
   if (fflags) { *fflags = softfloat_exceptionFlags; }
@@ -153,6 +230,7 @@ uint32_t rv_fdiv_s(uint32_t a, uint32_t b, uint32_t frm, uint32_t* fflags) {
 }
 
 uint64_t rv_fdiv_d(uint64_t a, uint64_t b, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_D([](auto x, auto y, auto) { return x / y; }, a, b);
   rv_init(frm);
   auto r = f64_div(to_float64_t(a), to_float64_t(b));
   if (fflags) { *fflags = softfloat_exceptionFlags; }
@@ -188,6 +266,7 @@ uint64_t rv_frsqrt7_d(uint64_t a, uint32_t frm, uint32_t* fflags) {
 }
 
 uint32_t rv_fsqrt_s(uint32_t a, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_S([](auto x, auto, auto) { return std::sqrt(x); }, a);
   rv_init(frm);
   auto r = f32_sqrt(to_float32_t(a));
   if (fflags) { *fflags = softfloat_exceptionFlags; }
@@ -195,6 +274,7 @@ uint32_t rv_fsqrt_s(uint32_t a, uint32_t frm, uint32_t* fflags) {
 }
 
 uint64_t rv_fsqrt_d(uint64_t a, uint32_t frm, uint32_t* fflags) {
+  HOST_FP_D([](auto x, auto, auto) { return std::sqrt(x); }, a);
   rv_init(frm);
   auto r = f64_sqrt(to_float64_t(a));
   if (fflags) { *fflags = softfloat_exceptionFlags; }
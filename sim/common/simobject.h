@@ -360,6 +360,11 @@ public:
     return cycles_;
   }
 
+  // no packet in flight between components
+  bool idle() const {
+    return events_.empty();
+  }
+
 private:
 
   SimPlatform() : cycles_(0) {}
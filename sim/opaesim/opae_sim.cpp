@@ -25,11 +25,13 @@
 #include <mem.h>
 
 #include <dram_sim.h>
+#include <mem_shim.h>
 
 #include <VX_config.h>
 #include <vortex_afu.h>
 
 #include <future>
+#include <atomic>
 #include <list>
 #include <queue>
 #include <unordered_map>
@@ -39,6 +41,10 @@
 #define MEM_CLOCK_RATIO 1
 #endif
 
+#ifndef MEM_QUEUE_SIZE
+#define MEM_QUEUE_SIZE 256
+#endif
+
 #define CACHE_BLOCK_SIZE  64
 
 #define CCI_LATENCY  8
@@ -72,7 +78,8 @@ double sc_time_stamp() {
   return timestamp;
 }
 
-static bool trace_enabled = false;
+// toggled by dpi_trace_start/stop from any Verilator thread
+static std::atomic<bool> trace_enabled(false);
 static uint64_t trace_start_time = TRACE_START_TIME;
 static uint64_t trace_stop_time = TRACE_STOP_TIME;
 
@@ -96,6 +103,7 @@ public:
   : device_(nullptr)
   , ram_(nullptr)
   , dram_sim_(PLATFORM_MEMORY_NUM_BANKS, PLATFORM_MEMORY_DATA_SIZE, MEM_CLOCK_RATIO)
+  , mem_shim_(PLATFORM_MEMORY_NUM_BANKS, PLATFORM_MEMORY_DATA_SIZE, MEM_QUEUE_SIZE, &dram_sim_)
   , stop_(false)
   , host_buffer_ids_(0)
 #ifdef VCD_OUTPUT
@@ -145,6 +153,7 @@ public:
 
     // allocate RAM
     ram_ = new RAM(0, RAM_PAGE_SIZE);
+    mem_shim_.attach_ram(ram_);
 
     // reset the device
     this->reset();
@@ -244,14 +253,7 @@ private:
     this->cci_bus_reset();
     this->avs_bus_reset();
 
-    for (auto& reqs : pending_mem_reqs_) {
-      reqs.clear();
-    }
-
-    {
-      std::queue<mem_req_t*> empty;
-      std::swap(dram_queue_, empty);
-    }
+    mem_shim_.reset();
 
     device_->reset = 1;
 
@@ -269,18 +271,7 @@ private:
     this->cci_bus_eval();
     this->avs_bus_eval();
 
-    if (!dram_queue_.empty()) {
-      auto mem_req = dram_queue_.front();
-      dram_sim_.send_request(mem_req->addr, mem_req->write, [](void* arg) {
-        auto orig_req = reinterpret_cast<mem_req_t*>(arg);
-        if (orig_req->ready) {
-          delete orig_req;
-        } else {
-          orig_req->ready = true;
-        }
-      }, mem_req);
-      dram_queue_.pop();
-    }
+    mem_shim_.tick();
 
     dram_sim_.tick();
 
@@ -413,15 +404,11 @@ private:
     for (int b = 0; b < PLATFORM_MEMORY_NUM_BANKS; ++b) {
       // process memory responses
       device_->avs_readdatavalid[b] = 0;
-      if (!pending_mem_reqs_[b].empty()
-       && (*pending_mem_reqs_[b].begin())->ready) {
-        auto mem_rd_it = pending_mem_reqs_[b].begin();
-        auto mem_req = *mem_rd_it;
+      auto mem_rsp = mem_shim_.front(b);
+      if (mem_rsp) {
         device_->avs_readdatavalid[b] = 1;
-        memcpy(device_->avs_readdata[b], mem_req->data.data(), PLATFORM_MEMORY_DATA_SIZE);
-        uint32_t addr = mem_req->addr;
-        pending_mem_reqs_[b].erase(mem_rd_it);
-        delete mem_req;
+        memcpy(device_->avs_readdata[b], mem_rsp->data, PLATFORM_MEMORY_DATA_SIZE);
+        mem_shim_.pop(b);
       }
 
       // process memory requests
@@ -432,63 +419,33 @@ private:
       uint64_t byte_addr = (uint64_t(device_->avs_address[b]) + (b << g_mem_bank_addr_width)) * PLATFORM_MEMORY_DATA_SIZE;
     #endif
 
-      if (device_->avs_write[b]) {
-        // process write request
-        uint64_t byteen = device_->avs_byteenable[b];
-        uint8_t* data = (uint8_t*)(device_->avs_writedata[b].data());
-        for (int i = 0; i < PLATFORM_MEMORY_DATA_SIZE; i++) {
-          if ((byteen >> i) & 0x1) {
-            (*ram_)[byte_addr + i] = data[i];
-          }
-        }
+      // requests are held by the device while waitrequest is asserted
+      if (!device_->avs_waitrequest[b]) {
+        if (device_->avs_write[b]) {
+          // process write request
+          uint64_t byteen = device_->avs_byteenable[b];
+          uint8_t* data = (uint8_t*)(device_->avs_writedata[b].data());
 
-        /*printf("%0ld: [sim] MEM Wr Req[%d]: addr=0x%lx, byteen=0x%lx, data=0x", timestamp, b, byte_addr, byteen);
-        for (int i = PLATFORM_MEMORY_DATA_SIZE-1; i >= 0; --i) {
-          printf("%02x", data[i]);
-        }
-        printf("\n");*/
-
-        // send dram request
-        auto mem_req = new mem_req_t();
-        mem_req->addr  = device_->avs_address[b];
-        mem_req->bank_id = b;
-        mem_req->write = true;
-        mem_req->ready = true;
-
-        dram_queue_.push(mem_req);
-      } else
-      if (device_->avs_read[b]) {
-        // process read request
-        auto mem_req = new mem_req_t();
-        mem_req->addr = device_->avs_address[b];
-        mem_req->bank_id = b;
-        ram_->read(mem_req->data.data(), byte_addr, PLATFORM_MEMORY_DATA_SIZE);
-        mem_req->write = false;
-        mem_req->ready = false;
-        pending_mem_reqs_[b].emplace_back(mem_req);
-
-        /*printf("%0ld: [sim] MEM Rd Req[%d]: addr=0x%lx, pending={", timestamp, b, byte_addr);
-        for (int i = PLATFORM_MEMORY_DATA_SIZE-1; i >= 0; --i) {
-          printf("%02x", mem_req->data[i]);
+          /*printf("%0ld: [sim] MEM Wr Req[%d]: addr=0x%lx, byteen=0x%lx, data=0x", timestamp, b, byte_addr, byteen);
+          for (int i = PLATFORM_MEMORY_DATA_SIZE-1; i >= 0; --i) {
+            printf("%02x", data[i]);
+          }
+          printf("\n");*/
+
+          // Avalon writes have no response
+          mem_shim_.write(b, byte_addr, data, byteen, 0, true);
+        } else
+        if (device_->avs_read[b]) {
+          // process read request
+          mem_shim_.read(b, byte_addr, 0);
         }
-        printf("\n");*/
-
-        // send dram request
-        dram_queue_.push(mem_req);
       }
 
-      device_->avs_waitrequest[b] = false;
+      // stall the bank while its request queue is full
+      device_->avs_waitrequest[b] = mem_shim_.full(b);
     }
   }
 
-  typedef struct {
-    std::array<uint8_t, PLATFORM_MEMORY_DATA_SIZE> data;
-    uint32_t addr;
-    uint32_t bank_id;
-    bool write;
-    bool ready;
-  } mem_req_t;
-
   typedef struct {
     int cycles_left;
     std::array<uint8_t, CACHE_BLOCK_SIZE> data;
@@ -510,6 +467,7 @@ private:
   Vvortex_afu_shim *device_;
   RAM* ram_;
   DramSim dram_sim_;
+  MemShim mem_shim_;
 
   std::future<void> future_;
   bool stop_;
@@ -517,15 +475,11 @@ private:
   std::unordered_map<int64_t, host_buffer_t> host_buffers_;
   uint64_t host_buffer_ids_;
 
-  std::list<mem_req_t*> pending_mem_reqs_[PLATFORM_MEMORY_NUM_BANKS];
-
   std::list<cci_rd_req_t> cci_reads_;
   std::list<cci_wr_req_t> cci_writes_;
 
   std::mutex mutex_;
 
-  std::queue<mem_req_t*> dram_queue_;
-
 #ifdef VCD_OUTPUT
   VerilatedVcdC *tfp_;
 #endif
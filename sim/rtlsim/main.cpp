@@ -91,7 +91,8 @@ int main(int argc, char **argv) {
 	std::cout << "[VXDRV] START: program=" << program << std::endl;
 #endif
 	// run simulation
-	processor.run();
+	if (processor.run() != 0)
+		return -1;
 
 	// read exitcode from @MPM.1
   ram.read(&exitcode, (IO_MPM_ADDR + 8), 4);
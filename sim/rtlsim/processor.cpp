@@ -14,10 +14,7 @@
 #include "processor.h"
 
 #include "Vrtlsim_shim.h"
-
-#ifdef VCD_OUTPUT
-#include <verilated_vcd_c.h>
-#endif
+#include "wave_trace.h"
 
 #include <iostream>
 #include <fstream>
@@ -33,18 +30,16 @@
 #include <unordered_map>
 
 #include <dram_sim.h>
+#include <mem_shim.h>
+#include <commit_log.h>
 #include <util.h>
 
 #ifndef MEM_CLOCK_RATIO
 #define MEM_CLOCK_RATIO 1
 #endif
 
-#ifndef TRACE_START_TIME
-#define TRACE_START_TIME 0ull
-#endif
-
-#ifndef TRACE_STOP_TIME
-#define TRACE_STOP_TIME -1ull
+#ifndef MEM_QUEUE_SIZE
+#define MEM_QUEUE_SIZE 256
 #endif
 
 #ifndef VERILATOR_RESET_VALUE
@@ -74,26 +69,28 @@ double sc_time_stamp() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static bool trace_enabled = false;
-static uint64_t trace_start_time = TRACE_START_TIME;
-static uint64_t trace_stop_time  = TRACE_STOP_TIME;
+static WaveTrace wave_trace;
 
 bool sim_trace_enabled() {
-  if (timestamp >= trace_start_time
-   && timestamp < trace_stop_time)
-    return true;
-  return trace_enabled;
+  return wave_trace.active();
 }
 
+// called by dpi_trace_start/stop from any Verilator thread
 void sim_trace_enable(bool enable) {
-  trace_enabled = enable;
+  if (enable) {
+    wave_trace.trigger();
+  } else {
+    wave_trace.stop();
+  }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 class Processor::Impl {
 public:
-  Impl() : dram_sim_(PLATFORM_MEMORY_NUM_BANKS, PLATFORM_MEMORY_DATA_SIZE, MEM_CLOCK_RATIO) {
+  Impl()
+    : dram_sim_(PLATFORM_MEMORY_NUM_BANKS, PLATFORM_MEMORY_DATA_SIZE, MEM_CLOCK_RATIO)
+    , mem_shim_(PLATFORM_MEMORY_NUM_BANKS, PLATFORM_MEMORY_DATA_SIZE, MEM_QUEUE_SIZE, &dram_sim_) {
     // force random values for uninitialized signals
     Verilated::randReset(VERILATOR_RESET_VALUE);
     Verilated::randSeed(50);
@@ -106,13 +103,24 @@ public:
 
   #ifdef VCD_OUTPUT
     Verilated::traceEverOn(true);
-    tfp_ = new VerilatedVcdC();
+    tfp_ = new WaveTrace::trace_file_t();
     device_->trace(tfp_, 99);
-    tfp_->open("trace.vcd");
+    wave_trace.attach(tfp_);
   #endif
 
     ram_ = nullptr;
 
+    perf_stream_ = nullptr;
+    perf_cycles_ = 0;
+    perf_mem_reads_ = 0;
+    perf_mem_writes_ = 0;
+    perf_mem_latency_ = 0;
+    perf_mem_pending_reads_ = 0;
+
+  #ifdef COSIM_ENABLE
+    CommitLog::instance().open(NUM_THREADS, XLEN);
+  #endif
+
     // reset the device
     this->reset();
 
@@ -123,8 +131,8 @@ public:
   ~Impl() {
     this->cout_flush();
 
+    wave_trace.flush();
   #ifdef VCD_OUTPUT
-    tfp_->close();
     delete tfp_;
   #endif
 
@@ -142,9 +150,10 @@ public:
 
   void attach_ram(RAM* ram) {
     ram_ = ram;
+    mem_shim_.attach_ram(ram);
   }
 
-  void run() {
+  int run() {
   #ifndef NDEBUG
     std::cout << std::dec << timestamp << ": [sim] run()" << std::endl;
   #endif
@@ -152,6 +161,12 @@ public:
     // reset device
     this->reset();
 
+    perf_cycles_ = 0;
+    perf_mem_reads_ = 0;
+    perf_mem_writes_ = 0;
+    perf_mem_latency_ = 0;
+    perf_mem_pending_reads_ = 0;
+
     // start
     device_->reset = 0;
     for (int b = 0; b < PLATFORM_MEMORY_NUM_BANKS; ++b) {
@@ -161,17 +176,36 @@ public:
     // wait on device to go busy
     while (!device_->busy) {
       this->tick();
+      this->perf_tick();
     }
 
     // wait on device to go idle
+    int exitcode = 0;
     while (device_->busy) {
+      if (wave_trace.timeout(perf_cycles_)) {
+        printf("error: simulation timeout after %ld cycles\n", perf_cycles_);
+        wave_trace.flush();
+        exitcode = -1;
+        break;
+      }
       this->tick();
+      this->perf_tick();
+    }
+
+    if (perf_stream_) {
+      this->perf_sample();
     }
 
     // stop
     device_->reset = 1;
 
+  #ifdef COSIM_ENABLE
+    CommitLog::instance().end_run();
+  #endif
+
     this->cout_flush();
+
+    return exitcode;
   }
 
   void dcr_write(uint32_t addr, uint32_t value) {
@@ -183,22 +217,37 @@ public:
     this->tick();
   }
 
+  void attach_perf_stream(PerfStream* stream) {
+    perf_stream_ = stream;
+  }
+
 private:
 
+  void perf_tick() {
+    ++perf_cycles_;
+    perf_mem_latency_ += perf_mem_pending_reads_;
+    if (perf_stream_ && 0 == (perf_cycles_ % perf_stream_->interval())) {
+      this->perf_sample();
+    }
+  }
+
+  // only the memory bus is visible from here, core counters stay zero
+  void perf_sample() {
+    PerfStream::sample_t sample = {};
+    sample.values[PerfStream::CYCLES]      = perf_cycles_;
+    sample.values[PerfStream::MEM_READS]   = perf_mem_reads_;
+    sample.values[PerfStream::MEM_WRITES]  = perf_mem_writes_;
+    sample.values[PerfStream::MEM_LATENCY] = perf_mem_latency_;
+    perf_stream_->push(sample);
+  }
+
   void reset() {
     this->mem_bus_reset();
     this->dcr_bus_reset();
 
     print_bufs_.clear();
 
-    for (auto& reqs : pending_mem_reqs_) {
-      reqs.clear();
-    }
-
-    for (int b = 0; b < PLATFORM_MEMORY_NUM_BANKS; ++b) {
-      std::queue<mem_req_t*> empty;
-      std::swap(dram_queue_[b], empty);
-    }
+    mem_shim_.reset();
 
     device_->reset = 1;
 
@@ -224,17 +273,7 @@ private:
 
     dram_sim_.tick();
 
-    for (int b = 0; b < PLATFORM_MEMORY_NUM_BANKS; ++b) {
-      if (!dram_queue_[b].empty()) {
-        auto mem_req = dram_queue_[b].front();
-        dram_sim_.send_request(mem_req->addr, mem_req->write, [](void* arg) {
-          // mark completed request as ready
-          auto orig_req = reinterpret_cast<mem_req_t*>(arg);
-          orig_req->ready = true;
-        }, mem_req);
-        dram_queue_[b].pop();
-      }
-    }
+    mem_shim_.tick();
 
   #ifndef NDEBUG
     fflush(stdout);
@@ -243,11 +282,7 @@ private:
 
   void eval() {
     device_->eval();
-  #ifdef VCD_OUTPUT
-    if (sim_trace_enabled()) {
-      tfp_->dump(timestamp);
-    }
-  #endif
+    wave_trace.dump(timestamp);
     ++timestamp;
   }
 
@@ -272,20 +307,17 @@ private:
         device_->mem_rsp_valid[b] = 0;
       }
       if (device_->mem_rsp_valid[b] == 0) {
-        if (!pending_mem_reqs_[b].empty()) {
-          auto mem_rsp_it = pending_mem_reqs_[b].begin();
-          auto mem_rsp = *mem_rsp_it;
-          if (mem_rsp->ready) {
-            if (!mem_rsp->write) {
-              // return read responses
-              device_->mem_rsp_valid[b] = 1;
-              memcpy(VDataCast<void*, PLATFORM_MEMORY_DATA_SIZE>::get(device_->mem_rsp_data[b]), mem_rsp->data.data(), PLATFORM_MEMORY_DATA_SIZE);
-              device_->mem_rsp_tag[b] = mem_rsp->tag;
-            }
-            // delete the request
-            pending_mem_reqs_[b].erase(mem_rsp_it);
-            delete mem_rsp;
+        auto mem_rsp = mem_shim_.front(b);
+        if (mem_rsp) {
+          if (!mem_rsp->write) {
+            // return read responses
+            --perf_mem_pending_reads_;
+            device_->mem_rsp_valid[b] = 1;
+            memcpy(VDataCast<void*, PLATFORM_MEMORY_DATA_SIZE>::get(device_->mem_rsp_data[b]), mem_rsp->data, PLATFORM_MEMORY_DATA_SIZE);
+            device_->mem_rsp_tag[b] = mem_rsp->tag;
           }
+          // release the request
+          mem_shim_.pop(b);
         }
       }
 
@@ -327,46 +359,23 @@ private:
             }
             printf("\n");*/
 
-            for (int i = 0; i < PLATFORM_MEMORY_DATA_SIZE; i++) {
-              if ((byteen >> i) & 0x1) {
-                (*ram_)[byte_addr + i] = data[i];
-              }
-            }
-
-            auto mem_req = new mem_req_t();
-            mem_req->tag   = device_->mem_req_tag[b];
-            mem_req->addr  = byte_addr;
-            mem_req->write = true;
-            mem_req->ready = false;
+            mem_shim_.write(b, byte_addr, data, byteen, device_->mem_req_tag[b]);
 
-            // enqueue dram request
-            dram_queue_[b].push(mem_req);
-
-            // add to pending list
-            pending_mem_reqs_[b].emplace_back(mem_req);
+            ++perf_mem_writes_;
           }
         } else {
           // process memory reads
-          auto mem_req = new mem_req_t();
-          mem_req->tag   = device_->mem_req_tag[b];
-          mem_req->addr  = byte_addr;
-          mem_req->write = false;
-          mem_req->ready = false;
-          ram_->read(mem_req->data.data(), byte_addr, PLATFORM_MEMORY_DATA_SIZE);
-
-          /*printf("%0ld: [sim] MEM Rd Req[%d]: addr=0x%0lx, tag=0x%0lx, data=0x", timestamp, b, byte_addr, device_->mem_req_tag[b]);
-          for (int i = PLATFORM_MEMORY_DATA_SIZE-1; i >= 0; --i) {
-            printf("%02x", mem_req->data[i]);
-          }
-          printf("\n");*/
-
-          // enqueue dram request
-          dram_queue_[b].push(mem_req);
+          mem_shim_.read(b, byte_addr, device_->mem_req_tag[b]);
 
-          // add to pending list
-          pending_mem_reqs_[b].emplace_back(mem_req);
+          ++perf_mem_reads_;
+          ++perf_mem_pending_reads_;
         }
       }
+
+      // stall the bank while its request queue is full
+      if (!device_->reset) {
+        device_->mem_req_ready[b] = !mem_shim_.full(b);
+      }
     }
   }
 
@@ -382,31 +391,27 @@ private:
 
 private:
 
-  typedef struct {
-    Vrtlsim_shim* device;
-    std::array<uint8_t, PLATFORM_MEMORY_DATA_SIZE> data;
-    uint64_t addr;
-    uint64_t tag;
-    bool write;
-    bool ready;
-  } mem_req_t;
-
   std::unordered_map<int, std::stringstream> print_bufs_;
 
-  std::list<mem_req_t*> pending_mem_reqs_[PLATFORM_MEMORY_NUM_BANKS];
-
-  std::queue<mem_req_t*> dram_queue_[PLATFORM_MEMORY_NUM_BANKS];
-
   std::array<bool, PLATFORM_MEMORY_NUM_BANKS> mem_rd_rsp_ready_;
 
   DramSim dram_sim_;
 
+  MemShim mem_shim_;
+
   Vrtlsim_shim* device_;
 
   RAM* ram_;
 
+  PerfStream* perf_stream_;
+  uint64_t perf_cycles_;
+  uint64_t perf_mem_reads_;
+  uint64_t perf_mem_writes_;
+  uint64_t perf_mem_latency_;
+  uint64_t perf_mem_pending_reads_;
+
 #ifdef VCD_OUTPUT
-  VerilatedVcdC *tfp_;
+  WaveTrace::trace_file_t *tfp_;
 #endif
 };
 
@@ -424,10 +429,14 @@ void Processor::attach_ram(RAM* mem) {
   impl_->attach_ram(mem);
 }
 
-void Processor::run() {
-  impl_->run();
+int Processor::run() {
+  return impl_->run();
 }
 
 void Processor::dcr_write(uint32_t addr, uint32_t value) {
   return impl_->dcr_write(addr, value);
+}
+
+void Processor::attach_perf_stream(PerfStream* stream) {
+  impl_->attach_perf_stream(stream);
 }
\ No newline at end of file
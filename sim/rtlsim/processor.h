@@ -14,6 +14,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <perf_stream.h>
 
 namespace vortex {
 
@@ -27,10 +28,12 @@ public:
 
   void attach_ram(RAM* ram);
 
-  void run();
+  int run();
 
   void dcr_write(uint32_t addr, uint32_t value);
 
+  void attach_perf_stream(PerfStream* stream);
+
 private:
 
   class Impl;
@@ -0,0 +1,167 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "wave_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sstream>
+
+using namespace vortex;
+
+// files of the history ring, each covering a quarter of the depth,
+// plus the one being written
+static const uint32_t HISTORY_FILES = 5;
+
+#ifdef FST_OUTPUT
+static const char* TRACE_EXT = ".fst";
+#else
+static const char* TRACE_EXT = ".vcd";
+#endif
+
+static uint64_t env_cycles(const char* name, uint64_t default_value) {
+  auto value_s = getenv(name);
+  if (value_s == nullptr)
+    return default_value;
+  return strtoull(value_s, nullptr, 0);
+}
+
+WaveTrace::WaveTrace()
+  : start_(0)
+  , stop_(-1ull)
+  , length_(env_cycles("VORTEX_TRACE_LENGTH", -1ull))
+  , depth_(env_cycles("VORTEX_TRACE_DEPTH", 0))
+  , timeout_(env_cycles("VORTEX_TRACE_TIMEOUT", -1ull))
+  , end_(-1ull)
+  , segment_start_(0)
+  , window_(false)
+  , triggered_(false)
+  , stopped_(false)
+#ifdef VCD_OUTPUT
+  , tfp_(nullptr)
+  , is_open_(false)
+#endif
+{
+  auto window_s = getenv("VORTEX_TRACE_WINDOW");
+  if (window_s) {
+    char* end;
+    start_ = strtoull(window_s, &end, 0);
+    if (*end == ':') {
+      stop_ = strtoull(end + 1, nullptr, 0);
+    }
+  } else if (getenv("VORTEX_TRACE_PC")) {
+    // wait for the trigger
+    start_ = -1ull;
+  }
+
+  auto scope_s = getenv("VORTEX_TRACE_SCOPE");
+  if (scope_s) {
+    std::stringstream ss(scope_s);
+    std::string scope;
+    while (std::getline(ss, scope, ',')) {
+      if (!scope.empty()) {
+        scopes_.push_back(scope);
+      }
+    }
+  }
+}
+
+WaveTrace::~WaveTrace() {
+  this->flush();
+}
+
+#ifdef VCD_OUTPUT
+
+void WaveTrace::attach(trace_file_t* tfp) {
+  tfp_ = tfp;
+  for (auto& scope : scopes_) {
+    tfp_->dumpvars(0, scope);
+  }
+}
+
+void WaveTrace::open_file(uint64_t cycle) {
+  if (is_open_) {
+    tfp_->close();
+  }
+  auto filename = "trace_" + std::to_string(cycle) + TRACE_EXT;
+  tfp_->open(filename.c_str());
+  is_open_ = true;
+  files_.push_back(filename);
+  segment_start_ = cycle;
+}
+
+#endif
+
+void WaveTrace::dump(uint64_t timestamp) {
+  uint64_t cycle = timestamp / 2;
+
+  // capture window
+  if (!window_) {
+    if (triggered_ || (cycle >= start_ && cycle < stop_)) {
+      if (triggered_) {
+        end_ = (length_ != -1ull) ? (cycle + length_) : -1ull;
+      } else {
+        end_ = stop_;
+      }
+      // the fixed window only opens once
+      start_ = -1ull;
+      triggered_ = false;
+      stopped_ = false;
+      window_ = true;
+    }
+  } else if (stopped_ || cycle >= end_) {
+    stopped_ = false;
+    window_ = false;
+    this->flush();
+  }
+
+#ifdef VCD_OUTPUT
+  if (tfp_ == nullptr)
+    return;
+  if (window_) {
+    // the window continues the current history file
+    if (!is_open_) {
+      this->open_file(cycle);
+    }
+  } else if (depth_ != 0) {
+    // advance the history ring
+    uint64_t segment_size = (depth_ + 3) / 4;
+    if (!is_open_ || cycle >= segment_start_ + segment_size) {
+      this->open_file(cycle);
+      while (files_.size() > HISTORY_FILES) {
+        remove(files_.front().c_str());
+        files_.pop_front();
+      }
+    }
+  }
+  if (is_open_) {
+    tfp_->dump(timestamp);
+  }
+#endif
+}
+
+void WaveTrace::flush() {
+#ifdef VCD_OUTPUT
+  if (is_open_) {
+    tfp_->close();
+    is_open_ = false;
+  }
+#endif
+  if (files_.empty())
+    return;
+  printf("waveform:");
+  for (auto& filename : files_) {
+    printf(" %s", filename.c_str());
+  }
+  printf("\n");
+  files_.clear();
+}
@@ -0,0 +1,113 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <deque>
+#include <string>
+#include <vector>
+
+#ifdef VCD_OUTPUT
+#ifdef FST_OUTPUT
+#include <verilated_fst_c.h>
+#else
+#include <verilated_vcd_c.h>
+#endif
+#endif
+
+namespace vortex {
+
+// Windowed waveform capture.
+// Tracing (waveform and DPI text traces) is enabled inside a capture window,
+// which opens at a fixed cycle or when triggered (dpi_trace_start, or the
+// commit of the PC given by VORTEX_TRACE_PC), so the model runs untraced
+// until then.
+// With a history depth, the waveform is also written before the window into a
+// ring of files each covering a quarter of the depth, the oldest being deleted
+// as the ring advances; the cycles leading to the trigger, an assertion or a
+// timeout are then kept on disk.
+// Files are named trace_<cycle>.fst (or .vcd), <cycle> being their first cycle.
+// The capture is configured from the environment (cycles):
+//   VORTEX_TRACE_WINDOW=<start>[:<stop>]  fixed capture window, default the whole run
+//   VORTEX_TRACE_LENGTH=<cycles>         length of a triggered window, default until stopped
+//   VORTEX_TRACE_DEPTH=<cycles>          history kept before the window, default none
+//   VORTEX_TRACE_SCOPE=<hier>[,<hier>]   only dump the signals under these scopes
+//   VORTEX_TRACE_TIMEOUT=<cycles>        stop the run after <cycles>
+class WaveTrace {
+public:
+#ifdef VCD_OUTPUT
+#ifdef FST_OUTPUT
+  typedef VerilatedFstC trace_file_t;
+#else
+  typedef VerilatedVcdC trace_file_t;
+#endif
+#endif
+
+  WaveTrace();
+  ~WaveTrace();
+
+#ifdef VCD_OUTPUT
+  // bind the model trace file, before the first dump
+  void attach(trace_file_t* tfp);
+#endif
+
+  // true while the capture window is open, safe from any Verilator thread
+  bool active() const {
+    return window_;
+  }
+
+  // open the capture window at the next dump
+  void trigger() {
+    triggered_ = true;
+  }
+
+  // close the capture window at the next dump
+  void stop() {
+    stopped_ = true;
+  }
+
+  // advance to <timestamp>, dumping the model state if captured
+  void dump(uint64_t timestamp);
+
+  // close the current waveform file and report the captured files
+  void flush();
+
+  bool timeout(uint64_t cycles) const {
+    return cycles >= timeout_;
+  }
+
+private:
+
+  void open_file(uint64_t cycle);
+
+  uint64_t start_;
+  uint64_t stop_;
+  uint64_t length_;
+  uint64_t depth_;
+  uint64_t timeout_;
+  uint64_t end_;
+  uint64_t segment_start_;
+  std::atomic<bool> window_;
+  std::atomic<bool> triggered_;
+  std::atomic<bool> stopped_;
+  std::vector<std::string> scopes_;
+  std::deque<std::string> files_;
+#ifdef VCD_OUTPUT
+  trace_file_t* tfp_;
+  bool is_open_;
+#endif
+};
+
+}
@@ -87,6 +87,29 @@ public:
 
 	void tick() {}
 
+	void save(CheckpointWriter& writer) const {
+		for (auto& cache : caches_) {
+			cache->save(writer);
+		}
+	}
+
+	void load(CheckpointReader& reader) {
+		for (auto& cache : caches_) {
+			cache->load(reader);
+		}
+	}
+
+	// functional access from input <input_id>, the arbiter assignment is approximated
+	bool warm(uint32_t input_id, uint64_t addr, bool write) {
+		return caches_.at(input_id % caches_.size())->warm(addr, write);
+	}
+
+	void show_stats() const {
+		for (auto& cache : caches_) {
+			cache->show_stats();
+		}
+	}
+
 	CacheSim::PerfStats perf_stats() const {
 		CacheSim::PerfStats perf;
 		for (auto cache : caches_) {
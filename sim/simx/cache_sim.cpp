@@ -14,14 +14,47 @@
 #include "cache_sim.h"
 #include "debug.h"
 #include "types.h"
+#include "timeline.h"
+#include "mem_checker.h"
 #include <util.h>
 #include <unordered_map>
 #include <vector>
 #include <list>
 #include <queue>
+#include <algorithm>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
 
 using namespace vortex;
 
+// number of contended atomic lines reported per cache
+#define MAX_AMO_HOTSPOTS 4
+
+// cache state at the start of a run,
+// the first run after construction always pays the initial flush
+enum class ResetMode {
+	Clear,   // invalidate the lines in zero cycles
+	Flush,   // invalidate the lines, one per cycle as the hardware does
+	Preserve // keep the tags of the previous run
+};
+
+// configured from the environment with VORTEX_CACHE_RESET=clear|flush|preserve
+static ResetMode get_reset_mode() {
+	static ResetMode mode = []() {
+		auto value = getenv("VORTEX_CACHE_RESET");
+		if (value == nullptr || 0 == strcmp(value, "clear"))
+			return ResetMode::Clear;
+		if (0 == strcmp(value, "flush"))
+			return ResetMode::Flush;
+		if (0 == strcmp(value, "preserve"))
+			return ResetMode::Preserve;
+		std::cout << "error: invalid VORTEX_CACHE_RESET value: " << value << std::endl;
+		std::abort();
+	}();
+	return mode;
+}
+
 struct params_t {
 	uint32_t sets_per_bank;
 	uint32_t lines_per_set;
@@ -109,6 +142,7 @@ struct line_t {
 	uint32_t lru_ctr;
 	bool     valid;
 	bool     dirty;
+	MemBlock::Ptr data; // cache data mode only
 
 	void clear() {
 		valid = false;
@@ -134,6 +168,7 @@ struct bank_req_port_t {
 	uint32_t req_id;
 	uint64_t req_tag;
 	bool     valid;
+	MemBlock::Ptr data;
 
 	void clear() {
 		valid = false;
@@ -156,9 +191,12 @@ struct bank_req_t {
 	uint64_t uuid;
 	ReqType  type;
 	bool     write;
+	bool     atomic;
+	MemBlock::Ptr data; // fill data
 
 	bank_req_t(uint32_t num_ports)
 		: ports(num_ports)
+		, atomic(false)
 	{}
 
 	void clear() {
@@ -171,6 +209,7 @@ struct bank_req_t {
 
 inline std::ostream &operator<<(std::ostream &os, const bank_req_t& req) {
   os << "set=" << req.set_id << ", rw=" << req.write;
+  if (req.atomic) os << ", amo";
   os << std::dec << ", type=" << req.type;
   os << ", tag=0x" << std::hex << req.tag;
 	os << ", req_tags={";
@@ -281,6 +320,7 @@ public:
 struct bank_t {
 	std::vector<set_t> sets;
 	MSHR               mshr;
+	std::unordered_map<uint64_t, uint64_t> amo_locks; // line address -> release cycle
 
 	bank_t(const CacheSim::Config& config,
 				 const params_t& params)
@@ -293,6 +333,7 @@ struct bank_t {
 			set.clear();
 		}
 		mshr.clear();
+		amo_locks.clear();
 	}
 };
 
@@ -314,6 +355,10 @@ private:
 	uint64_t pending_read_reqs_;
 	uint64_t pending_write_reqs_;
 	uint64_t pending_fill_reqs_;
+	uint16_t timeline_track_;
+	std::unordered_map<uint64_t, uint64_t> amo_contention_; // line address -> stall cycles
+	bool data_mode_;
+	ResetMode reset_mode_;
 
 public:
 	Impl(CacheSim* simobject, const Config& config)
@@ -325,9 +370,16 @@ public:
 		, mem_req_ports_((1 << config.B), simobject)
 		, mem_rsp_ports_((1 << config.B), simobject)
 		, pipeline_reqs_((1 << config.B), config.ports_per_bank)
+		, data_mode_(MemChecker::instance().enabled())
+		, reset_mode_(get_reset_mode())
 	{
 		char sname[100];
 
+		if (data_mode_ && !config_.bypass && (1 << config_.L) != MEM_BLOCK_SIZE) {
+			printf("error: %s: cache data mode requires a %d-byte line size\n", simobject->name().c_str(), MEM_BLOCK_SIZE);
+			exit(-1);
+		}
+
 		if (config_.bypass) {
 			snprintf(sname, 100, "%s-bypass-arb", simobject->name().c_str());
 			auto bypass_arb = MemArbiter::Create(sname, ArbiterType::RoundRobin, config_.num_inputs, config_.mem_ports);
@@ -368,17 +420,54 @@ public:
 			nc_arbs_.at(i)->RspIn.at(0).bind(&bank_mem_arb->RspOut.at(i));
 		}
 
+		// register the cache on the timeline
+		timeline_track_ = Timeline::instance().add_track(simobject->name());
+
 		// calculate cache initialization cycles
 		init_cycles_ = params_.sets_per_bank * params_.lines_per_set;
 	}
 
+	~Impl() {}
+
+	void show_stats() const {
+		if (perf_stats_.amos == 0)
+			return;
+		auto prefix = "PERF: " + simobject_->name() + ": ";
+		std::cout << prefix << "amos=" << perf_stats_.amos
+		          << ", amo stalls=" << perf_stats_.amo_stalls << std::endl;
+		// report the most contended atomic lines
+		std::vector<std::pair<uint64_t, uint64_t>> lines(amo_contention_.begin(), amo_contention_.end());
+		std::sort(lines.begin(), lines.end(), [](const auto& a, const auto& b) {
+			return a.second > b.second;
+		});
+		for (uint32_t i = 0, n = std::min<uint32_t>(lines.size(), MAX_AMO_HOTSPOTS); i < n; ++i) {
+			std::cout << prefix << "amo contention line=0x" << std::hex << lines.at(i).first
+			          << std::dec << ", stalls=" << lines.at(i).second << std::endl;
+		}
+	}
+
   void reset() {
 		if (config_.bypass)
 			return;
 
 		for (auto& bank : banks_) {
-			bank.clear();
+			if (reset_mode_ == ResetMode::Preserve) {
+				bank.mshr.clear();
+				bank.amo_locks.clear();
+				// the host may have updated memory since the last run
+				for (auto& set : bank.sets) {
+					for (auto& line : set.lines) {
+						line.data = nullptr;
+					}
+				}
+			} else {
+				bank.clear();
+			}
+		}
+		if (reset_mode_ == ResetMode::Flush) {
+			init_cycles_ = params_.sets_per_bank * params_.lines_per_set;
 		}
+		amo_contention_.clear();
 		perf_stats_ = PerfStats();
 		pending_read_reqs_  = 0;
 		pending_write_reqs_ = 0;
@@ -433,10 +522,12 @@ public:
 			DT(3, simobject_->name() << "-bank" << bank_id << "-fill-rsp: " << mem_rsp);
 			pipeline_req.type = bank_req_t::Fill;
 			pipeline_req.tag = mem_rsp.tag;
+			pipeline_req.data = mem_rsp.data;
 			mem_rsp_port.pop();
 		}
 
 		// last: schedule core requests (flush core queue)
+		auto cycles = SimPlatform::instance().cycles();
 		for (uint32_t req_id = 0, n = config_.num_inputs; req_id < n; ++req_id) {
 			auto& core_req_port = simobject_->CoreReqPorts.at(req_id);
 			if (core_req_port.empty())
@@ -453,6 +544,14 @@ public:
 				continue;
 			}
 
+			// forward atomics executed further down the hierarchy
+			if (core_req.atomic && !config_.amo_execute) {
+				this->invalidateLine(core_req.addr);
+				this->processBypassRequest(core_req, req_id);
+				core_req_port.pop();
+				continue;
+			}
+
 			auto bank_id = params_.addr_bank_id(core_req.addr);
 			auto& bank = banks_.at(bank_id);
 			auto& pipeline_req = pipeline_reqs_.at(bank_id);
@@ -465,6 +564,20 @@ public:
 			auto tag     = params_.addr_tag(core_req.addr);
 			auto port_id = req_id % config_.ports_per_bank;
 
+			// serialize atomics to the same line
+			if (core_req.atomic) {
+				auto line_addr = params_.mem_addr(bank_id, set_id, tag);
+				auto it = bank.amo_locks.find(line_addr);
+				if (it != bank.amo_locks.end()) {
+					if (it->second > cycles) {
+						++perf_stats_.amo_stalls;
+						++amo_contention_[line_addr];
+						continue;
+					}
+					bank.amo_locks.erase(it);
+				}
+			}
+
 			// check MSHR capacity
 			if ((!core_req.write || config_.write_back)
 		   && bank.mshr.full()) {
@@ -476,6 +589,7 @@ public:
 			if (pipeline_req.type == bank_req_t::Core) {
 				// check port conflict
 				if (pipeline_req.write != core_req.write
+				 || pipeline_req.atomic || core_req.atomic
 				 || pipeline_req.set_id != set_id
 				 || pipeline_req.tag != tag
 				 || pipeline_req.ports.at(port_id).valid) {
@@ -483,18 +597,23 @@ public:
 					continue;
 				}
 				// extend request ports
-				pipeline_req.ports.at(port_id) = bank_req_port_t{req_id, core_req.tag, true};
+				pipeline_req.ports.at(port_id) = bank_req_port_t{req_id, core_req.tag, true, core_req.data};
 			} else {
 				// schedule new request
 				bank_req_t bank_req(config_.ports_per_bank);
-				bank_req.ports.at(port_id) = bank_req_port_t{req_id, core_req.tag, true};
+				bank_req.ports.at(port_id) = bank_req_port_t{req_id, core_req.tag, true, core_req.data};
 				bank_req.tag   = tag;
 				bank_req.set_id = set_id;
 				bank_req.cid   = core_req.cid;
 				bank_req.uuid  = core_req.uuid;
 				bank_req.type  = bank_req_t::Core;
 				bank_req.write = core_req.write;
+				bank_req.atomic = core_req.atomic;
 				pipeline_req   = bank_req;
+				if (core_req.atomic) {
+					// lock the line until the atomic executes
+					bank.amo_locks[params_.mem_addr(bank_id, set_id, tag)] = UINT64_MAX;
+				}
 				DT(3, simobject_->name() << "-core-req: " << core_req);
 			}
 
@@ -502,6 +621,8 @@ public:
 				++perf_stats_.writes;
 			else
 				++perf_stats_.reads;
+			if (core_req.atomic)
+				++perf_stats_.amos;
 
 			// remove request
 			auto time = core_req_port.pop();
@@ -516,12 +637,136 @@ public:
 		return perf_stats_;
 	}
 
+	void save(CheckpointWriter& writer) const {
+		writer.section("CACH");
+		uint32_t num_banks = config_.bypass ? 0 : banks_.size();
+		writer.write(num_banks);
+		writer.write(params_.sets_per_bank);
+		writer.write(params_.lines_per_set);
+		for (uint32_t b = 0; b < num_banks; ++b) {
+			for (auto& set : banks_.at(b).sets) {
+				for (auto& line : set.lines) {
+					writer.write(line.tag);
+					writer.write(line.lru_ctr);
+					writer.write(line.valid);
+					writer.write(line.dirty);
+					writer.write<bool>(line.data != nullptr);
+					if (line.data) {
+						writer.write(*line.data);
+					}
+				}
+			}
+		}
+	}
+
+	void load(CheckpointReader& reader) {
+		if (!reader.section("CACH"))
+			return;
+		uint32_t num_banks = 0, sets_per_bank = 0, lines_per_set = 0;
+		reader.read(&num_banks);
+		reader.read(&sets_per_bank);
+		reader.read(&lines_per_set);
+		// a cache with another geometry restarts cold
+		bool restore = !config_.bypass
+		            && num_banks == banks_.size()
+		            && sets_per_bank == params_.sets_per_bank
+		            && lines_per_set == params_.lines_per_set;
+		if (!restore && num_banks != 0) {
+			std::cout << "warning: " << simobject_->name() << ": cache geometry changed, starting cold" << std::endl;
+		}
+		uint64_t num_lines = uint64_t(num_banks) * sets_per_bank * lines_per_set;
+		for (uint64_t i = 0; i < num_lines && !reader.failed(); ++i) {
+			line_t line;
+			bool has_data = false;
+			reader.read(&line.tag);
+			reader.read(&line.lru_ctr);
+			reader.read(&line.valid);
+			reader.read(&line.dirty);
+			reader.read(&has_data);
+			if (has_data) {
+				line.data = std::make_shared<MemBlock>();
+				reader.read(line.data.get());
+			}
+			if (!restore)
+				continue;
+			uint32_t way = i % lines_per_set;
+			uint32_t set = (i / lines_per_set) % sets_per_bank;
+			uint32_t bank = i / (uint64_t(lines_per_set) * sets_per_bank);
+			banks_.at(bank).sets.at(set).lines.at(way) = line;
+		}
+		if (restore) {
+			// the tags are valid, skip the initialization flush
+			init_cycles_ = 0;
+		}
+	}
+
+	// functional access updating the tags and replacement state only,
+	// returns true if the access reaches the next level
+	bool warm(uint64_t addr, bool write) {
+		if (config_.bypass)
+			return true;
+
+		// preloaded tags are valid, skip the initialization flush
+		init_cycles_ = 0;
+
+		auto bank_id = params_.addr_bank_id(addr);
+		auto set_id  = params_.addr_set_id(addr);
+		auto tag     = params_.addr_tag(addr);
+		auto& set = banks_.at(bank_id).sets.at(set_id);
+
+		int32_t hit_line_id  = -1;
+		int32_t free_line_id = -1;
+		int32_t repl_line_id = 0;
+		uint32_t max_cnt = 0;
+
+		// tag lookup
+		for (uint32_t i = 0, n = set.lines.size(); i < n; ++i) {
+			auto& line = set.lines.at(i);
+			if (max_cnt < line.lru_ctr) {
+				max_cnt = line.lru_ctr;
+				repl_line_id = i;
+			}
+			if (line.valid) {
+				if (line.tag == tag) {
+					hit_line_id = i;
+					line.lru_ctr = 0;
+				} else {
+					++line.lru_ctr;
+				}
+			} else {
+				free_line_id = i;
+			}
+		}
+
+		if (hit_line_id != -1) {
+			if (write && config_.write_back) {
+				set.lines.at(hit_line_id).dirty = true;
+				return false;
+			}
+			return write;
+		}
+
+		// write-through caches do not allocate on writes
+		if (write && !config_.write_back)
+			return true;
+
+		// allocate the line, dropping any victim data
+		auto& line = set.lines.at((free_line_id != -1) ? free_line_id : repl_line_id);
+		line.valid   = true;
+		line.tag     = tag;
+		line.lru_ctr = 0;
+		line.dirty   = write;
+		line.data    = nullptr;
+		return true;
+	}
+
 private:
 
 	void processBypassResponse(const MemRsp& mem_rsp) {
 		uint32_t req_id = mem_rsp.tag & ((1 << params_.log2_num_inputs)-1);
 		uint64_t tag = mem_rsp.tag >> params_.log2_num_inputs;
 		MemRsp core_rsp{tag, mem_rsp.cid, mem_rsp.uuid};
+		core_rsp.data = mem_rsp.data;
 		simobject_->CoreRspPorts.at(req_id).push(core_rsp, config_.latency);
 		DT(3, simobject_->name() << "-bypass-core-rsp: " << core_rsp);
 	}
@@ -542,6 +787,106 @@ private:
 		}
 	}
 
+	// execute an atomic read-modify-write on a resident line,
+	// the line stays locked for the duration of the ALU operation
+	void processAtomic(uint32_t bank_id, const bank_req_t& bank_req, line_t* line) {
+		if (line) {
+			this->updateLine(*line, bank_req);
+		}
+		if (config_.write_back) {
+			if (line) {
+				line->dirty = true;
+			}
+		} else {
+			MemReq mem_req;
+			mem_req.addr  = params_.mem_addr(bank_id, bank_req.set_id, bank_req.tag);
+			mem_req.write = true;
+			mem_req.cid   = bank_req.cid;
+			mem_req.uuid  = bank_req.uuid;
+			mem_req.data  = this->writeData(bank_req);
+			mem_req_ports_.at(bank_id).push(mem_req, 1);
+			DT(3, simobject_->name() << "-bank" << bank_id << "-amo-writethrough: " << mem_req);
+		}
+		auto line_addr = params_.mem_addr(bank_id, bank_req.set_id, bank_req.tag);
+		banks_.at(bank_id).amo_locks[line_addr] = SimPlatform::instance().cycles() + config_.amo_latency;
+	}
+
+	// drop the local copy of a line updated by a lower level atomic
+	void invalidateLine(uint64_t addr) {
+		auto bank_id = params_.addr_bank_id(addr);
+		auto set_id  = params_.addr_set_id(addr);
+		auto tag     = params_.addr_tag(addr);
+		auto& set = banks_.at(bank_id).sets.at(set_id);
+		for (auto& line : set.lines) {
+			if (!line.valid || line.tag != tag)
+				continue;
+			if (line.dirty) {
+				MemReq mem_req;
+				mem_req.addr  = params_.mem_addr(bank_id, set_id, tag);
+				mem_req.write = true;
+				mem_req.data  = this->lineData(line);
+				mem_req_ports_.at(bank_id).push(mem_req, 1);
+				DT(3, simobject_->name() << "-bank" << bank_id << "-writeback: " << mem_req);
+				++perf_stats_.evictions;
+			}
+			line.clear();
+		}
+	}
+
+	// cache data mode: copy of the line data
+	MemBlock::Ptr lineData(const line_t& line) const {
+		if (!line.data)
+			return nullptr;
+		return std::make_shared<MemBlock>(*line.data);
+	}
+
+	// cache data mode: merged write data of the request ports,
+	// nullptr if a port write is untracked
+	MemBlock::Ptr writeData(const bank_req_t& bank_req) const {
+		if (!data_mode_)
+			return nullptr;
+		MemBlock::Ptr data;
+		for (auto& port : bank_req.ports) {
+			if (!port.valid)
+				continue;
+			if (!port.data)
+				return nullptr;
+			if (!data) {
+				data = std::make_shared<MemBlock>(*port.data);
+			} else {
+				data->merge(*port.data);
+			}
+		}
+		return data;
+	}
+
+	// cache data mode: apply the write data of the request ports to a resident line
+	void updateLine(line_t& line, const bank_req_t& bank_req) {
+		if (!line.data)
+			return;
+		for (auto& port : bank_req.ports) {
+			if (!port.valid)
+				continue;
+			if (port.data) {
+				line.data->merge(*port.data);
+			} else {
+				line.data->mask.reset();
+			}
+		}
+	}
+
+	// cache data mode: check a load against the line data,
+	// returns the line data for untracked reads (e.g. fills from an upper level)
+	MemBlock::Ptr readLine(const line_t* line, const bank_req_port_t& port, uint32_t bank_id) const {
+		if (line == nullptr || !line->data)
+			return nullptr;
+		if (port.data) {
+			MemChecker::instance().check(*port.data, *line->data, simobject_->name() + "-bank" + std::to_string(bank_id));
+			return nullptr;
+		}
+		return this->lineData(*line);
+	}
+
 	void processBankRequests() {
 		for (uint32_t bank_id = 0, n = (1 << config_.B); bank_id < n; ++bank_id) {
 			auto& bank = banks_.at(bank_id);
@@ -558,16 +903,44 @@ private:
 				auto& line  = set.lines.at(entry.line_id);
 				line.valid  = true;
 				line.tag    = entry.bank_req.tag;
+				if (data_mode_) {
+					line.data = pipeline_req.data ? pipeline_req.data : std::make_shared<MemBlock>();
+				}
 				--pending_fill_reqs_;
+				auto& timeline = Timeline::instance();
+				if (timeline.active()) {
+					auto addr = params_.mem_addr(bank_id, entry.bank_req.set_id, entry.bank_req.tag);
+					timeline.record(Timeline::MissEnd, timeline_track_, bank_id, addr, 0, pipeline_req.tag);
+				}
 			} break;
 			case bank_req_t::Replay: {
+				uint32_t rsp_latency = config_.latency;
+				line_t* replay_line = nullptr;
+				for (auto& line : bank.sets.at(pipeline_req.set_id).lines) {
+					if (line.valid && line.tag == pipeline_req.tag) {
+						replay_line = &line;
+						break;
+					}
+				}
+				if (pipeline_req.atomic) {
+					this->processAtomic(bank_id, pipeline_req, replay_line);
+					rsp_latency += config_.amo_latency;
+				} else
+				if (pipeline_req.write && replay_line) {
+					// write-allocate, the line now holds data not yet in memory
+					replay_line->dirty = true;
+					this->updateLine(*replay_line, pipeline_req);
+				}
 				// send core response
 				if (!pipeline_req.write || config_.write_reponse) {
 					for (auto& info : pipeline_req.ports) {
 						if (!info.valid)
 							continue;
 						MemRsp core_rsp{info.req_tag, pipeline_req.cid, pipeline_req.uuid};
-						simobject_->CoreRspPorts.at(info.req_id).push(core_rsp, config_.latency);
+						if (!pipeline_req.write && !pipeline_req.atomic) {
+							core_rsp.data = this->readLine(replay_line, info, bank_id);
+						}
+						simobject_->CoreRspPorts.at(info.req_id).push(core_rsp, rsp_latency);
 						DT(3, simobject_->name() << "-bank" << bank_id << "-replay: " << core_rsp);
 					}
 				}
@@ -601,9 +974,15 @@ private:
 
 				if (hit_line_id != -1) {
 					// Hit handling
+					uint32_t rsp_latency = config_.latency;
+					if (pipeline_req.atomic) {
+						this->processAtomic(bank_id, pipeline_req, &set.lines.at(hit_line_id));
+						rsp_latency += config_.amo_latency;
+					} else
 					if (pipeline_req.write) {
 						// handle write has_hit
 						auto& hit_line = set.lines.at(hit_line_id);
+						this->updateLine(hit_line, pipeline_req);
 						if (!config_.write_back) {
 							// forward write request to memory
 							MemReq mem_req;
@@ -611,6 +990,7 @@ private:
 							mem_req.write = true;
 							mem_req.cid   = pipeline_req.cid;
 							mem_req.uuid  = pipeline_req.uuid;
+							mem_req.data  = this->writeData(pipeline_req);
 							mem_req_ports_.at(bank_id).push(mem_req, 1);
 							DT(3, simobject_->name() << "-bank" << bank_id << "-writethrough: " << mem_req);
 						} else {
@@ -624,7 +1004,10 @@ private:
 							if (!info.valid)
 								continue;
 							MemRsp core_rsp{info.req_tag, pipeline_req.cid, pipeline_req.uuid};
-							simobject_->CoreRspPorts.at(info.req_id).push(core_rsp, config_.latency);
+							if (!pipeline_req.write && !pipeline_req.atomic) {
+								core_rsp.data = this->readLine(&set.lines.at(hit_line_id), info, bank_id);
+							}
+							simobject_->CoreRspPorts.at(info.req_id).push(core_rsp, rsp_latency);
 							DT(3, simobject_->name() << "-bank" << bank_id << "-core-rsp: " << core_rsp);
 						}
 					}
@@ -643,6 +1026,7 @@ private:
 							mem_req.addr  = params_.mem_addr(bank_id, pipeline_req.set_id, repl_line.tag);
 							mem_req.write = true;
 							mem_req.cid   = pipeline_req.cid;
+							mem_req.data  = this->lineData(repl_line);
 							mem_req_ports_.at(bank_id).push(mem_req, 1);
 							DT(3, simobject_->name() << "-bank" << bank_id << "-writeback: " << mem_req);
 							++perf_stats_.evictions;
@@ -657,6 +1041,7 @@ private:
 							mem_req.write = true;
 							mem_req.cid   = pipeline_req.cid;
 							mem_req.uuid  = pipeline_req.uuid;
+							mem_req.data  = this->writeData(pipeline_req);
 							mem_req_ports_.at(bank_id).push(mem_req, 1);
 							DT(3, simobject_->name() << "-bank" << bank_id << "-writethrough: " << mem_req);
 						}
@@ -689,6 +1074,10 @@ private:
 							mem_req_ports_.at(bank_id).push(mem_req, 1);
 							DT(3, simobject_->name() << "-bank" << bank_id << "-fill: " << mem_req);
 							++pending_fill_reqs_;
+							auto& timeline = Timeline::instance();
+							if (timeline.active()) {
+								timeline.record(Timeline::MissBegin, timeline_track_, bank_id, mem_req.addr, 0, mshr_id);
+							}
 						}
 					}
 				}
@@ -723,6 +1112,22 @@ void CacheSim::tick() {
   impl_->tick();
 }
 
+void CacheSim::show_stats() const {
+  impl_->show_stats();
+}
+
 const CacheSim::PerfStats& CacheSim::perf_stats() const {
   return impl_->perf_stats();
+}
+
+void CacheSim::save(CheckpointWriter& writer) const {
+  impl_->save(writer);
+}
+
+void CacheSim::load(CheckpointReader& reader) {
+  impl_->load(reader);
+}
+
+bool CacheSim::warm(uint64_t addr, bool write) {
+  return impl_->warm(addr, write);
 }
\ No newline at end of file
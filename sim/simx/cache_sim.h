@@ -15,6 +15,7 @@
 
 #include <simobject.h>
 #include "mem_sim.h"
+#include "checkpoint.h"
 
 namespace vortex {
 
@@ -35,6 +36,8 @@ public:
 		bool    write_reponse;  // enable write response
 		uint16_t mshr_size;     // MSHR buffer size
 		uint8_t latency;        // pipeline latency
+		bool    amo_execute;    // execute atomics in the cache banks
+		uint8_t amo_latency;    // atomic ALU latency
 	};
 
 	struct PerfStats {
@@ -47,6 +50,8 @@ public:
 		uint64_t bank_stalls;
 		uint64_t mshr_stalls;
 		uint64_t mem_latency;
+		uint64_t amos;
+		uint64_t amo_stalls;
 
 		PerfStats()
 			: reads(0)
@@ -58,6 +63,8 @@ public:
 			, bank_stalls(0)
 			, mshr_stalls(0)
 			, mem_latency(0)
+			, amos(0)
+			, amo_stalls(0)
 		{}
 
 		PerfStats& operator+=(const PerfStats& rhs) {
@@ -70,6 +77,8 @@ public:
 			this->bank_stalls += rhs.bank_stalls;
 			this->mshr_stalls += rhs.mshr_stalls;
 			this->mem_latency += rhs.mem_latency;
+			this->amos += rhs.amos;
+			this->amo_stalls += rhs.amo_stalls;
 			return *this;
 		}
 	};
@@ -88,6 +97,18 @@ public:
 
 	const PerfStats& perf_stats() const;
 
+	// print the atomics statistics
+	void show_stats() const;
+
+	// tag state, the cache must be idle
+	void save(CheckpointWriter& writer) const;
+
+	void load(CheckpointReader& reader);
+
+	// functional access updating the tags only,
+	// returns true if the access reaches the next level
+	bool warm(uint64_t addr, bool write);
+
 private:
 	class Impl;
 	Impl* impl_;
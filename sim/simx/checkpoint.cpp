@@ -0,0 +1,268 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "checkpoint.h"
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <VX_config.h>
+#include "arch.h"
+
+using namespace vortex;
+
+static const uint32_t VERSION = 1;
+
+// granularity of the memory images deduplication
+static const uint32_t PAGE_SIZE = 4096;
+
+static const uint64_t IMAGE_END = ~0ull;
+
+static const uint32_t ZERO_PAGE = ~0u;
+
+namespace {
+
+struct header_t {
+  char     magic[4];
+  uint32_t version;
+  uint32_t xlen;
+  uint32_t num_threads;
+  uint32_t num_warps;
+  uint32_t num_cores;
+  uint32_t num_clusters;
+  uint32_t reserved;
+  uint64_t cycle;
+};
+
+struct page_ref_t {
+  uint64_t addr;
+  uint32_t id;    // a new page is stored after its first reference
+  uint32_t reserved;
+};
+
+uint64_t page_hash(const uint8_t* data) {
+  // FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (uint32_t i = 0; i < PAGE_SIZE; ++i) {
+    hash = (hash ^ data[i]) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+bool is_zero_page(const uint8_t* data) {
+  static const uint8_t zero_page[PAGE_SIZE] = {};
+  return (0 == memcmp(data, zero_page, PAGE_SIZE));
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+CheckpointWriter::CheckpointWriter()
+  : file_(nullptr)
+  , failed_(false)
+  , image_pages_(0)
+{}
+
+CheckpointWriter::~CheckpointWriter() {
+  if (file_) {
+    fclose(file_);
+  }
+}
+
+int CheckpointWriter::open(const char* path, const Arch& arch, uint64_t cycle) {
+  file_ = fopen(path, "wb");
+  if (file_ == nullptr) {
+    printf("error: cannot create checkpoint: %s\n", path);
+    return -1;
+  }
+  header_t header = {{'V', 'X', 'C', 'P'}, VERSION, XLEN,
+                     arch.num_threads(), arch.num_warps(), arch.num_cores(), arch.num_clusters(), 0,
+                     cycle};
+  this->write(header);
+  return 0;
+}
+
+int CheckpointWriter::close() {
+  if (file_ == nullptr)
+    return -1;
+  this->section("END");
+  if (fclose(file_) != 0) {
+    failed_ = true;
+  }
+  file_ = nullptr;
+  if (failed_) {
+    printf("error: checkpoint write failed\n");
+    return -1;
+  }
+  printf("checkpoint: memory pages=%ld, stored=%ld\n", image_pages_, pages_.size());
+  return 0;
+}
+
+void CheckpointWriter::section(const char* tag) {
+  char value[4] = {};
+  memcpy(value, tag, std::min<size_t>(strlen(tag), sizeof(value)));
+  this->write(value, sizeof(value));
+}
+
+void CheckpointWriter::write(const void* data, uint64_t size) {
+  if (failed_ || size == 0)
+    return;
+  if (fwrite(data, 1, size, file_) != size) {
+    failed_ = true;
+  }
+}
+
+void CheckpointWriter::write_image(uint64_t addr, const void* data, uint64_t size) {
+  auto bytes = reinterpret_cast<const uint8_t*>(data);
+  std::vector<uint8_t> page(PAGE_SIZE);
+  for (uint64_t offset = 0; offset < size; offset += PAGE_SIZE) {
+    auto n = std::min<uint64_t>(PAGE_SIZE, size - offset);
+    std::fill(page.begin() + n, page.end(), 0);
+    memcpy(page.data(), bytes + offset, n);
+    ++image_pages_;
+    page_ref_t ref = {addr + offset, ZERO_PAGE, 0};
+    if (is_zero_page(page.data())) {
+      this->write(ref);
+      continue;
+    }
+    // look for an identical page already stored
+    auto& ids = page_ids_[page_hash(page.data())];
+    bool found = false;
+    for (auto id : ids) {
+      if (pages_.at(id) == page) {
+        ref.id = id;
+        found = true;
+        break;
+      }
+    }
+    if (found) {
+      this->write(ref);
+      continue;
+    }
+    ref.id = pages_.size();
+    ids.push_back(ref.id);
+    this->write(ref);
+    this->write(page.data(), PAGE_SIZE);
+    pages_.push_back(page);
+  }
+}
+
+void CheckpointWriter::end_image() {
+  page_ref_t ref = {IMAGE_END, 0, 0};
+  this->write(ref);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+CheckpointReader::CheckpointReader()
+  : file_(nullptr)
+  , failed_(false)
+  , cycle_(0)
+{}
+
+CheckpointReader::~CheckpointReader() {
+  if (file_) {
+    fclose(file_);
+  }
+}
+
+int CheckpointReader::open(const char* path, const Arch& arch) {
+  file_ = fopen(path, "rb");
+  if (file_ == nullptr) {
+    printf("error: cannot open checkpoint: %s\n", path);
+    return -1;
+  }
+  header_t header;
+  this->read(&header);
+  if (failed_
+   || memcmp(header.magic, "VXCP", 4) != 0
+   || header.version != VERSION) {
+    printf("error: invalid checkpoint: %s\n", path);
+    return -1;
+  }
+  if (header.xlen != XLEN
+   || header.num_threads != arch.num_threads()
+   || header.num_warps != arch.num_warps()
+   || header.num_cores != arch.num_cores()
+   || header.num_clusters != arch.num_clusters()) {
+    printf("error: checkpoint configuration mismatch: xlen=%d, threads=%d, warps=%d, cores=%d, clusters=%d\n",
+      header.xlen, header.num_threads, header.num_warps, header.num_cores, header.num_clusters);
+    return -1;
+  }
+  cycle_ = header.cycle;
+  return 0;
+}
+
+int CheckpointReader::close() {
+  if (file_ == nullptr)
+    return -1;
+  bool valid = this->section("END");
+  fclose(file_);
+  file_ = nullptr;
+  pages_.clear();
+  return valid ? 0 : -1;
+}
+
+bool CheckpointReader::section(const char* tag) {
+  char expected[4] = {};
+  memcpy(expected, tag, std::min<size_t>(strlen(tag), sizeof(expected)));
+  char value[4] = {};
+  this->read(value, sizeof(value));
+  if (failed_)
+    return false;
+  if (memcmp(value, expected, sizeof(value)) != 0) {
+    std::string reason = std::string("missing section ") + tag;
+    this->error(reason.c_str());
+    return false;
+  }
+  return true;
+}
+
+void CheckpointReader::error(const char* reason) {
+  if (failed_)
+    return;
+  printf("error: invalid checkpoint: %s\n", reason);
+  failed_ = true;
+}
+
+void CheckpointReader::read(void* data, uint64_t size) {
+  if (failed_ || size == 0)
+    return;
+  if (fread(data, 1, size, file_) != size) {
+    this->error("truncated file");
+  }
+}
+
+void CheckpointReader::read_image(const std::function<void(uint64_t addr, const uint8_t* data, uint32_t size)>& callback) {
+  for (;;) {
+    page_ref_t ref;
+    this->read(&ref);
+    if (failed_ || ref.addr == IMAGE_END)
+      break;
+    if (ref.id == ZERO_PAGE) {
+      static const uint8_t zero_page[PAGE_SIZE] = {};
+      callback(ref.addr, zero_page, PAGE_SIZE);
+      continue;
+    }
+    if (ref.id == pages_.size()) {
+      pages_.emplace_back(PAGE_SIZE);
+      this->read(pages_.back().data(), PAGE_SIZE);
+      if (failed_)
+        break;
+    } else if (ref.id > pages_.size()) {
+      this->error("bad page reference");
+      break;
+    }
+    callback(ref.addr, pages_.at(ref.id).data(), PAGE_SIZE);
+  }
+}
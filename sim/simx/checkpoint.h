@@ -0,0 +1,130 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace vortex {
+
+class Arch;
+
+// Simulation checkpoints.
+// A checkpoint is taken at a quiescent point: from the requested cycle the
+// cores stop scheduling and the pipelines and memory system drain, so port
+// queues and platform events are empty and need not be saved. The snapshot
+// holds the warp state, barriers, local memories, cache tags, device
+// configuration and memory pages; DRAM timing state restarts idle.
+// Components are saved in a fixed order, each in a tagged section.
+// Memory images are split into pages stored once: zero pages carry no data
+// and identical pages refer to the first copy.
+// A checkpoint can only be restored by a simulator with the same processor
+// configuration; caches whose geometry changed restart cold.
+class CheckpointWriter {
+public:
+  CheckpointWriter();
+  ~CheckpointWriter();
+
+  int open(const char* path, const Arch& arch, uint64_t cycle);
+
+  int close();
+
+  // start the section of a component
+  void section(const char* tag);
+
+  void write(const void* data, uint64_t size);
+
+  template <typename T>
+  void write(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "invalid type");
+    this->write(&value, sizeof(T));
+  }
+
+  template <typename T>
+  void write_vector(const std::vector<T>& values) {
+    this->write<uint64_t>(values.size());
+    this->write(values.data(), values.size() * sizeof(T));
+  }
+
+  // add a memory block to the current image
+  void write_image(uint64_t addr, const void* data, uint64_t size);
+
+  // terminate the current image
+  void end_image();
+
+private:
+  FILE* file_;
+  bool failed_;
+  std::unordered_map<uint64_t, std::vector<uint32_t>> page_ids_; // content hash -> stored pages
+  std::vector<std::vector<uint8_t>> pages_;
+  uint64_t image_pages_;
+};
+
+class CheckpointReader {
+public:
+  CheckpointReader();
+  ~CheckpointReader();
+
+  int open(const char* path, const Arch& arch);
+
+  int close();
+
+  // cycle at which the checkpoint was taken
+  uint64_t cycle() const {
+    return cycle_;
+  }
+
+  // enter the section of a component, false if the checkpoint is out of sync
+  bool section(const char* tag);
+
+  void read(void* data, uint64_t size);
+
+  template <typename T>
+  void read(T* value) {
+    static_assert(std::is_trivially_copyable<T>::value, "invalid type");
+    this->read(value, sizeof(T));
+  }
+
+  template <typename T>
+  void read_vector(std::vector<T>* values) {
+    uint64_t size = 0;
+    this->read(&size);
+    if (failed_)
+      return;
+    values->resize(size);
+    this->read(values->data(), size * sizeof(T));
+  }
+
+  // read the next image, calling <callback> for each of its pages
+  void read_image(const std::function<void(uint64_t addr, const uint8_t* data, uint32_t size)>& callback);
+
+  // report invalid contents, the following reads are ignored
+  void error(const char* reason);
+
+  bool failed() const {
+    return failed_;
+  }
+
+private:
+  FILE* file_;
+  bool failed_;
+  uint64_t cycle_;
+  std::vector<std::vector<uint8_t>> pages_;
+};
+
+}
@@ -12,6 +12,7 @@
 // limitations under the License.
 
 #include "cluster.h"
+#include "processor_impl.h"
 
 using namespace vortex;
 
@@ -58,6 +59,8 @@ Cluster::Cluster(const SimContext& ctx,
     false,                  // write response
     L2_MSHR_SIZE,           // mshr size
     2,                      // pipeline latency
+    (AMO_CACHE_LEVEL <= 2), // execute atomics
+    AMO_LATENCY,            // atomic latency
   });
 
   // connect l2cache core interfaces
@@ -111,6 +114,61 @@ bool Cluster::running() const {
   return false;
 }
 
+void Cluster::drain(bool enable) {
+  for (auto& socket : sockets_) {
+    socket->drain(enable);
+  }
+}
+
+bool Cluster::drained() const {
+  for (auto& socket : sockets_) {
+    if (!socket->drained())
+      return false;
+  }
+  return true;
+}
+
+void Cluster::emulate(bool warm) {
+  for (auto& socket : sockets_) {
+    socket->emulate(warm);
+  }
+}
+
+void Cluster::warm(uint64_t addr, bool write) {
+  if (l2cache_->warm(addr, write)) {
+    processor_->warm(addr, write);
+  }
+}
+
+void Cluster::preload(uint64_t addr, uint32_t level) {
+  if (level == 1) {
+    for (auto& socket : sockets_) {
+      socket->preload(addr);
+    }
+  } else {
+    this->warm(addr, false);
+  }
+}
+
+void Cluster::save(CheckpointWriter& writer) const {
+  writer.section("CLST");
+  writer.write_vector(barriers_);
+  for (auto& socket : sockets_) {
+    socket->save(writer);
+  }
+  l2cache_->save(writer);
+}
+
+void Cluster::load(CheckpointReader& reader) {
+  if (!reader.section("CLST"))
+    return;
+  reader.read_vector(&barriers_);
+  for (auto& socket : sockets_) {
+    socket->load(reader);
+  }
+  l2cache_->load(reader);
+}
+
 int Cluster::get_exitcode() const {
   int exitcode = 0;
   for (auto& socket : sockets_) {
@@ -150,4 +208,19 @@ Cluster::PerfStats Cluster::perf_stats() const {
   PerfStats perf_stats;
   perf_stats.l2cache = l2cache_->perf_stats();
   return perf_stats;
+}
+
+void Cluster::perf_sample(PerfStream::sample_t* sample) const {
+  for (auto& socket : sockets_) {
+    socket->perf_sample(sample);
+  }
+  auto& l2cache_perf = l2cache_->perf_stats();
+  sample->values[PerfStream::L2CACHE_MISSES] += l2cache_perf.read_misses + l2cache_perf.write_misses;
+}
+
+void Cluster::show_stats() const {
+  for (auto& socket : sockets_) {
+    socket->show_stats();
+  }
+  l2cache_->show_stats();
 }
\ No newline at end of file
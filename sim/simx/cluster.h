@@ -67,8 +67,28 @@ public:
 
   void barrier(uint32_t bar_id, uint32_t count, uint32_t core_id);
 
+  void drain(bool enable);
+
+  bool drained() const;
+
+  void emulate(bool warm);
+
+  // functional L2 access
+  void warm(uint64_t addr, bool write);
+
+  // load a line into the caches from <level> (1 or 2) down
+  void preload(uint64_t addr, uint32_t level);
+
+  void save(CheckpointWriter& writer) const;
+
+  void load(CheckpointReader& reader);
+
   PerfStats perf_stats() const;
 
+  void perf_sample(PerfStream::sample_t* sample) const;
+
+  void show_stats() const;
+
 private:
   uint32_t                    cluster_id_;
   ProcessorImpl*              processor_;
@@ -23,6 +23,53 @@
 #define MEM_CLOCK_RATIO   1
 #endif
 
+// Cache level executing atomic memory operations (1: L1, 2: L2, 3: L3, 4: memory).
+// Atomics run in the first enabled cache from that level towards memory,
+// by default in the last shared cache. The L1 caches are not coherent,
+// executing atomics there is only correct within a core.
+#ifndef AMO_CACHE_LEVEL
+#if L3_ENABLED
+#define AMO_CACHE_LEVEL   3
+#elif L2_ENABLED
+#define AMO_CACHE_LEVEL   2
+#else
+#define AMO_CACHE_LEVEL   4
+#endif
+#endif
+
+// Warp scheduling policy (0: priority, 1: GTO, 2: LRR, 3: two-level, 4: cache-aware)
+#ifndef SCHED_POLICY
+#define SCHED_POLICY      0
+#endif
+
+// Cycles between cache feedback updates to the warp scheduler
+#ifndef SCHED_EPOCH
+#define SCHED_EPOCH       1024
+#endif
+
+// Atomic ALU latency, the target line stays locked meanwhile
+#ifndef AMO_LATENCY
+#define AMO_LATENCY       2
+#endif
+
+// Operand collector: register file banks, read ports per bank, collector units per issue slot
+#ifndef OPC_NUM_BANKS
+#define OPC_NUM_BANKS     4
+#endif
+
+#ifndef OPC_BANK_PORTS
+#define OPC_BANK_PORTS    1
+#endif
+
+#ifndef OPC_NUM_COLLECTORS
+#define OPC_NUM_COLLECTORS 4
+#endif
+
+// Register to bank mapping (0: reg % banks, 1: (reg + wid) % banks)
+#ifndef OPC_BANK_MAP
+#define OPC_BANK_MAP      0
+#endif
+
 inline constexpr int LSU_WORD_SIZE    = (XLEN / 8);
 inline constexpr int LSU_CHANNELS     = NUM_LSU_LANES;
 inline constexpr int LSU_NUM_REQS	    = (NUM_LSU_BLOCKS * LSU_CHANNELS);
@@ -22,6 +22,8 @@
 #include "core.h"
 #include "debug.h"
 #include "constants.h"
+#include "timeline.h"
+#include "socket.h"
 
 using namespace vortex;
 
@@ -39,6 +41,7 @@ Core::Core(const SimContext& ctx,
   , socket_(socket)
   , arch_(arch)
   , emulator_(arch, dcrs, this)
+  , scheduler_(WarpScheduler::Create((SchedPolicy)SCHED_POLICY, arch.num_warps()))
   , ibuffers_(arch.num_warps(), IBUF_SIZE)
   , scoreboard_(arch_)
   , operands_(ISSUE_WIDTH)
@@ -52,7 +55,8 @@ Core::Core(const SimContext& ctx,
   char sname[100];
 
   for (uint32_t i = 0; i < ISSUE_WIDTH; ++i) {
-    operands_.at(i) = SimPlatform::instance().create_object<Operand>();
+    operands_.at(i) = SimPlatform::instance().create_object<Operand>(
+      OPC_NUM_BANKS, OPC_BANK_PORTS, OPC_NUM_COLLECTORS, OPC_BANK_MAP);
   }
 
   // create the memory coalescer
@@ -68,7 +72,8 @@ Core::Core(const SimContext& ctx,
     LSU_WORD_SIZE,
     LSU_CHANNELS,
     log2ceil(LMEM_NUM_BANKS),
-    false
+    false,
+    AMO_LATENCY
   });
 
   // create lmem switch
@@ -161,6 +166,8 @@ void Core::reset() {
 
   emulator_.clear();
 
+  scheduler_->reset();
+
   for (auto& commit_arb : commit_arbs_) {
     commit_arb->reset();
   }
@@ -177,6 +184,7 @@ void Core::reset() {
   ibuffer_idx_ = 0;
   pending_instrs_ = 0;
   pending_ifetches_ = 0;
+  draining_ = false;
 
   perf_stats_ = PerfStats();
 }
@@ -194,11 +202,31 @@ void Core::tick() {
 }
 
 void Core::schedule() {
-  auto trace = emulator_.step();
+  // feed L1 locality back to the scheduler
+  if (0 == (perf_stats_.cycles % SCHED_EPOCH)) {
+    auto dcache_perf = socket_->perf_stats().dcache;
+    scheduler_->cache_feedback(dcache_perf.reads + dcache_perf.writes,
+                               dcache_perf.read_misses + dcache_perf.write_misses);
+  }
+
+  if (draining_)
+    return;
+
+  // select next warp
+  auto ready_warps = emulator_.ready_warps();
+  int wid = scheduler_->schedule(ready_warps, emulator_.active_warps(), emulator_.barrier_warps());
+  if (wid == -1) {
+    ++perf_stats_.sched_idle;
+    return;
+  }
+
+  auto trace = emulator_.step(wid);
   if (trace == nullptr) {
+    // end of a replayed warp
     ++perf_stats_.sched_idle;
     return;
   }
+  scheduler_->issued(wid, trace);
 
   // suspend warp until decode
   emulator_.suspend(trace->wid);
@@ -253,6 +281,10 @@ void Core::decode() {
   if (ibuffer.full()) {
     if (!trace->log_once(true)) {
       DT(4, "*** ibuffer-stall: " << *trace);
+      auto& timeline = Timeline::instance();
+      if (timeline.active()) {
+        timeline.record(Timeline::Stall, core_id_, trace->wid, trace->uuid, Timeline::IBuffer);
+      }
     }
     ++perf_stats_.ibuf_stalls;
     return;
@@ -286,6 +318,10 @@ void Core::issue() {
     } else {
       if (!trace->log_once(true)) {
         DT(4, "*** dispatch-stall: " << *trace);
+        auto& timeline = Timeline::instance();
+        if (timeline.active()) {
+          timeline.record(Timeline::Stall, core_id_, trace->wid, trace->uuid, Timeline::Dispatcher, (uint16_t)trace->fu_type);
+        }
       }
     }
   }
@@ -294,6 +330,7 @@ void Core::issue() {
   for (uint32_t i = 0; i < ISSUE_WIDTH; ++i) {
     bool has_instrs = false;
     bool found_match = false;
+    bool opds_full = false;
     for (uint32_t w = 0; w < PER_ISSUE_WARPS; ++w) {
       uint32_t kk = (ibuffer_idx_ + w) % PER_ISSUE_WARPS;
       uint32_t ii = kk * ISSUE_WIDTH + i;
@@ -314,6 +351,11 @@ void Core::issue() {
             DTN(4, use.reg_type << use.reg_id << "(#" << use.uuid << ")");
           }
           DTN(4, "}, " << *trace << std::endl);
+          auto& timeline = Timeline::instance();
+          if (timeline.active()) {
+            auto blocker = uses.empty() ? trace->fu_type : uses.at(0).fu_type;
+            timeline.record(Timeline::Stall, core_id_, trace->wid, trace->uuid, Timeline::Scoreboard, (uint16_t)blocker);
+          }
         }
         for (uint32_t j = 0, n = uses.size(); j < n; ++j) {
           auto& use = uses.at(j);
@@ -340,20 +382,34 @@ void Core::issue() {
           }
         }
       } else {
+        // to operand stage
+        if (!operands_.at(i)->push(trace)) {
+          if (!trace->log_once(true)) {
+            DT(4, "*** operand-stall: no free collector, " << *trace);
+            auto& timeline = Timeline::instance();
+            if (timeline.active()) {
+              timeline.record(Timeline::Stall, core_id_, trace->wid, trace->uuid, Timeline::Operand);
+            }
+          }
+          opds_full = true;
+          break;
+        }
         trace->log_once(false);
         // update scoreboard
         DT(3, "pipeline-scoreboard: " << *trace);
         if (trace->wb) {
           scoreboard_.reserve(trace);
         }
-        // to operand stage
-        operands_.at(i)->Input.push(trace, 2);
+        auto& timeline = Timeline::instance();
+        if (timeline.active()) {
+          timeline.record(Timeline::Issue, core_id_, trace->wid, trace->uuid, (uint8_t)trace->fu_type);
+        }
         ibuffer.pop();
         found_match = true;
         break;
       }
     }
-    if (has_instrs && !found_match) {
+    if (has_instrs && !found_match && !opds_full) {
       ++perf_stats_.scrb_stalls;
     }
   }
@@ -370,6 +426,10 @@ void Core::execute() {
       auto trace = dispatch->Outputs.at(j).front();
       func_unit->Inputs.at(j).push(trace, 2);
       dispatch->Outputs.at(j).pop();
+      auto& timeline = Timeline::instance();
+      if (timeline.active()) {
+        timeline.record(Timeline::Dispatch, core_id_, trace->wid, trace->uuid, (uint8_t)trace->fu_type);
+      }
     }
   }
 }
@@ -394,6 +454,11 @@ void Core::commit() {
 
       --pending_instrs_;
 
+      auto& timeline = Timeline::instance();
+      if (timeline.active()) {
+        timeline.record(Timeline::Commit, core_id_, trace->wid, trace->uuid, (uint8_t)trace->fu_type);
+      }
+
       perf_stats_.instrs += trace->tmask.count();
     }
 
@@ -409,6 +474,78 @@ void Core::commit() {
   }
 }
 
+void Core::emulate(bool warm) {
+  for (uint32_t wid = 0, n = arch_.num_warps(); wid < n; ++wid) {
+    // warps may be released or stalled by the previous ones
+    if (!emulator_.ready_warps().test(wid))
+      continue;
+
+    auto trace = emulator_.step(wid);
+    if (trace == nullptr)
+      continue;
+    if (warm) {
+      this->warm_caches(trace);
+    }
+
+    // resolve warp control as the pipeline does at execute
+    if (trace->fetch_stall) {
+      emulator_.suspend(wid);
+      bool release_warp = true;
+      if (trace->fu_type == FUType::SFU) {
+        auto trace_data = std::dynamic_pointer_cast<SFUTraceData>(trace->data);
+        if (trace->sfu_type == SfuType::WSPAWN) {
+          release_warp = this->wspawn(trace_data->arg1, trace_data->arg2);
+        } else if (trace->sfu_type == SfuType::BAR) {
+          release_warp = this->barrier(trace_data->arg1, trace_data->arg2, wid);
+        }
+      }
+      if (release_warp) {
+        emulator_.resume(wid);
+      }
+    }
+
+    perf_stats_.instrs += trace->tmask.count();
+    delete trace;
+  }
+}
+
+void Core::warm_caches(const instr_trace_t* trace) {
+  uint32_t core_index = core_id_ % arch_.socket_size();
+  socket_->warm_icache(core_index, trace->PC);
+  if (trace->fu_type != FUType::LSU || !trace->data)
+    return;
+  auto trace_data = std::dynamic_pointer_cast<LsuTraceData>(trace->data);
+  bool is_write = (trace->lsu_type == LsuType::STORE)
+               || (trace->lsu_type == LsuType::TCU_STORE)
+               || (trace->lsu_type == LsuType::AMO);
+  uint64_t prev_line = -1ull;
+  for (uint32_t t = 0, n = trace_data->mem_addrs.size(); t < n; ++t) {
+    if (!trace->tmask.test(t))
+      continue;
+    auto addr = trace_data->mem_addrs.at(t).addr;
+    if (get_addr_type(addr) != AddrType::Global)
+      continue;
+    // consecutive threads usually share the line
+    uint64_t line = addr / L1_LINE_SIZE;
+    if (line == prev_line)
+      continue;
+    socket_->warm_dcache(core_index, addr, is_write);
+    prev_line = line;
+  }
+}
+
+void Core::show_stats() const {
+  auto prefix = "PERF: " + this->name() + ": ";
+  scheduler_->dump_stats(std::cout, prefix);
+  for (uint32_t i = 0; i < ISSUE_WIDTH; ++i) {
+    auto& operand = operands_.at(i);
+    std::cout << prefix << "operand" << i
+              << ": bank conflicts=" << operand->bank_stalls()
+              << ", collector stalls=" << operand->collector_stalls() << std::endl;
+  }
+  emulator_.dump_split_stats(std::cout, prefix);
+}
+
 int Core::get_exitcode() const {
   return emulator_.get_exitcode();
 }
@@ -429,6 +566,22 @@ bool Core::wspawn(uint32_t num_warps, Word nextPC) {
   return emulator_.wspawn(num_warps, nextPC);
 }
 
+void Core::save(CheckpointWriter& writer) const {
+  writer.section("CORE");
+  // kernel-visible counters (mcycle, minstret) continue after a restore
+  writer.write(perf_stats_);
+  emulator_.save(writer);
+  local_mem_->save(writer);
+}
+
+void Core::load(CheckpointReader& reader) {
+  if (!reader.section("CORE"))
+    return;
+  reader.read(&perf_stats_);
+  emulator_.load(reader);
+  local_mem_->load(reader);
+}
+
 void Core::attach_ram(RAM* ram) {
   emulator_.attach_ram(ram);
 }
@@ -26,6 +26,7 @@
 #include "dispatcher.h"
 #include "func_unit.h"
 #include "mem_coalescer.h"
+#include "scheduler.h"
 #include "VX_config.h"
 
 namespace vortex {
@@ -57,6 +58,9 @@ public:
     uint64_t stores;
     uint64_t ifetch_latency;
     uint64_t load_latency;
+    uint64_t alu_stalls;
+    uint64_t fpu_stalls;
+    uint64_t sfu_stalls;
 
     PerfStats()
       : cycles(0)
@@ -77,6 +81,9 @@ public:
       , stores(0)
       , ifetch_latency(0)
       , load_latency(0)
+      , alu_stalls(0)
+      , fpu_stalls(0)
+      , sfu_stalls(0)
     {}
   };
 
@@ -111,6 +118,24 @@ public:
 
   bool wspawn(uint32_t num_warps, Word nextPC);
 
+  // stop scheduling new instructions
+  void drain(bool enable) {
+    draining_ = enable;
+  }
+
+  bool drained() const {
+    return (0 == pending_instrs_);
+  }
+
+  // execute one instruction per ready warp without timing,
+  // optionally updating the cache tags; the pipeline must be drained
+  void emulate(bool warm);
+
+  // architectural state, the pipeline must be drained
+  void save(CheckpointWriter& writer) const;
+
+  void load(CheckpointReader& reader);
+
   uint32_t id() const {
     return core_id_;
   }
@@ -135,6 +160,12 @@ public:
     return perf_stats_;
   }
 
+  const WarpScheduler::Ptr& scheduler() const {
+    return scheduler_;
+  }
+
+  void show_stats() const;
+
   int get_exitcode() const;
 
 private:
@@ -146,12 +177,16 @@ private:
   void execute();
   void commit();
 
+  void warm_caches(const instr_trace_t* trace);
+
   uint32_t core_id_;
   Socket* socket_;
   const Arch& arch_;
 
   Emulator emulator_;
 
+  WarpScheduler::Ptr scheduler_;
+
   std::vector<IBuffer> ibuffers_;
   Scoreboard scoreboard_;
   std::vector<Operand::Ptr> operands_;
@@ -169,6 +204,8 @@ private:
 
   uint64_t pending_ifetches_;
 
+  bool draining_;
+
   PerfStats perf_stats_;
 
   std::vector<TraceArbiter::Ptr> commit_arbs_;
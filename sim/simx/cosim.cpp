@@ -0,0 +1,183 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cosim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sstream>
+#include "types.h"
+
+using namespace vortex;
+
+// number of commits of a warp shown with a divergence
+static const uint32_t HISTORY_SIZE = 8;
+
+static const uint64_t DATA_MASK = (XLEN == 64) ? ~0ull : ((1ull << XLEN) - 1);
+
+Cosim::Cosim()
+  : enabled_(false)
+  , failed_(false)
+  , rtl_done_(false)
+  , path_(getenv("VORTEX_COSIM"))
+  , num_threads_(0)
+  , checks_(0)
+{
+  enabled_ = (path_ != nullptr);
+}
+
+Cosim::~Cosim() {
+  if (!enabled_)
+    return;
+  printf("cosim: instructions=%ld, %s\n", checks_, failed_ ? "FAILED" : "PASSED");
+}
+
+void Cosim::open(uint32_t num_threads) {
+  if (!enabled_ || num_threads_ != 0)
+    return;
+  num_threads_ = num_threads;
+  if (reader_.open(path_, num_threads, XLEN) != 0) {
+    failed_ = true;
+    rtl_done_ = true;
+  }
+}
+
+Cosim::rtl_commit_t* Cosim::fetch(uint64_t uuid) {
+  auto it = pending_.find(uuid);
+  if (it != pending_.end())
+    return &it->second;
+  while (!rtl_done_) {
+    rtl_commit_t rtl;
+    if (!reader_.read(&rtl.record, &rtl.data)
+     || rtl.record.type == CommitLog::RUN_END) {
+      rtl_done_ = true;
+      break;
+    }
+    auto& entry = pending_[rtl.record.uuid];
+    entry = std::move(rtl);
+    if (entry.record.uuid == uuid)
+      return &entry;
+  }
+  return nullptr;
+}
+
+std::string Cosim::compare(const commit_t& commit, const rtl_commit_t& rtl) const {
+  auto& record = rtl.record;
+  if (record.PC != commit.PC)
+    return "PC mismatch";
+  if (record.tmask != commit.tmask)
+    return "thread mask mismatch";
+  // writes to x0 are dropped
+  bool rtl_wb = record.wb && record.rd != 0;
+  bool wb = commit.wb && commit.rd != 0;
+  if (rtl_wb != wb)
+    return "register write mismatch";
+  if (!wb)
+    return "";
+  if (record.rd != commit.rd)
+    return "destination register mismatch";
+  if (commit.volatile_data)
+    return "";
+  for (uint32_t t = 0; t < num_threads_; ++t) {
+    if (!((commit.tmask >> t) & 0x1))
+      continue;
+    if ((rtl.data.at(t) & DATA_MASK) != (commit.data.at(t) & DATA_MASK)) {
+      std::stringstream ss;
+      ss << "register value mismatch on thread " << t;
+      return ss.str();
+    }
+  }
+  return "";
+}
+
+static void print_commit(const char* source, uint64_t PC, uint64_t tmask, bool wb, uint32_t rd, const std::vector<uint64_t>& data, uint32_t num_threads) {
+  printf("  %s: PC=0x%lx, tmask=0x%lx", source, PC, tmask);
+  if (wb) {
+    printf(", rd=%c%d, data={", (rd < 32) ? 'x' : 'f', rd % 32);
+    for (uint32_t t = 0; t < num_threads; ++t) {
+      if (t) printf(", ");
+      if ((tmask >> t) & 0x1) {
+        printf("0x%lx", data.at(t) & DATA_MASK);
+      } else {
+        printf("-");
+      }
+    }
+    printf("}");
+  }
+  printf("\n");
+}
+
+void Cosim::report(uint64_t uuid, const std::string& reason, const commit_t* commit, const rtl_commit_t* rtl) {
+  failed_ = true;
+  uint32_t gwid = uuid >> 32;
+  printf("error: cosim divergence at #%ld (gwid=%d, instr=%d): %s\n", uuid, gwid, uint32_t(uuid), reason.c_str());
+  if (commit) {
+    print_commit("simx", commit->PC, commit->tmask, commit->wb && commit->rd != 0, commit->rd, commit->data, num_threads_);
+  }
+  if (rtl) {
+    auto& record = rtl->record;
+    print_commit("rtl ", record.PC, record.tmask, record.wb && record.rd != 0, record.rd, rtl->data, num_threads_);
+  }
+  auto it = history_.find(gwid);
+  if (it != history_.end()) {
+    printf("  previous commits of the warp:\n");
+    for (auto& record : it->second) {
+      printf("    #%ld: PC=0x%lx, tmask=0x%lx\n", record.uuid, record.PC, record.tmask);
+    }
+  }
+}
+
+bool Cosim::commit(const commit_t& commit) {
+  if (failed_)
+    return false;
+  ++checks_;
+  auto rtl = this->fetch(commit.uuid);
+  if (rtl == nullptr) {
+    this->report(commit.uuid, "instruction not committed by the RTL", &commit, nullptr);
+    return false;
+  }
+  auto reason = this->compare(commit, *rtl);
+  if (!reason.empty()) {
+    this->report(commit.uuid, reason, &commit, rtl);
+    return false;
+  }
+  auto& history = history_[commit.uuid >> 32];
+  history.push_back(rtl->record);
+  if (history.size() > HISTORY_SIZE) {
+    history.pop_front();
+  }
+  pending_.erase(commit.uuid);
+  return true;
+}
+
+void Cosim::end_run() {
+  if (!enabled_)
+    return;
+  if (!failed_) {
+    // any RTL commit left was never executed by SimX
+    this->fetch(~0ull);
+    if (!pending_.empty()) {
+      auto it = pending_.begin();
+      for (auto iter = pending_.begin(); iter != pending_.end(); ++iter) {
+        if (iter->first < it->first) {
+          it = iter;
+        }
+      }
+      this->report(it->first, "instruction not executed by simx", nullptr, &it->second);
+    }
+  }
+  pending_.clear();
+  history_.clear();
+  if (!failed_) {
+    rtl_done_ = false;
+  }
+}
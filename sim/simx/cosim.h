@@ -0,0 +1,100 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <commit_log.h>
+
+namespace vortex {
+
+// Co-simulation against the RTL.
+// SimX runs the same program as an RTL simulator built with COSIM=1 and checks
+// each instruction it executes against the commit stream the RTL exported:
+// PC, thread mask, destination register and the value written by each thread.
+// Both models identify an instruction by its uuid, so records are matched
+// regardless of warp scheduling; with a fifo the two simulations advance in
+// lockstep, SimX blocking until the RTL commits the instruction it checks.
+// The run stops at the first divergence, which is reported with the recent
+// history of the warp.
+// Values read from counter CSRs depend on timing and are not compared, and
+// kernels with data races between warps may legitimately diverge.
+// The checker is controlled from the environment:
+//   VORTEX_COSIM=<path>   commit stream written by the RTL (VORTEX_COMMIT_LOG)
+class Cosim {
+public:
+  struct commit_t {
+    uint64_t uuid;
+    uint64_t PC;
+    uint64_t tmask;
+    uint32_t rd;
+    bool     wb;
+    bool     volatile_data; // register value depends on timing
+    std::vector<uint64_t> data;
+  };
+
+  static Cosim& instance() {
+    static Cosim cosim;
+    return cosim;
+  }
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+  // open the RTL stream, blocks until the RTL simulation starts with a fifo
+  void open(uint32_t num_threads);
+
+  // check an executed instruction, returns false on divergence
+  bool commit(const commit_t& commit);
+
+  // end of the kernel run, checks that the RTL committed nothing more
+  void end_run();
+
+  bool failed() const {
+    return failed_;
+  }
+
+private:
+
+  struct rtl_commit_t {
+    CommitLog::record_t record;
+    std::vector<uint64_t> data;
+  };
+
+  Cosim();
+  ~Cosim();
+
+  // read RTL records until <uuid> is found or the run ends
+  rtl_commit_t* fetch(uint64_t uuid);
+
+  std::string compare(const commit_t& commit, const rtl_commit_t& rtl) const;
+
+  void report(uint64_t uuid, const std::string& reason, const commit_t* commit, const rtl_commit_t* rtl);
+
+  bool enabled_;
+  bool failed_;
+  bool rtl_done_;
+  const char* path_;
+  uint32_t num_threads_;
+  CommitLogReader reader_;
+  std::unordered_map<uint64_t, rtl_commit_t> pending_;
+  std::unordered_map<uint32_t, std::deque<CommitLog::record_t>> history_;
+  uint64_t checks_;
+};
+
+}
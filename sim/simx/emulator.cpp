@@ -27,22 +27,87 @@
 #include "cluster.h"
 #include "processor_impl.h"
 #include "local_mem.h"
+#include "mem_checker.h"
+#include "cosim.h"
+#include "sampler.h"
+#include "trace_log.h"
+#include "checkpoint.h"
 
 using namespace vortex;
 
+namespace {
+
+// compressed CSR numbers of the per-thread CSR file
+enum CsrIndex : uint8_t {
+  CSR_NONE,
+  CSR_MHARTID,
+  CSR_THREAD_ID,
+  CSR_WARP_ID,
+  CSR_CORE_ID,
+  CSR_NUM_THREADS,
+  CSR_NUM_WARPS,
+  CSR_NUM_CORES,
+  CSR_LOCAL_MEM_BASE,
+  CSR_VSTART,
+  CSR_VXSAT,
+  CSR_VXRM,
+  CSR_VL,
+  CSR_VTYPE,
+  CSR_VCYCLE,
+  CSR_VTIME,
+  CSR_VINSTRET,
+  CSR_COUNT
+};
+
+std::array<uint8_t, 4096> build_csr_index() {
+  std::array<uint8_t, 4096> table;
+  table.fill(CSR_NONE);
+  table[VX_CSR_MHARTID]        = CSR_MHARTID;
+  table[VX_CSR_THREAD_ID]      = CSR_THREAD_ID;
+  table[VX_CSR_WARP_ID]        = CSR_WARP_ID;
+  table[VX_CSR_CORE_ID]        = CSR_CORE_ID;
+  table[VX_CSR_NUM_THREADS]    = CSR_NUM_THREADS;
+  table[VX_CSR_NUM_WARPS]      = CSR_NUM_WARPS;
+  table[VX_CSR_NUM_CORES]      = CSR_NUM_CORES;
+  table[VX_CSR_LOCAL_MEM_BASE] = CSR_LOCAL_MEM_BASE;
+#ifdef EXT_V_ENABLE
+  table[VX_CSR_VSTART]         = CSR_VSTART;
+  table[VX_CSR_VXSAT]          = CSR_VXSAT;
+  table[VX_CSR_VXRM]           = CSR_VXRM;
+  table[VX_CSR_VL]             = CSR_VL;
+  table[VX_CSR_VTYPE]          = CSR_VTYPE;
+  table[VX_CSR_VCYCLE]         = CSR_VCYCLE;
+  table[VX_CSR_VTIME]          = CSR_VTIME;
+  table[VX_CSR_VINSTRET]       = CSR_VINSTRET;
+#endif
+  return table;
+}
+
+const std::array<uint8_t, 4096> g_csr_index = build_csr_index();
+
+inline uint32_t csr_index(uint32_t addr) {
+  return g_csr_index[addr & 0xFFF];
+}
+
+}
+
 Emulator::warp_t::warp_t(const Arch& arch)
   : ireg_file(arch.num_threads(), std::vector<Word>(MAX_NUM_REGS))
   , freg_file(arch.num_threads(), std::vector<uint64_t>(MAX_NUM_REGS))
+  , ipdom_stack(std::max<uint32_t>(arch.num_threads() - 1, 1))
 #ifdef EXT_V_ENABLE
-  , vreg_file(MAX_NUM_REGS, std::vector<Byte>(MAX_NUM_REGS))
+  , vreg_file(MAX_NUM_REGS, std::vector<Byte>(VLEN / 8))
 #endif
   , uuid(0)
+  , instrs(0)
 {}
 
 void Emulator::warp_t::clear(uint64_t startup_addr) {
   this->PC = startup_addr;
   this->tmask.reset();
+  this->ipdom_stack.clear();
   this->uuid = 0;
+  this->instrs = 0;
   this->fcsr = 0;
 
   for (auto& reg_file : this->ireg_file) {
@@ -90,23 +155,16 @@ Emulator::Emulator(const Arch &arch, const DCRS &dcrs, Core* core)
     , core_(core)
     , warps_(arch.num_warps(), arch)
     , barriers_(arch.num_barriers(), 0)
-    , ipdom_size_(arch.num_threads()-1)
     // [TBC] Currently, tradeoff between scratchpad size & performance has not been evaluated. Scratchpad is
     // considered to be big enough to hold input tiles for one output tile.
     // In future versions, scratchpad size should be fixed to an appropriate value.
     , scratchpad(std::vector<Word>(32 * 32 * 32768))
-  #ifdef EXT_V_ENABLE
-    , csrs_(arch.num_warps())
-  #endif
+    , csr_file_(arch.num_warps() * arch.num_threads() * CSR_COUNT)
+    , mpm_snapshot_cycle_(-1)
+    , mpm_snapshot_class_(VX_DCR_MPM_CLASS_NONE)
 {
   std::srand(50);
 
-#ifdef EXT_V_ENABLE
-  for (uint32_t i = 0; i < arch_.num_warps(); ++i) {
-    csrs_.at(i).resize(arch.num_threads());
-  }
-#endif
-
   this->clear();
 }
 
@@ -146,6 +204,26 @@ void Emulator::clear() {
   for (auto& reg : scratchpad) {
     reg = 0;
   }
+
+  // reset the CSR file and precompute the thread id registers
+  for (uint32_t wid = 0; wid < arch_.num_warps(); ++wid) {
+    for (uint32_t tid = 0; tid < arch_.num_threads(); ++tid) {
+      auto csrs = csr_file_.data() + this->csr_offset(tid, wid);
+      std::fill_n(csrs, CSR_COUNT, 0);
+      csrs[CSR_MHARTID]        = (core_->id() * arch_.num_warps() + wid) * arch_.num_threads() + tid;
+      csrs[CSR_THREAD_ID]      = tid;
+      csrs[CSR_WARP_ID]        = wid;
+      csrs[CSR_CORE_ID]        = core_->id();
+      csrs[CSR_NUM_THREADS]    = arch_.num_threads();
+      csrs[CSR_NUM_WARPS]      = arch_.num_warps();
+      csrs[CSR_NUM_CORES]      = uint32_t(arch_.num_cores()) * arch_.num_clusters();
+      csrs[CSR_LOCAL_MEM_BASE] = arch_.local_mem_base();
+    }
+  }
+  mpm_snapshot_cycle_ = -1;
+
+  split_stats_.clear();
+  perf_stats_ = PerfStats();
 }
 
 void Emulator::attach_ram(RAM* ram) {
@@ -157,9 +235,15 @@ void Emulator::attach_ram(RAM* ram) {
 #endif
 }
 
-instr_trace_t* Emulator::step() {
-  int scheduled_warp = -1;
+WarpMask Emulator::barrier_warps() const {
+  WarpMask mask;
+  for (auto& barrier : barriers_) {
+    mask |= barrier;
+  }
+  return mask;
+}
 
+WarpMask Emulator::ready_warps() {
   // process pending wspawn
   if (wspawn_.valid && active_warps_.count() == 1) {
     DP(3, "*** Activate " << (wspawn_.num_warps-1) << " warps at PC: " << std::hex << wspawn_.nextPC << std::dec);
@@ -173,19 +257,12 @@ instr_trace_t* Emulator::step() {
     stalled_warps_.reset(0);
   }
 
-  // find next ready warp
-  for (size_t wid = 0, nw = arch_.num_warps(); wid < nw; ++wid) {
-    bool warp_active = active_warps_.test(wid);
-    bool warp_stalled = stalled_warps_.test(wid);
-    if (warp_active && !warp_stalled) {
-      scheduled_warp = wid;
-      break;
-    }
-  }
-  if (scheduled_warp == -1)
-    return nullptr;
+  return active_warps_ & ~stalled_warps_;
+}
+
+instr_trace_t* Emulator::step(uint32_t scheduled_warp) {
+  assert(active_warps_.test(scheduled_warp) && !stalled_warps_.test(scheduled_warp));
 
-  // suspend warp until decode
   auto& warp = warps_.at(scheduled_warp);
   assert(warp.tmask.any());
 
@@ -198,6 +275,28 @@ instr_trace_t* Emulator::step() {
   uint64_t uuid = 0;
 #endif
 
+  ++warp.instrs;
+  perf_stats_.active_lanes += warp.tmask.count();
+
+  // Trace-driven replay
+  auto& trace_log = TraceLog::instance();
+  if (trace_log.replaying()) {
+    auto trace = new instr_trace_t(uuid, arch_);
+    trace->cid = core_->id();
+    trace->wid = scheduled_warp;
+    bool exit = false;
+    if (!trace_log.replay(core_->id() * arch_.num_warps() + scheduled_warp, trace, &exit)) {
+      // the warp has no instruction left in this run
+      delete trace;
+      active_warps_.reset(scheduled_warp);
+      return nullptr;
+    }
+    if (exit) {
+      active_warps_.reset(scheduled_warp);
+    }
+    return trace;
+  }
+
   DP(1, "Fetch: cid=" << core_->id() << ", wid=" << scheduled_warp << ", tmask=" << ThreadMaskOS(warp.tmask, arch_.num_threads())
          << ", PC=0x" << std::hex << warp.PC << " (#" << std::dec << uuid << ")");
 
@@ -220,6 +319,40 @@ instr_trace_t* Emulator::step() {
   // Execute
   this->execute(*instr, scheduled_warp, trace);
 
+  // Trace capture
+  if (trace_log.capturing()) {
+    trace_log.capture(core_->id() * arch_.num_warps() + scheduled_warp, *trace, !active_warps_.test(scheduled_warp));
+  }
+
+  // Statistical sampling
+  auto& sampler = Sampler::instance();
+  if (sampler.enabled()) {
+    sampler.step(core_->id() * arch_.num_warps() + scheduled_warp, trace->PC, trace->tmask.count());
+  }
+
+  // Co-simulation
+  auto& cosim = Cosim::instance();
+  if (cosim.enabled()) {
+    uint32_t g_wid = core_->id() * arch_.num_warps() + scheduled_warp;
+    Cosim::commit_t commit;
+    commit.uuid  = (uint64_t(g_wid) << 32) | uint32_t(warp.instrs - 1);
+    commit.PC    = trace->PC;
+    commit.tmask = trace->tmask.to_ullong();
+    commit.wb    = trace->wb && (trace->dst_reg.type == RegType::Integer || trace->dst_reg.type == RegType::Float);
+    commit.rd    = trace->dst_reg.idx + ((trace->dst_reg.type == RegType::Float) ? 32 : 0);
+    // counter CSRs (0xBxx, 0xCxx) depend on timing
+    auto csr_page = instr->getImm() & 0xf00;
+    commit.volatile_data = (instr->getOpcode() == Opcode::SYS) && (csr_page == 0xb00 || csr_page == 0xc00);
+    commit.data.resize(arch_.num_threads());
+    if (commit.wb) {
+      for (uint32_t t = 0; t < arch_.num_threads(); ++t) {
+        commit.data[t] = (trace->dst_reg.type == RegType::Float) ? warp.freg_file.at(t).at(trace->dst_reg.idx)
+                                                                  : uint64_t(warp.ireg_file.at(t).at(trace->dst_reg.idx));
+      }
+    }
+    cosim.commit(commit);
+  }
+
   DP(5, "Register state:");
   for (uint32_t i = 0; i < MAX_NUM_REGS; ++i) {
     DPN(5, "  %r" << std::setfill('0') << std::setw(2) << i << ':' << std::hex);
@@ -246,6 +379,142 @@ int Emulator::get_exitcode() const {
   return warps_.at(0).ireg_file.at(0).at(3);
 }
 
+void Emulator::save(CheckpointWriter& writer) const {
+  writer.section("EMU");
+  for (auto& warp : warps_) {
+    writer.write(warp.PC);
+    writer.write(warp.tmask);
+    for (auto& reg_file : warp.ireg_file) {
+      writer.write_vector(reg_file);
+    }
+    for (auto& reg_file : warp.freg_file) {
+      writer.write_vector(reg_file);
+    }
+    writer.write(warp.ipdom_stack.size());
+    for (uint32_t i = 0; i < warp.ipdom_stack.size(); ++i) {
+      writer.write(warp.ipdom_stack.at(i));
+    }
+    writer.write(warp.fcsr);
+  #ifdef EXT_V_ENABLE
+    for (auto& reg_file : warp.vreg_file) {
+      writer.write_vector(reg_file);
+    }
+    writer.write(warp.vtype);
+    writer.write(warp.vl);
+    writer.write(warp.vlmax);
+  #endif
+    writer.write(warp.uuid);
+    writer.write(warp.instrs);
+  }
+  writer.write(active_warps_);
+  writer.write(stalled_warps_);
+  writer.write_vector(barriers_);
+  writer.write(csr_mscratch_);
+  writer.write(wspawn_);
+  writer.write_vector(csr_file_);
+  writer.write(mpm_snapshot_);
+  writer.write(mpm_snapshot_cycle_);
+  writer.write(mpm_snapshot_class_);
+  writer.write(mat_size);
+  writer.write(tc_size);
+  writer.write(tc_num);
+  writer.write(perf_stats_);
+  writer.write<uint32_t>(split_stats_.size());
+  for (auto& stats : split_stats_) {
+    writer.write(stats.first);
+    writer.write(stats.second);
+  }
+  writer.write_image(0, scratchpad.data(), scratchpad.size() * sizeof(Word));
+  writer.end_image();
+  // console output not yet flushed
+  writer.write<uint32_t>(print_bufs_.size());
+  for (auto& buf : print_bufs_) {
+    auto str = buf.second.str();
+    writer.write(buf.first);
+    writer.write<uint64_t>(str.size());
+    writer.write(str.data(), str.size());
+  }
+}
+
+void Emulator::load(CheckpointReader& reader) {
+  if (!reader.section("EMU"))
+    return;
+  for (auto& warp : warps_) {
+    reader.read(&warp.PC);
+    reader.read(&warp.tmask);
+    for (auto& reg_file : warp.ireg_file) {
+      reader.read_vector(&reg_file);
+    }
+    for (auto& reg_file : warp.freg_file) {
+      reader.read_vector(&reg_file);
+    }
+    uint32_t ipdom_size = 0;
+    reader.read(&ipdom_size);
+    if (ipdom_size > warp.ipdom_stack.capacity()) {
+      reader.error("IPDOM stack overflow");
+      return;
+    }
+    warp.ipdom_stack.clear();
+    for (uint32_t i = 0; i < ipdom_size; ++i) {
+      ipdom_entry_t entry;
+      reader.read(&entry);
+      warp.ipdom_stack.push(entry);
+    }
+    reader.read(&warp.fcsr);
+  #ifdef EXT_V_ENABLE
+    for (auto& reg_file : warp.vreg_file) {
+      reader.read_vector(&reg_file);
+    }
+    reader.read(&warp.vtype);
+    reader.read(&warp.vl);
+    reader.read(&warp.vlmax);
+  #endif
+    reader.read(&warp.uuid);
+    reader.read(&warp.instrs);
+  }
+  reader.read(&active_warps_);
+  reader.read(&stalled_warps_);
+  reader.read_vector(&barriers_);
+  reader.read(&csr_mscratch_);
+  reader.read(&wspawn_);
+  reader.read_vector(&csr_file_);
+  reader.read(&mpm_snapshot_);
+  reader.read(&mpm_snapshot_cycle_);
+  reader.read(&mpm_snapshot_class_);
+  reader.read(&mat_size);
+  reader.read(&tc_size);
+  reader.read(&tc_num);
+  reader.read(&perf_stats_);
+  split_stats_.clear();
+  uint32_t num_splits = 0;
+  reader.read(&num_splits);
+  for (uint32_t i = 0; i < num_splits && !reader.failed(); ++i) {
+    Word pc = 0;
+    split_stats_t stats;
+    reader.read(&pc);
+    reader.read(&stats);
+    split_stats_[pc] = stats;
+  }
+  uint64_t scratchpad_size = scratchpad.size() * sizeof(Word);
+  reader.read_image([&](uint64_t addr, const uint8_t* data, uint32_t size) {
+    if (addr < scratchpad_size) {
+      memcpy((uint8_t*)scratchpad.data() + addr, data, std::min<uint64_t>(size, scratchpad_size - addr));
+    }
+  });
+  print_bufs_.clear();
+  uint32_t num_bufs = 0;
+  reader.read(&num_bufs);
+  for (uint32_t i = 0; i < num_bufs && !reader.failed(); ++i) {
+    int tid = 0;
+    uint64_t size = 0;
+    reader.read(&tid);
+    reader.read(&size);
+    std::string str(size, '\0');
+    reader.read(&str[0], size);
+    print_bufs_[tid] << str;
+  }
+}
+
 void Emulator::suspend(uint32_t wid) {
   assert(!stalled_warps_.test(wid));
   stalled_warps_.set(wid);
@@ -396,6 +665,9 @@ void Emulator::dcache_write(const void* data, uint64_t addr, uint32_t size) {
     if (type == AddrType::Shared) {
       core_->local_mem()->write(data, addr, size);
     } else {
+      if (MemChecker::instance().enabled()) {
+        MemChecker::instance().preserve(addr, size);
+      }
       mmu_.write(data, addr, size, 0);
     }
   }
@@ -440,6 +712,19 @@ void Emulator::cout_flush() {
   }
 }
 
+void Emulator::dump_split_stats(std::ostream& os, const std::string& prefix) const {
+  for (auto& it : split_stats_) {
+    auto& stats = it.second;
+    double lanes = double(stats.lanes) / (stats.splits * arch_.num_threads());
+    double distance = stats.divergent ? (double(stats.distance) / stats.divergent) : 0;
+    os << prefix << "split PC=0x" << std::hex << it.first << std::dec
+       << ": count=" << stats.splits
+       << ", divergent=" << stats.divergent
+       << ", active lanes=" << int(lanes * 100) << "%"
+       << ", reconvergence distance=" << distance << std::endl;
+  }
+}
+
 #ifdef XLEN_64
   #define CSR_READ_64(addr, value) \
     case addr: return value
@@ -461,12 +746,140 @@ Word Emulator::get_tc_num() {
   return tc_num;
 }
 
+uint32_t Emulator::csr_offset(uint32_t tid, uint32_t wid) const {
+  return (wid * arch_.num_threads() + tid) * CSR_COUNT;
+}
+
+void Emulator::update_mpm_snapshot(uint32_t perf_class) {
+  // the counters are sampled at most once per cycle, so that all threads
+  // reading the same counter do not gather the stats again
+  auto cycle = SimPlatform::instance().cycles();
+  if (cycle == mpm_snapshot_cycle_ && perf_class == mpm_snapshot_class_)
+    return;
+  mpm_snapshot_cycle_ = cycle;
+  mpm_snapshot_class_ = perf_class;
+  mpm_snapshot_.fill(0);
+
+#define MPM_SNAPSHOT(addr, value) \
+  mpm_snapshot_[(addr) - VX_CSR_MPM_BASE] = value
+
+  switch (perf_class) {
+  case VX_DCR_MPM_CLASS_NONE:
+    break;
+  case VX_DCR_MPM_CLASS_CORE: {
+    auto& core_perf = core_->perf_stats();
+    MPM_SNAPSHOT(VX_CSR_MPM_SCHED_ID, core_perf.sched_idle);
+    MPM_SNAPSHOT(VX_CSR_MPM_SCHED_ST, core_perf.sched_stalls);
+    MPM_SNAPSHOT(VX_CSR_MPM_IBUF_ST, core_perf.ibuf_stalls);
+    MPM_SNAPSHOT(VX_CSR_MPM_SCRB_ST, core_perf.scrb_stalls);
+    MPM_SNAPSHOT(VX_CSR_MPM_OPDS_ST, core_perf.opds_stalls);
+    MPM_SNAPSHOT(VX_CSR_MPM_SCRB_ALU, core_perf.scrb_alu);
+    MPM_SNAPSHOT(VX_CSR_MPM_SCRB_FPU, core_perf.scrb_fpu);
+    MPM_SNAPSHOT(VX_CSR_MPM_SCRB_LSU, core_perf.scrb_lsu);
+    MPM_SNAPSHOT(VX_CSR_MPM_SCRB_SFU, core_perf.scrb_sfu);
+    MPM_SNAPSHOT(VX_CSR_MPM_SCRB_CSRS, core_perf.scrb_csrs);
+    MPM_SNAPSHOT(VX_CSR_MPM_SCRB_WCTL, core_perf.scrb_wctl);
+    MPM_SNAPSHOT(VX_CSR_MPM_IFETCHES, core_perf.ifetches);
+    MPM_SNAPSHOT(VX_CSR_MPM_LOADS, core_perf.loads);
+    MPM_SNAPSHOT(VX_CSR_MPM_STORES, core_perf.stores);
+    MPM_SNAPSHOT(VX_CSR_MPM_IFETCH_LT, core_perf.ifetch_latency);
+    MPM_SNAPSHOT(VX_CSR_MPM_LOAD_LT, core_perf.load_latency);
+    MPM_SNAPSHOT(VX_CSR_MPM_ALU_ST, core_perf.alu_stalls);
+    MPM_SNAPSHOT(VX_CSR_MPM_FPU_ST, core_perf.fpu_stalls);
+    MPM_SNAPSHOT(VX_CSR_MPM_SFU_ST, core_perf.sfu_stalls);
+  } break;
+  case VX_DCR_MPM_CLASS_MEM: {
+    auto proc_perf = core_->socket()->cluster()->processor()->perf_stats();
+    auto cluster_perf = core_->socket()->cluster()->perf_stats();
+    auto socket_perf = core_->socket()->perf_stats();
+    auto lmem_perf = core_->local_mem()->perf_stats();
+
+    uint64_t coalescer_misses = 0;
+    for (uint i = 0; i < NUM_LSU_BLOCKS; ++i) {
+      coalescer_misses += core_->mem_coalescer(i)->perf_stats().misses;
+    }
+
+    MPM_SNAPSHOT(VX_CSR_MPM_ICACHE_READS, socket_perf.icache.reads);
+    MPM_SNAPSHOT(VX_CSR_MPM_ICACHE_MISS_R, socket_perf.icache.read_misses);
+    MPM_SNAPSHOT(VX_CSR_MPM_ICACHE_MSHR_ST, socket_perf.icache.mshr_stalls);
+
+    MPM_SNAPSHOT(VX_CSR_MPM_DCACHE_READS, socket_perf.dcache.reads);
+    MPM_SNAPSHOT(VX_CSR_MPM_DCACHE_WRITES, socket_perf.dcache.writes);
+    MPM_SNAPSHOT(VX_CSR_MPM_DCACHE_MISS_R, socket_perf.dcache.read_misses);
+    MPM_SNAPSHOT(VX_CSR_MPM_DCACHE_MISS_W, socket_perf.dcache.write_misses);
+    MPM_SNAPSHOT(VX_CSR_MPM_DCACHE_BANK_ST, socket_perf.dcache.bank_stalls);
+    MPM_SNAPSHOT(VX_CSR_MPM_DCACHE_MSHR_ST, socket_perf.dcache.mshr_stalls);
+
+    MPM_SNAPSHOT(VX_CSR_MPM_L2CACHE_READS, cluster_perf.l2cache.reads);
+    MPM_SNAPSHOT(VX_CSR_MPM_L2CACHE_WRITES, cluster_perf.l2cache.writes);
+    MPM_SNAPSHOT(VX_CSR_MPM_L2CACHE_MISS_R, cluster_perf.l2cache.read_misses);
+    MPM_SNAPSHOT(VX_CSR_MPM_L2CACHE_MISS_W, cluster_perf.l2cache.write_misses);
+    MPM_SNAPSHOT(VX_CSR_MPM_L2CACHE_BANK_ST, cluster_perf.l2cache.bank_stalls);
+    MPM_SNAPSHOT(VX_CSR_MPM_L2CACHE_MSHR_ST, cluster_perf.l2cache.mshr_stalls);
+
+    MPM_SNAPSHOT(VX_CSR_MPM_L3CACHE_READS, proc_perf.l3cache.reads);
+    MPM_SNAPSHOT(VX_CSR_MPM_L3CACHE_WRITES, proc_perf.l3cache.writes);
+    MPM_SNAPSHOT(VX_CSR_MPM_L3CACHE_MISS_R, proc_perf.l3cache.read_misses);
+    MPM_SNAPSHOT(VX_CSR_MPM_L3CACHE_MISS_W, proc_perf.l3cache.write_misses);
+    MPM_SNAPSHOT(VX_CSR_MPM_L3CACHE_BANK_ST, proc_perf.l3cache.bank_stalls);
+    MPM_SNAPSHOT(VX_CSR_MPM_L3CACHE_MSHR_ST, proc_perf.l3cache.mshr_stalls);
+
+    MPM_SNAPSHOT(VX_CSR_MPM_MEM_READS, proc_perf.mem_reads);
+    MPM_SNAPSHOT(VX_CSR_MPM_MEM_WRITES, proc_perf.mem_writes);
+    MPM_SNAPSHOT(VX_CSR_MPM_MEM_LT, proc_perf.mem_latency);
+    MPM_SNAPSHOT(VX_CSR_MPM_MEM_BANK_ST, proc_perf.memsim.bank_stalls);
+
+    MPM_SNAPSHOT(VX_CSR_MPM_COALESCER_MISS, coalescer_misses);
+
+    MPM_SNAPSHOT(VX_CSR_MPM_LMEM_READS, lmem_perf.reads);
+    MPM_SNAPSHOT(VX_CSR_MPM_LMEM_WRITES, lmem_perf.writes);
+    MPM_SNAPSHOT(VX_CSR_MPM_LMEM_BANK_ST, lmem_perf.bank_stalls);
+  } break;
+  case VX_DCR_MPM_CLASS_SIMT: {
+    MPM_SNAPSHOT(VX_CSR_MPM_SPLITS, perf_stats_.splits);
+    MPM_SNAPSHOT(VX_CSR_MPM_SPLITS_DIV, perf_stats_.divergent);
+    MPM_SNAPSHOT(VX_CSR_MPM_SPLIT_LANES, perf_stats_.split_lanes);
+    MPM_SNAPSHOT(VX_CSR_MPM_RECONV_DIST, perf_stats_.reconv_distance);
+    MPM_SNAPSHOT(VX_CSR_MPM_ACTIVE_LANES, perf_stats_.active_lanes);
+  } break;
+  case VX_DCR_MPM_CLASS_AMO: {
+    auto proc_perf = core_->socket()->cluster()->processor()->perf_stats();
+    auto cluster_perf = core_->socket()->cluster()->perf_stats();
+    auto socket_perf = core_->socket()->perf_stats();
+    auto lmem_perf = core_->local_mem()->perf_stats();
+
+    MPM_SNAPSHOT(VX_CSR_MPM_LMEM_AMOS, lmem_perf.amos);
+    MPM_SNAPSHOT(VX_CSR_MPM_LMEM_AMO_ST, lmem_perf.amo_stalls);
+
+    MPM_SNAPSHOT(VX_CSR_MPM_DCACHE_AMOS, socket_perf.dcache.amos);
+    MPM_SNAPSHOT(VX_CSR_MPM_DCACHE_AMO_ST, socket_perf.dcache.amo_stalls);
+
+    MPM_SNAPSHOT(VX_CSR_MPM_L2CACHE_AMOS, cluster_perf.l2cache.amos);
+    MPM_SNAPSHOT(VX_CSR_MPM_L2CACHE_AMO_ST, cluster_perf.l2cache.amo_stalls);
+
+    MPM_SNAPSHOT(VX_CSR_MPM_L3CACHE_AMOS, proc_perf.l3cache.amos);
+    MPM_SNAPSHOT(VX_CSR_MPM_L3CACHE_AMO_ST, proc_perf.l3cache.amo_stalls);
+  } break;
+  default: {
+    std::cout << "Error: invalid MPM CLASS: value=" << perf_class << std::endl;
+    std::abort();
+  } break;
+  }
+
+#undef MPM_SNAPSHOT
+}
+
 Word Emulator::get_csr(uint32_t addr, uint32_t tid, uint32_t wid) {
-  auto core_perf = core_->perf_stats();
+  // registers held in the CSR file
+  auto index = csr_index(addr);
+  if (index != CSR_NONE) {
+    return csr_file_[this->csr_offset(tid, wid) + index];
+  }
+
+  auto& core_perf = core_->perf_stats();
   switch (addr) {
   case VX_CSR_SATP:
 #ifdef VM_ENABLE
-    // return csrs_.at(wid).at(tid)[addr];
     return mmu_.get_satp();
 #endif
   case VX_CSR_PMPCFG0:
@@ -488,41 +901,18 @@ Word Emulator::get_csr(uint32_t addr, uint32_t tid, uint32_t wid) {
 
 #ifdef EXT_V_ENABLE
   // Vector CRSs
-  case VX_CSR_VSTART:
-    return csrs_.at(wid).at(tid)[VX_CSR_VSTART];
-  case VX_CSR_VXSAT:
-    return csrs_.at(wid).at(tid)[VX_CSR_VXSAT];
-  case VX_CSR_VXRM:
-    return csrs_.at(wid).at(tid)[VX_CSR_VXRM];
   case VX_CSR_VCSR: {
-    Word vxsat = csrs_.at(wid).at(tid)[VX_CSR_VXSAT];
-    Word vxrm = csrs_.at(wid).at(tid)[VX_CSR_VXRM];
+    auto offset = this->csr_offset(tid, wid);
+    Word vxsat = csr_file_[offset + CSR_VXSAT];
+    Word vxrm = csr_file_[offset + CSR_VXRM];
     return (vxrm << 1) | vxsat;
   }
-  case VX_CSR_VL:
-    return csrs_.at(wid).at(tid)[VX_CSR_VL];
-  case VX_CSR_VTYPE:
-    return csrs_.at(wid).at(tid)[VX_CSR_VTYPE];
   case VX_CSR_VLENB:
     return VLEN / 8;
-  case VX_CSR_VCYCLE:
-    return csrs_.at(wid).at(tid)[VX_CSR_VCYCLE];
-  case VX_CSR_VTIME:
-    return csrs_.at(wid).at(tid)[VX_CSR_VTIME];
-  case VX_CSR_VINSTRET:
-    return csrs_.at(wid).at(tid)[VX_CSR_VINSTRET];
 #endif
 
-  case VX_CSR_MHARTID:    return (core_->id() * arch_.num_warps() + wid) * arch_.num_threads() + tid;
-  case VX_CSR_THREAD_ID:  return tid;
-  case VX_CSR_WARP_ID:    return wid;
-  case VX_CSR_CORE_ID:    return core_->id();
   case VX_CSR_ACTIVE_THREADS:return warps_.at(wid).tmask.to_ulong();
   case VX_CSR_ACTIVE_WARPS:return active_warps_.to_ulong();
-  case VX_CSR_NUM_THREADS:return arch_.num_threads();
-  case VX_CSR_NUM_WARPS:  return arch_.num_warps();
-  case VX_CSR_NUM_CORES:  return uint32_t(arch_.num_cores()) * arch_.num_clusters();
-  case VX_CSR_LOCAL_MEM_BASE: return arch_.local_mem_base();
   case VX_CSR_MSCRATCH:   return csr_mscratch_;
   case VX_MAT_MUL_SIZE:   return mat_size;
   case VX_TC_NUM:         return tc_num;
@@ -535,83 +925,15 @@ Word Emulator::get_csr(uint32_t addr, uint32_t tid, uint32_t wid) {
      || (addr >= VX_CSR_MPM_BASE_H && addr < (VX_CSR_MPM_BASE_H + 32))) {
       // user-defined MPM CSRs
       auto perf_class = dcrs_.base_dcrs.read(VX_DCR_BASE_MPM_CLASS);
-      switch (perf_class) {
-      case VX_DCR_MPM_CLASS_NONE:
-        break;
-      case VX_DCR_MPM_CLASS_CORE: {
-        switch (addr) {
-        CSR_READ_64(VX_CSR_MPM_SCHED_ID, core_perf.sched_idle);
-        CSR_READ_64(VX_CSR_MPM_SCHED_ST, core_perf.sched_stalls);
-        CSR_READ_64(VX_CSR_MPM_IBUF_ST, core_perf.ibuf_stalls);
-        CSR_READ_64(VX_CSR_MPM_SCRB_ST, core_perf.scrb_stalls);
-        CSR_READ_64(VX_CSR_MPM_OPDS_ST, core_perf.opds_stalls);
-        CSR_READ_64(VX_CSR_MPM_SCRB_ALU, core_perf.scrb_alu);
-        CSR_READ_64(VX_CSR_MPM_SCRB_FPU, core_perf.scrb_fpu);
-        CSR_READ_64(VX_CSR_MPM_SCRB_LSU, core_perf.scrb_lsu);
-        CSR_READ_64(VX_CSR_MPM_SCRB_SFU, core_perf.scrb_sfu);
-        CSR_READ_64(VX_CSR_MPM_SCRB_CSRS, core_perf.scrb_csrs);
-        CSR_READ_64(VX_CSR_MPM_SCRB_WCTL, core_perf.scrb_wctl);
-        CSR_READ_64(VX_CSR_MPM_IFETCHES, core_perf.ifetches);
-        CSR_READ_64(VX_CSR_MPM_LOADS, core_perf.loads);
-        CSR_READ_64(VX_CSR_MPM_STORES, core_perf.stores);
-        CSR_READ_64(VX_CSR_MPM_IFETCH_LT, core_perf.ifetch_latency);
-        CSR_READ_64(VX_CSR_MPM_LOAD_LT, core_perf.load_latency);
-        }
-      } break;
-      case VX_DCR_MPM_CLASS_MEM: {
-        auto proc_perf = core_->socket()->cluster()->processor()->perf_stats();
-        auto cluster_perf = core_->socket()->cluster()->perf_stats();
-        auto socket_perf = core_->socket()->perf_stats();
-        auto lmem_perf = core_->local_mem()->perf_stats();
-
-        uint64_t coalescer_misses = 0;
-        for (uint i = 0; i < NUM_LSU_BLOCKS; ++i) {
-          coalescer_misses += core_->mem_coalescer(i)->perf_stats().misses;
-        }
-
-        switch (addr) {
-        CSR_READ_64(VX_CSR_MPM_ICACHE_READS, socket_perf.icache.reads);
-        CSR_READ_64(VX_CSR_MPM_ICACHE_MISS_R, socket_perf.icache.read_misses);
-        CSR_READ_64(VX_CSR_MPM_ICACHE_MSHR_ST, socket_perf.icache.mshr_stalls);
-
-        CSR_READ_64(VX_CSR_MPM_DCACHE_READS, socket_perf.dcache.reads);
-        CSR_READ_64(VX_CSR_MPM_DCACHE_WRITES, socket_perf.dcache.writes);
-        CSR_READ_64(VX_CSR_MPM_DCACHE_MISS_R, socket_perf.dcache.read_misses);
-        CSR_READ_64(VX_CSR_MPM_DCACHE_MISS_W, socket_perf.dcache.write_misses);
-        CSR_READ_64(VX_CSR_MPM_DCACHE_BANK_ST, socket_perf.dcache.bank_stalls);
-        CSR_READ_64(VX_CSR_MPM_DCACHE_MSHR_ST, socket_perf.dcache.mshr_stalls);
-
-        CSR_READ_64(VX_CSR_MPM_L2CACHE_READS, cluster_perf.l2cache.reads);
-        CSR_READ_64(VX_CSR_MPM_L2CACHE_WRITES, cluster_perf.l2cache.writes);
-        CSR_READ_64(VX_CSR_MPM_L2CACHE_MISS_R, cluster_perf.l2cache.read_misses);
-        CSR_READ_64(VX_CSR_MPM_L2CACHE_MISS_W, cluster_perf.l2cache.write_misses);
-        CSR_READ_64(VX_CSR_MPM_L2CACHE_BANK_ST, cluster_perf.l2cache.bank_stalls);
-        CSR_READ_64(VX_CSR_MPM_L2CACHE_MSHR_ST, cluster_perf.l2cache.mshr_stalls);
-
-        CSR_READ_64(VX_CSR_MPM_L3CACHE_READS, proc_perf.l3cache.reads);
-        CSR_READ_64(VX_CSR_MPM_L3CACHE_WRITES, proc_perf.l3cache.writes);
-        CSR_READ_64(VX_CSR_MPM_L3CACHE_MISS_R, proc_perf.l3cache.read_misses);
-        CSR_READ_64(VX_CSR_MPM_L3CACHE_MISS_W, proc_perf.l3cache.write_misses);
-        CSR_READ_64(VX_CSR_MPM_L3CACHE_BANK_ST, proc_perf.l3cache.bank_stalls);
-        CSR_READ_64(VX_CSR_MPM_L3CACHE_MSHR_ST, proc_perf.l3cache.mshr_stalls);
-
-        CSR_READ_64(VX_CSR_MPM_MEM_READS, proc_perf.mem_reads);
-        CSR_READ_64(VX_CSR_MPM_MEM_WRITES, proc_perf.mem_writes);
-        CSR_READ_64(VX_CSR_MPM_MEM_LT, proc_perf.mem_latency);
-        CSR_READ_64(VX_CSR_MPM_MEM_BANK_ST, proc_perf.memsim.bank_stalls);
-
-        CSR_READ_64(VX_CSR_MPM_COALESCER_MISS, coalescer_misses);
-
-        CSR_READ_64(VX_CSR_MPM_LMEM_READS, lmem_perf.reads);
-        CSR_READ_64(VX_CSR_MPM_LMEM_WRITES, lmem_perf.writes);
-        CSR_READ_64(VX_CSR_MPM_LMEM_BANK_ST, lmem_perf.bank_stalls);
-        }
-      } break;
-      default: {
-        std::cout << "Error: invalid MPM CLASS: value=" << perf_class << std::endl;
-        std::abort();
-      } break;
-      }
+      if (perf_class == VX_DCR_MPM_CLASS_NONE)
+        return 0;
+      this->update_mpm_snapshot(perf_class);
+      auto value = mpm_snapshot_[addr & 0x1F];
+    #ifdef XLEN_64
+      return (addr < VX_CSR_MPM_BASE_H) ? value : 0;
+    #else
+      return (addr < VX_CSR_MPM_BASE_H) ? (value & 0xFFFFFFFF) : ((value >> 32) & 0xFFFFFFFF);
+    #endif
     } else {
       std::cout << "Error: invalid CSR read addr=0x"<< std::hex << addr << std::dec << std::endl;
       std::abort();
@@ -639,31 +961,30 @@ void Emulator::set_csr(uint32_t addr, Word value, uint32_t tid, uint32_t wid) {
 #ifdef EXT_V_ENABLE
   // Vector CRSs
   case VX_CSR_VSTART:
-    csrs_.at(wid).at(tid)[VX_CSR_VSTART] = value;
+    csr_file_[this->csr_offset(tid, wid) + CSR_VSTART] = value;
     break;
   case VX_CSR_VXSAT:
-    csrs_.at(wid).at(tid)[VX_CSR_VXSAT] = value & 0b1;
+    csr_file_[this->csr_offset(tid, wid) + CSR_VXSAT] = value & 0b1;
     break;
   case VX_CSR_VXRM:
-    csrs_.at(wid).at(tid)[VX_CSR_VXRM] = value & 0b11;
-    break;
-  case VX_CSR_VCSR:
-    csrs_.at(wid).at(tid)[VX_CSR_VXSAT] = value & 0b1;
-    csrs_.at(wid).at(tid)[VX_CSR_VXRM] = (value >> 1) & 0b11;
+    csr_file_[this->csr_offset(tid, wid) + CSR_VXRM] = value & 0b11;
     break;
+  case VX_CSR_VCSR: {
+    auto offset = this->csr_offset(tid, wid);
+    csr_file_[offset + CSR_VXSAT] = value & 0b1;
+    csr_file_[offset + CSR_VXRM] = (value >> 1) & 0b11;
+  } break;
   case VX_CSR_VL: // read only, written by vset(i)vl(i)
-    csrs_.at(wid).at(tid)[VX_CSR_VL] = value;
+    csr_file_[this->csr_offset(tid, wid) + CSR_VL] = value;
     break;
   case VX_CSR_VTYPE: // read only, written by vset(i)vl(i)
-    csrs_.at(wid).at(tid)[VX_CSR_VTYPE] = value;
+    csr_file_[this->csr_offset(tid, wid) + CSR_VTYPE] = value;
     break;
   case VX_CSR_VLENB: // read only, set to VLEN / 8
 #endif
 
   case VX_CSR_SATP:
   #ifdef VM_ENABLE
-    // warps_.at(wid).fcsr = (warps_.at(wid).fcsr & ~0x1F) | (value & 0x1F);
-    // csrs_.at(wid).at(tid)[addr] = value; //what is wid and tid?
     mmu_.set_satp(value);
     break;
   #endif
@@ -15,8 +15,9 @@
 #define __WARP_H
 
 #include <vector>
+#include <array>
+#include <map>
 #include <sstream>
-#include <stack>
 #include <mem.h>
 #include "types.h"
 
@@ -27,6 +28,8 @@ class DCRS;
 class Core;
 class Instr;
 class instr_trace_t;
+class CheckpointWriter;
+class CheckpointReader;
 
 class Emulator {
 public:
@@ -43,7 +46,17 @@ public:
   void set_satp(uint64_t satp) ;
 #endif
 
-  instr_trace_t* step();
+  // warps that can be scheduled this cycle
+  WarpMask ready_warps();
+
+  const WarpMask& active_warps() const {
+    return active_warps_;
+  }
+
+  // warps suspended at a local barrier
+  WarpMask barrier_warps() const;
+
+  instr_trace_t* step(uint32_t wid);
 
   bool running() const;
 
@@ -57,6 +70,40 @@ public:
 
   int get_exitcode() const;
 
+  void save(CheckpointWriter& writer) const;
+
+  void load(CheckpointReader& reader);
+
+  // per split instruction divergence statistics
+  struct split_stats_t {
+    uint64_t splits;      // executed splits
+    uint64_t divergent;   // splits that diverged
+    uint64_t lanes;       // active lanes at the split
+    uint64_t distance;    // warp instructions until reconvergence (divergent splits only)
+  };
+
+  struct PerfStats {
+    uint64_t splits;
+    uint64_t divergent;
+    uint64_t split_lanes;
+    uint64_t reconv_distance;
+    uint64_t active_lanes; // active lanes over all executed instructions
+
+    PerfStats()
+      : splits(0)
+      , divergent(0)
+      , split_lanes(0)
+      , reconv_distance(0)
+      , active_lanes(0)
+    {}
+  };
+
+  const PerfStats& perf_stats() const {
+    return perf_stats_;
+  }
+
+  void dump_split_stats(std::ostream& os, const std::string& prefix) const;
+
   Word get_tiles();
   Word get_tc_size();
   Word get_tc_num();
@@ -68,19 +115,70 @@ public:
 private:
 
   struct ipdom_entry_t {
-    ipdom_entry_t(const ThreadMask &orig_tmask, const ThreadMask &else_tmask, Word PC)
-      : orig_tmask (orig_tmask)
-      , else_tmask (else_tmask)
-      , PC         (PC)
-      , fallthrough(false)
-    {}
-
     ThreadMask  orig_tmask;
     ThreadMask  else_tmask;
     Word        PC;
+    Word        split_PC;
+    uint64_t    split_instrs;
     bool        fallthrough;
   };
 
+  // fixed-capacity IPDOM stack, sized like VX_ipdom_stack (DV_STACK_SIZE)
+  class ipdom_stack_t {
+  public:
+    ipdom_stack_t(uint32_t capacity)
+      : size_(0)
+      , capacity_(capacity)
+    {
+      assert(capacity <= entries_.size());
+    }
+
+    uint32_t size() const {
+      return size_;
+    }
+
+    uint32_t capacity() const {
+      return capacity_;
+    }
+
+    bool empty() const {
+      return (0 == size_);
+    }
+
+    bool full() const {
+      return (size_ == capacity_);
+    }
+
+    ipdom_entry_t& top() {
+      assert(!this->empty());
+      return entries_[size_ - 1];
+    }
+
+    const ipdom_entry_t& at(uint32_t index) const {
+      assert(index < size_);
+      return entries_[index];
+    }
+
+    void push(const ipdom_entry_t& entry) {
+      assert(!this->full());
+      entries_[size_++] = entry;
+    }
+
+    void pop() {
+      assert(!this->empty());
+      --size_;
+    }
+
+    void clear() {
+      size_ = 0;
+    }
+
+  private:
+    std::array<ipdom_entry_t, MAX_NUM_THREADS> entries_;
+    uint32_t size_;
+    uint32_t capacity_;
+  };
+
   struct vtype_t {
     uint32_t vill;
     uint32_t vma;
@@ -109,7 +207,7 @@ private:
     ThreadMask                        tmask;
     std::vector<std::vector<Word>>    ireg_file;
     std::vector<std::vector<uint64_t>>freg_file;
-    std::stack<ipdom_entry_t>         ipdom_stack;
+    ipdom_stack_t                     ipdom_stack;
     Byte                              fcsr;
 #ifdef EXT_V_ENABLE
     std::vector<std::vector<Byte>>    vreg_file;
@@ -118,6 +216,7 @@ private:
     Word                              vlmax;
 #endif
     uint32_t                          uuid;
+    uint64_t                          instrs;
   };
 
   struct wspawn_t {
@@ -146,6 +245,10 @@ private:
 
   void cout_flush();
 
+  uint32_t csr_offset(uint32_t tid, uint32_t wid) const;
+
+  void update_mpm_snapshot(uint32_t perf_class);
+
   Word get_csr(uint32_t addr, uint32_t tid, uint32_t wid);
 
   void set_csr(uint32_t addr, Word value, uint32_t tid, uint32_t wid);
@@ -168,14 +271,18 @@ private:
   std::vector<WarpMask> barriers_;
   std::unordered_map<int, std::stringstream> print_bufs_;
   MemoryUnit  mmu_;
-  uint32_t    ipdom_size_;
   Word        csr_mscratch_;
   wspawn_t    wspawn_;
   std::vector<Word> scratchpad;
   uint32_t mat_size;
   uint32_t tc_size;
   uint32_t tc_num;
-  std::vector<std::vector<std::unordered_map<uint32_t, uint32_t>>> csrs_;
+  std::vector<Word> csr_file_;
+  std::array<uint64_t, 32> mpm_snapshot_;
+  uint64_t    mpm_snapshot_cycle_;
+  uint32_t    mpm_snapshot_class_;
+  std::map<Word, split_stats_t> split_stats_;
+  PerfStats   perf_stats_;
 };
 
 }
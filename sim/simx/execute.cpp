@@ -25,6 +25,7 @@
 #include "emulator.h"
 #include "instr.h"
 #include "core.h"
+#include "mem_checker.h"
 #ifdef EXT_V_ENABLE
 #include "processor_impl.h"
 #endif
@@ -678,6 +679,9 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
      || (opcode == Opcode::FL && func3 == 3)) {
       uint32_t data_bytes = 1 << (func3 & 0x3);
       uint32_t data_width = 8 * data_bytes;
+      if (MemChecker::instance().enabled()) {
+        trace_data->mem_blocks.resize(num_threads);
+      }
       for (uint32_t t = thread_start; t < num_threads; ++t) {
         if (!warp.tmask.test(t))
           continue;
@@ -685,6 +689,9 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
         uint64_t read_data = 0;
         this->dcache_read(&read_data, mem_addr, data_bytes);
         trace_data->mem_addrs.at(t) = {mem_addr, data_bytes};
+        if (!trace_data->mem_blocks.empty()) {
+          trace_data->mem_blocks.at(t) = MemChecker::block(mem_addr, &read_data, data_bytes, warp.PC, wid);
+        }
         switch (func3) {
         case 0: // RV32I: LB
         case 1: // RV32I: LH
@@ -732,12 +739,18 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
      || (opcode == Opcode::FS && func3 == 2)
      || (opcode == Opcode::FS && func3 == 3)) {
       uint32_t data_bytes = 1 << (func3 & 0x3);
+      if (MemChecker::instance().enabled()) {
+        trace_data->mem_blocks.resize(num_threads);
+      }
       for (uint32_t t = thread_start; t < num_threads; ++t) {
         if (!warp.tmask.test(t))
           continue;
         uint64_t mem_addr = rsdata[t][0].i + immsrc;
         uint64_t write_data = rsdata[t][1].u64;
         trace_data->mem_addrs.at(t) = {mem_addr, data_bytes};
+        if (!trace_data->mem_blocks.empty()) {
+          trace_data->mem_blocks.at(t) = MemChecker::block(mem_addr, &write_data, data_bytes, warp.PC, wid);
+        }
         switch (func3) {
         case 0:
         case 1:
@@ -759,7 +772,7 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
   }
   case Opcode::AMO: {
     trace->fu_type = FUType::LSU;
-    trace->lsu_type = LsuType::LOAD;
+    trace->lsu_type = LsuType::AMO;
     trace->src_regs[0] = {RegType::Integer, rsrc0};
     trace->src_regs[1] = {RegType::Integer, rsrc1};
     auto trace_data = std::make_shared<LsuTraceData>(num_threads);
@@ -767,11 +780,18 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
     auto amo_type = func7 >> 2;
     uint32_t data_bytes = 1 << (func3 & 0x3);
     uint32_t data_width = 8 * data_bytes;
+    if (MemChecker::instance().enabled()) {
+      trace_data->mem_blocks.resize(num_threads);
+    }
     for (uint32_t t = thread_start; t < num_threads; ++t) {
       if (!warp.tmask.test(t))
         continue;
       uint64_t mem_addr = rsdata[t][0].u;
       trace_data->mem_addrs.at(t) = {mem_addr, data_bytes};
+      if (!trace_data->mem_blocks.empty()) {
+        // atomics carry the bytes they write, nothing for LR or a failed SC
+        trace_data->mem_blocks.at(t) = std::make_shared<MemBlock>(mem_addr);
+      }
       if (amo_type == 0x02) { // LR
         uint64_t read_data = 0;
         this->dcache_read(&read_data, mem_addr, data_bytes);
@@ -781,6 +801,9 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
       if (amo_type == 0x03) { // SC
         if (this->dcache_amo_check(mem_addr)) {
           this->dcache_write(&rsdata[t][1].u64, mem_addr, data_bytes);
+          if (!trace_data->mem_blocks.empty()) {
+            trace_data->mem_blocks.at(t) = MemChecker::block(mem_addr, &rsdata[t][1].u64, data_bytes, warp.PC, wid);
+          }
           rddata[t].i = 0;
         } else {
           rddata[t].i = 1;
@@ -825,6 +848,9 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
           std::abort();
         }
         this->dcache_write(&result, mem_addr, data_bytes);
+        if (!trace_data->mem_blocks.empty()) {
+          trace_data->mem_blocks.at(t) = MemChecker::block(mem_addr, &result, data_bytes, warp.PC, wid);
+        }
         rddata[t].i = read_data_i;
       }
     }
@@ -1354,11 +1380,20 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
         }
 
         bool is_divergent = then_tmask.any() && else_tmask.any();
+
+        auto& split_stats = split_stats_[warp.PC];
+        ++split_stats.splits;
+        split_stats.lanes += warp.tmask.count();
+        ++perf_stats_.splits;
+        perf_stats_.split_lanes += warp.tmask.count();
+
         if (is_divergent) {
-          if (stack_size == ipdom_size_) {
-            std::cout << "IPDOM stack is full! size=" << stack_size << ", PC=0x" << std::hex << warp.PC << std::dec << " (#" << trace->uuid << ")\n" << std::flush;
+          if (warp.ipdom_stack.full()) {
+            std::cout << "IPDOM stack overflow! size=" << stack_size << ", PC=0x" << std::hex << warp.PC << std::dec << " (#" << trace->uuid << ")\n" << std::flush;
             std::abort();
           }
+          ++split_stats.divergent;
+          ++perf_stats_.divergent;
           // set new thread mask to the larger set
           if (then_tmask.count() >= else_tmask.count()) {
             next_tmask = then_tmask;
@@ -1367,7 +1402,7 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
           }
           // push reconvergence and not-taken thread mask onto the stack
           auto ntaken_tmask = ~next_tmask & warp.tmask;
-          warp.ipdom_stack.emplace(warp.tmask, ntaken_tmask, next_pc);
+          warp.ipdom_stack.push({warp.tmask, ntaken_tmask, next_pc, warp.PC, warp.instrs, false});
         }
         // return divergent state
         for (uint32_t t = thread_start; t < num_threads; ++t) {
@@ -1388,13 +1423,18 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
             std::cout << "IPDOM stack is empty!\n" << std::flush;
             std::abort();
           }
-          if (warp.ipdom_stack.top().fallthrough) {
-            next_tmask = warp.ipdom_stack.top().orig_tmask;
+          auto& entry = warp.ipdom_stack.top();
+          if (entry.fallthrough) {
+            // reconvergence
+            auto distance = warp.instrs - entry.split_instrs;
+            split_stats_[entry.split_PC].distance += distance;
+            perf_stats_.reconv_distance += distance;
+            next_tmask = entry.orig_tmask;
             warp.ipdom_stack.pop();
           } else {
-            next_tmask = warp.ipdom_stack.top().else_tmask;
-            next_pc = warp.ipdom_stack.top().PC;
-            warp.ipdom_stack.top().fallthrough = true;
+            next_tmask = entry.else_tmask;
+            next_pc = entry.PC;
+            entry.fallthrough = true;
           }
         }
       } break;
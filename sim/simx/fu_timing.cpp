@@ -0,0 +1,103 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fu_timing.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <VX_config.h>
+
+using namespace vortex;
+
+FuTiming::FuTiming() {
+  entries_ = {{
+    {2,             1,             1}, // alu
+    {LATENCY_IMUL,  1,             1}, // imul
+    {XLEN,          XLEN,          1}, // idiv
+    {LATENCY_FNCP,  1,             1}, // fncp
+    {LATENCY_FMA,   1,             1}, // fma
+    {LATENCY_FDIV,  LATENCY_FDIV,  1}, // fdiv
+    {LATENCY_FSQRT, LATENCY_FSQRT, 1}, // fsqrt
+    {LATENCY_FCVT,  1,             1}, // fcvt
+    {2,             1,             1}  // sfu
+  }};
+  auto path = getenv("VORTEX_FU_TIMING");
+  if (path != nullptr && path[0] != '\0') {
+    this->load(path);
+  }
+}
+
+void FuTiming::load(const char* path) {
+  std::ifstream ifs(path);
+  if (!ifs) {
+    printf("error: cannot open functional unit timing file: %s\n", path);
+    exit(-1);
+  }
+  std::string line;
+  uint32_t line_no = 0;
+  while (std::getline(ifs, line)) {
+    ++line_no;
+    std::istringstream iss(line);
+    std::string name;
+    if (!(iss >> name) || name[0] == '#')
+      continue;
+    int op_class = 0;
+    for (; op_class < (int)FuOpClass::Count; ++op_class) {
+      std::ostringstream oss;
+      oss << (FuOpClass)op_class;
+      if (oss.str() == name)
+        break;
+    }
+    entry_t entry;
+    if (op_class == (int)FuOpClass::Count
+     || !(iss >> entry.latency >> entry.interval >> entry.count)
+     || entry.interval == 0
+     || entry.count == 0) {
+      printf("error: invalid functional unit timing at %s:%d\n", path, line_no);
+      exit(-1);
+    }
+    entries_.at(op_class) = entry;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+FuOccupancy::FuOccupancy(uint32_t num_slots)
+  : busy_until_(num_slots * (int)FuOpClass::Count)
+{
+  auto& timing = FuTiming::instance();
+  for (uint32_t i = 0; i < busy_until_.size(); ++i) {
+    auto op_class = (FuOpClass)(i % (int)FuOpClass::Count);
+    busy_until_.at(i).resize(timing.get(op_class).count);
+  }
+  this->reset();
+}
+
+void FuOccupancy::reset() {
+  for (auto& units : busy_until_) {
+    std::fill(units.begin(), units.end(), 0);
+  }
+}
+
+bool FuOccupancy::acquire(uint32_t slot, FuOpClass op_class, uint64_t cycle) {
+  auto& units = busy_until_.at(slot * (int)FuOpClass::Count + (int)op_class);
+  for (auto& busy_until : units) {
+    if (busy_until <= cycle) {
+      busy_until = cycle + FuTiming::instance().get(op_class).interval;
+      return true;
+    }
+  }
+  return false;
+}
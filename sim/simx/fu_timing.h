@@ -0,0 +1,99 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <iostream>
+
+namespace vortex {
+
+// Functional unit operation classes with distinct timing
+enum class FuOpClass {
+  ALU,
+  IMUL,
+  IDIV,
+  FNCP,
+  FMA,
+  FDIV,
+  FSQRT,
+  FCVT,
+  SFU,
+  Count
+};
+
+inline std::ostream &operator<<(std::ostream &os, const FuOpClass& op_class) {
+  switch (op_class) {
+  case FuOpClass::ALU:   os << "alu"; break;
+  case FuOpClass::IMUL:  os << "imul"; break;
+  case FuOpClass::IDIV:  os << "idiv"; break;
+  case FuOpClass::FNCP:  os << "fncp"; break;
+  case FuOpClass::FMA:   os << "fma"; break;
+  case FuOpClass::FDIV:  os << "fdiv"; break;
+  case FuOpClass::FSQRT: os << "fsqrt"; break;
+  case FuOpClass::FCVT:  os << "fcvt"; break;
+  case FuOpClass::SFU:   os << "sfu"; break;
+  default: break;
+  }
+  return os;
+}
+
+// Per operation class timing table.
+// Defaults follow the hardware configuration, iterative dividers and square roots
+// are not pipelined. The table can be overridden at runtime from a text file:
+//   VORTEX_FU_TIMING=<file>
+// with one "<class> <latency> <initiation interval> <units per issue slot>" entry
+// per line, e.g. "fdiv 16 16 1". Lines starting with '#' are ignored.
+class FuTiming {
+public:
+  struct entry_t {
+    uint32_t latency;  // cycles until the result is available
+    uint32_t interval; // cycles before a unit accepts a new operation
+    uint32_t count;    // units per issue slot
+  };
+
+  static const FuTiming& instance() {
+    static FuTiming timing;
+    return timing;
+  }
+
+  const entry_t& get(FuOpClass op_class) const {
+    return entries_.at((int)op_class);
+  }
+
+private:
+
+  FuTiming();
+
+  void load(const char* path);
+
+  std::array<entry_t, (int)FuOpClass::Count> entries_;
+};
+
+// Tracks functional unit occupancy for structural hazards
+class FuOccupancy {
+public:
+  FuOccupancy(uint32_t num_slots);
+
+  void reset();
+
+  // claim a free unit of the given class for the operation, returns false if all units are busy
+  bool acquire(uint32_t slot, FuOpClass op_class, uint64_t cycle);
+
+private:
+  std::vector<std::vector<uint64_t>> busy_until_;
+};
+
+}
@@ -35,21 +35,27 @@ void AluUnit::tick() {
 		auto& output = Outputs.at(iw);
 		auto trace = input.front();
 		int delay = 2;
+		FuOpClass op_class;
 		switch (trace->alu_type) {
 		case AluType::ARITH:
 		case AluType::BRANCH:
 		case AluType::SYSCALL:
-			output.push(trace, 2+delay);
+			op_class = FuOpClass::ALU;
 			break;
 		case AluType::IMUL:
-			output.push(trace, LATENCY_IMUL+delay);
+			op_class = FuOpClass::IMUL;
 			break;
 		case AluType::IDIV:
-			output.push(trace, XLEN+delay);
+			op_class = FuOpClass::IDIV;
 			break;
 		default:
 			std::abort();
 		}
+		if (!this->acquire(iw, trace, op_class)) {
+			++core_->perf_stats_.alu_stalls;
+			continue;
+		}
+		output.push(trace, FuTiming::instance().get(op_class).latency + delay);
 		DT(3, this->name() << ": op=" << trace->alu_type << ", " << *trace);
 		if (trace->eop && trace->fetch_stall) {
 			core_->resume(trace->wid);
@@ -70,25 +76,31 @@ void FpuUnit::tick() {
 		auto& output = Outputs.at(iw);
 		auto trace = input.front();
 		int delay = 2;
+		FuOpClass op_class;
 		switch (trace->fpu_type) {
 		case FpuType::FNCP:
-			output.push(trace, 2+delay);
+			op_class = FuOpClass::FNCP;
 			break;
 		case FpuType::FMA:
-			output.push(trace, LATENCY_FMA+delay);
+			op_class = FuOpClass::FMA;
 			break;
 		case FpuType::FDIV:
-			output.push(trace, LATENCY_FDIV+delay);
+			op_class = FuOpClass::FDIV;
 			break;
 		case FpuType::FSQRT:
-			output.push(trace, LATENCY_FSQRT+delay);
+			op_class = FuOpClass::FSQRT;
 			break;
 		case FpuType::FCVT:
-			output.push(trace, LATENCY_FCVT+delay);
+			op_class = FuOpClass::FCVT;
 			break;
 		default:
 			std::abort();
 		}
+		if (!this->acquire(iw, trace, op_class)) {
+			++core_->perf_stats_.fpu_stalls;
+			continue;
+		}
+		output.push(trace, FuTiming::instance().get(op_class).latency + delay);
 		DT(3,this->name() << ": op=" << trace->fpu_type << ", " << *trace);
 		input.pop();
 	}
@@ -181,13 +193,20 @@ void LsuUnit::tick() {
 		// build memory request
 		LsuReq lsu_req(NUM_LSU_LANES);
 		lsu_req.write = is_write;
+		lsu_req.atomic = (trace->lsu_type == LsuType::AMO);
 		{
 			auto trace_data = std::dynamic_pointer_cast<LsuTraceData>(trace->data);
 			auto t0 = trace->pid * NUM_LSU_LANES;
+			if (!trace_data->mem_blocks.empty()) {
+				lsu_req.data.resize(NUM_LSU_LANES);
+			}
 			for (uint32_t i = 0; i < NUM_LSU_LANES; ++i) {
 				if (trace->tmask.test(t0 + i)) {
 					lsu_req.mask.set(i);
 					lsu_req.addrs.at(i) = trace_data->mem_addrs.at(t0 + i).addr;
+					if (!trace_data->mem_blocks.empty()) {
+						lsu_req.data.at(i) = trace_data->mem_blocks.at(t0 + i);
+					}
 				}
 			}
 		}
@@ -329,10 +348,15 @@ void SfuUnit::tick() {
 		auto trace = input.front();
 		auto sfu_type = trace->sfu_type;
 		bool release_warp = trace->fetch_stall;
+		if (!this->acquire(iw, trace, FuOpClass::SFU)) {
+			++core_->perf_stats_.sfu_stalls;
+			continue;
+		}
 		int delay = 2;
+		int latency = FuTiming::instance().get(FuOpClass::SFU).latency;
 		switch  (sfu_type) {
 		case SfuType::WSPAWN:
-			output.push(trace, 2+delay);
+			output.push(trace, latency+delay);
 			if (trace->eop) {
 				auto trace_data = std::dynamic_pointer_cast<SFUTraceData>(trace->data);
 				release_warp = core_->wspawn(trace_data->arg1, trace_data->arg2);
@@ -345,10 +369,10 @@ void SfuUnit::tick() {
 		case SfuType::CSRRW:
 		case SfuType::CSRRS:
 		case SfuType::CSRRC:
-			output.push(trace, 2+delay);
+			output.push(trace, latency+delay);
 			break;
 		case SfuType::BAR: {
-			output.push(trace, 2+delay);
+			output.push(trace, latency+delay);
 			if (trace->eop) {
 				auto trace_data = std::dynamic_pointer_cast<SFUTraceData>(trace->data);
 				release_warp = core_->barrier(trace_data->arg1, trace_data->arg2, trace->wid);
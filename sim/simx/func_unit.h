@@ -16,6 +16,7 @@
 #include <simobject.h>
 #include <array>
 #include "instr_trace.h"
+#include "fu_timing.h"
 
 namespace vortex {
 
@@ -31,16 +32,32 @@ public:
 		, Inputs(ISSUE_WIDTH, this)
 		, Outputs(ISSUE_WIDTH, this)
 		, core_(core)
+		, occupancy_(ISSUE_WIDTH)
 	{}
 
 	virtual ~FuncUnit() {}
 
-	virtual void reset() {}
+	virtual void reset() {
+		occupancy_.reset();
+	}
 
 	virtual void tick() = 0;
 
 protected:
+	// claim a unit for the operation, returns false on a structural hazard
+	bool acquire(uint32_t iw, instr_trace_t* trace, FuOpClass op_class) {
+		if (!occupancy_.acquire(iw, op_class, SimPlatform::instance().cycles())) {
+			if (!trace->log_once(true)) {
+				DT(4, "*** " << this->name() << "-busy: op=" << op_class << ", " << *trace);
+			}
+			return false;
+		}
+		trace->log_once(false);
+		return true;
+	}
+
 	Core* core_;
+	FuOccupancy occupancy_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -33,6 +33,7 @@ public:
 struct LsuTraceData : public ITraceData {
   using Ptr = std::shared_ptr<LsuTraceData>;
   std::vector<mem_addr_size_t> mem_addrs;
+  std::vector<MemBlock::Ptr> mem_blocks; // cache data mode only
   LsuTraceData(uint32_t num_threads) : mem_addrs(num_threads) {}
 };
 
@@ -26,6 +26,7 @@ protected:
 	RAM       ram_;
 	uint32_t 	line_bits_;
 	MemCrossBar::Ptr mem_xbar_;
+	std::vector<uint64_t> bank_busy_;
 	mutable PerfStats perf_stats_;
 
 	uint64_t to_local_addr(uint64_t addr) {
@@ -37,6 +38,7 @@ public:
 		: simobject_(simobject)
 		, config_(config)
 		, ram_(config.capacity)
+		, bank_busy_((1 << config.B), 0)
 	{
 		uint32_t total_lines = config.capacity / config.line_size;
 		line_bits_ = log2ceil(total_lines);
@@ -59,6 +61,7 @@ public:
 	virtual ~Impl() {}
 
 	void reset() {
+		std::fill(bank_busy_.begin(), bank_busy_.end(), 0);
 		perf_stats_ = PerfStats();
 	}
 
@@ -77,18 +80,32 @@ public:
 	void tick() {
 		// process bank requets from xbar
 		uint32_t num_banks = (1 << config_.B);
+		auto cycles = SimPlatform::instance().cycles();
 		for (uint32_t i = 0; i < num_banks; ++i) {
 			auto& xbar_req_out = mem_xbar_->ReqOut.at(i);
 			if (xbar_req_out.empty())
 				continue;
 
+			// wait while the bank executes an atomic read-modify-write
+			if (bank_busy_.at(i) > cycles) {
+				++perf_stats_.amo_stalls;
+				continue;
+			}
+
 			auto& bank_req = xbar_req_out.front();
 			DT(4, simobject_->name() << "-bank" << i << "-req : " << bank_req);
 
+			uint32_t delay = 1;
+			if (bank_req.atomic) {
+				delay += config_.amo_latency;
+				bank_busy_.at(i) = cycles + config_.amo_latency;
+				++perf_stats_.amos;
+			}
+
 			if (!bank_req.write || config_.write_reponse) {
 				// send xbar response
 				MemRsp bank_rsp{bank_req.tag, bank_req.cid, bank_req.uuid};
-				mem_xbar_->RspOut.at(i).push(bank_rsp, 1);
+				mem_xbar_->RspOut.at(i).push(bank_rsp, delay);
 			}
 
 			// update perf counters
@@ -104,6 +121,24 @@ public:
 		perf_stats_.bank_stalls = mem_xbar_->req_collisions();
 		return perf_stats_;
 	}
+
+	void save(CheckpointWriter& writer) const {
+		writer.section("LMEM");
+		ram_.for_each_page([&](uint64_t addr, const uint8_t* data, uint32_t size) {
+			writer.write_image(addr, data, size);
+		});
+		writer.end_image();
+	}
+
+	void load(CheckpointReader& reader) {
+		if (!reader.section("LMEM"))
+			return;
+		reader.read_image([&](uint64_t addr, const uint8_t* data, uint32_t size) {
+			if (addr < config_.capacity) {
+				ram_.write(data, addr, std::min<uint64_t>(size, config_.capacity - addr));
+			}
+		});
+	}
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -137,4 +172,12 @@ void LocalMem::tick() {
 
 const LocalMem::PerfStats& LocalMem::perf_stats() const {
   return impl_->perf_stats();
+}
+
+void LocalMem::save(CheckpointWriter& writer) const {
+  impl_->save(writer);
+}
+
+void LocalMem::load(CheckpointReader& reader) {
+  impl_->load(reader);
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
 
 #include <simobject.h>
 #include "types.h"
+#include "checkpoint.h"
 
 namespace vortex {
 
@@ -26,23 +27,30 @@ public:
     uint32_t num_reqs;
     uint32_t B; // log2 number of banks
     bool write_reponse;
+    uint32_t amo_latency; // bank occupancy of atomic operations
   };
 
   struct PerfStats {
     uint64_t reads;
     uint64_t writes;
     uint64_t bank_stalls;
+    uint64_t amos;
+    uint64_t amo_stalls;
 
     PerfStats()
       : reads(0)
       , writes(0)
       , bank_stalls(0)
+      , amos(0)
+      , amo_stalls(0)
     {}
 
     PerfStats& operator+=(const PerfStats& rhs) {
       this->reads += rhs.reads;
       this->writes += rhs.writes;
       this->bank_stalls += rhs.bank_stalls;
+      this->amos += rhs.amos;
+      this->amo_stalls += rhs.amo_stalls;
       return *this;
     }
   };
@@ -63,6 +71,10 @@ public:
 
   const PerfStats& perf_stats() const;
 
+  void save(CheckpointWriter& writer) const;
+
+  void load(CheckpointReader& reader);
+
 protected:
 
   class Impl;
@@ -18,6 +18,7 @@
 #include <fstream>
 #include <stdlib.h>
 #include <unistd.h>
+#include <getopt.h>
 #include <sys/stat.h>
 #include "processor.h"
 #include "mem.h"
@@ -29,7 +30,8 @@
 using namespace vortex;
 
 static void show_usage() {
-   std::cout << "Usage: [-c <cores>] [-w <warps>] [-t <threads>] [-v: vector-test] [-s: stats] [-h: help] <program>" << std::endl;
+   std::cout << "Usage: [-c <cores>] [-w <warps>] [-t <threads>] [-v: vector-test] [-s: stats] [-h: help]"
+             << " [--checkpoint-at=<cycle>] [--checkpoint=<file>] [--restore=<file>] <program>" << std::endl;
 }
 
 uint32_t num_threads = NUM_THREADS;
@@ -38,11 +40,30 @@ uint32_t num_cores = NUM_CORES;
 bool showStats = false;
 bool vector_test = false;
 const char* program = nullptr;
+uint64_t checkpoint_cycle = -1ull;
+const char* checkpoint_file = "simx.ckpt";
+const char* restore_file = nullptr;
+const char* replay_file = getenv("VORTEX_ITRACE_REPLAY");
 
 static void parse_args(int argc, char **argv) {
+  static const struct option long_options[] = {
+    {"checkpoint-at", required_argument, nullptr, 'C'},
+    {"checkpoint",    required_argument, nullptr, 'F'},
+    {"restore",       required_argument, nullptr, 'R'},
+    {nullptr, 0, nullptr, 0}
+  };
   	int c;
-  	while ((c = getopt(argc, argv, "t:w:c:vsh")) != -1) {
+  	while ((c = getopt_long(argc, argv, "t:w:c:vsh", long_options, nullptr)) != -1) {
     	switch (c) {
+      case 'C':
+        checkpoint_cycle = strtoull(optarg, nullptr, 0);
+        break;
+      case 'F':
+        checkpoint_file = optarg;
+        break;
+      case 'R':
+        restore_file = optarg;
+        break;
       case 't':
         num_threads = atoi(optarg);
         break;
@@ -71,6 +92,12 @@ static void parse_args(int argc, char **argv) {
 	if (optind < argc) {
 		program = argv[optind];
     std::cout << "Running " << program << "..." << std::endl;
+	} else if (restore_file) {
+    // the program is part of the checkpoint
+    std::cout << "Restoring " << restore_file << "..." << std::endl;
+	} else if (replay_file) {
+    // the instructions come from the trace
+    std::cout << "Replaying " << replay_file << "..." << std::endl;
 	} else {
 		show_usage();
     exit(-1);
@@ -103,8 +130,15 @@ int main(int argc, char **argv) {
   #endif
 	  processor.dcr_write(VX_DCR_BASE_MPM_CLASS, 0);
 
+    if (checkpoint_cycle != -1ull) {
+      processor.checkpoint(checkpoint_cycle, checkpoint_file);
+    }
+
     // load program
-    {
+    if (restore_file) {
+      if (processor.restore(restore_file) != 0)
+        return -1;
+    } else if (program) {
       std::string program_ext(fileExtension(program));
       if (program_ext == "bin") {
         ram.loadBinImage(program, startup_addr);
@@ -116,7 +150,7 @@ int main(int argc, char **argv) {
       }
     }
 #ifndef NDEBUG
-    std::cout << "[VXDRV] START: program=" << program << std::endl;
+    std::cout << "[VXDRV] START: program=" << (program ? program : (restore_file ? restore_file : replay_file)) << std::endl;
 #endif
     // run simulation
     // vector test exitcode is a special case
@@ -126,6 +160,14 @@ int main(int argc, char **argv) {
     // else continue as normal
     processor.run();
 
+    if (showStats) {
+      processor.show_stats();
+    }
+
+    // the kernel did not complete, or only its timing was replayed
+    if (processor.checkpointed() || replay_file)
+      return 0;
+
     // read exitcode from @MPM.1
     ram.read(&exitcode, (IO_MPM_ADDR + 8), 4);
   }
@@ -0,0 +1,146 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mem_checker.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace vortex;
+
+static const uint64_t BLOCK_MASK = ~uint64_t(MEM_BLOCK_SIZE - 1);
+
+MemChecker::MemChecker()
+  : enabled_(false)
+  , ram_(nullptr)
+  , checks_(0)
+  , mismatches_(0)
+{
+  auto enable_s = getenv("VORTEX_CACHE_CHECK");
+  if (enable_s) {
+    enabled_ = (atoi(enable_s) != 0);
+  }
+#ifdef VM_ENABLE
+  if (enabled_) {
+    printf("warning: cache data mode is not supported with virtual memory\n");
+    enabled_ = false;
+  }
+#endif
+}
+
+MemChecker::~MemChecker() {
+  if (!enabled_)
+    return;
+  printf("cache data check: loads=%ld, mismatches=%ld\n", checks_, mismatches_);
+}
+
+void MemChecker::attach_ram(RAM* ram) {
+  ram_ = ram;
+}
+
+void MemChecker::reset() {
+  image_.clear();
+}
+
+MemBlock::Ptr MemChecker::block(uint64_t addr, const void* data, uint32_t size, Word PC, uint32_t wid) {
+  auto base = addr & BLOCK_MASK;
+  if (((addr + size - 1) & BLOCK_MASK) != base)
+    return nullptr;
+  auto block = std::make_shared<MemBlock>(base);
+  auto offset = addr - base;
+  memcpy(block->data.data() + offset, data, size);
+  for (uint32_t i = 0; i < size; ++i) {
+    block->mask.set(offset + i);
+  }
+  block->PC  = PC;
+  block->wid = wid;
+  return block;
+}
+
+void MemChecker::load(uint64_t addr, MemBlock* block) {
+  block->addr = addr;
+  block->mask.reset();
+  if (ram_ == nullptr)
+    return;
+  try {
+    ram_->read(block->data.data(), addr, MEM_BLOCK_SIZE);
+    block->mask.set();
+  } catch (...) {
+    // unmapped or protected bytes are unknown
+  }
+}
+
+void MemChecker::preserve(uint64_t addr, uint32_t size) {
+  for (auto base = addr & BLOCK_MASK; base < addr + size; base += MEM_BLOCK_SIZE) {
+    if (image_.count(base) != 0)
+      continue;
+    this->load(base, &image_[base]);
+  }
+}
+
+void MemChecker::read(uint64_t addr, MemBlock* block) {
+  auto base = addr & BLOCK_MASK;
+  auto it = image_.find(base);
+  if (it != image_.end()) {
+    *block = it->second;
+  } else {
+    // blocks not yet written by the emulator still hold their initial value
+    this->load(base, block);
+  }
+}
+
+void MemChecker::write(uint64_t addr, const MemBlock::Ptr& block) {
+  auto base = addr & BLOCK_MASK;
+  auto it = image_.find(base);
+  if (it == image_.end()) {
+    it = image_.emplace(base, MemBlock(base)).first;
+    this->load(base, &it->second);
+  }
+  if (block) {
+    it->second.merge(*block);
+  } else {
+    // untracked write
+    it->second.mask.reset();
+  }
+}
+
+void MemChecker::check(const MemBlock& expected, const MemBlock& actual, const std::string& source) {
+  ++checks_;
+  auto mask = expected.mask & actual.mask;
+  int first = -1;
+  for (uint32_t i = 0; i < MEM_BLOCK_SIZE; ++i) {
+    if (mask.test(i) && expected.data[i] != actual.data[i]) {
+      first = i;
+      break;
+    }
+  }
+  if (first == -1)
+    return;
+  if (0 == mismatches_++) {
+    // report the bytes of the load from its first mismatching byte
+    uint32_t end = first;
+    while (end < MEM_BLOCK_SIZE && expected.mask.test(end) && (end - first) < 8) {
+      ++end;
+    }
+    printf("error: cache data mismatch in %s: addr=0x%lx, PC=0x%lx, wid=%d, expected=0x",
+      source.c_str(), expected.addr + first, uint64_t(expected.PC), expected.wid);
+    for (uint32_t i = end; i-- > uint32_t(first);) {
+      printf("%02x", expected.data[i]);
+    }
+    printf(", actual=0x");
+    for (uint32_t i = end; i-- > uint32_t(first);) {
+      printf("%02x", actual.data[i]);
+    }
+    printf("\n");
+  }
+}
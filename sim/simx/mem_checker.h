@@ -0,0 +1,80 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <mem.h>
+#include "types.h"
+
+namespace vortex {
+
+// Cache data mode checker.
+// When enabled, cache lines and the memory model carry data: stores update the
+// simulated hierarchy in timing order, and each load is compared when it is
+// served against the value the emulator read from RAM at execution.
+// The first divergence is reported with its PC and warp, stale lines, missing
+// fences and data races show up as mismatches.
+// Scalar loads, stores and atomics are tracked; other memory operations make the
+// bytes they write unknown, and unknown bytes are never compared.
+// The checker is controlled from the environment:
+//   VORTEX_CACHE_CHECK=1   enable the cache data mode
+class MemChecker {
+public:
+  static MemChecker& instance() {
+    static MemChecker checker;
+    return checker;
+  }
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+  void attach_ram(RAM* ram);
+
+  void reset();
+
+  // build the payload of a memory operation, nullptr if it spans two blocks
+  static MemBlock::Ptr block(uint64_t addr, const void* data, uint32_t size, Word PC, uint32_t wid);
+
+  // save the block contents before the emulator updates RAM
+  void preserve(uint64_t addr, uint32_t size);
+
+  // memory model accesses, in timing order
+  void read(uint64_t addr, MemBlock* block);
+  void write(uint64_t addr, const MemBlock::Ptr& block);
+
+  // compare the bytes observed by a load with the bytes served by the memory system
+  void check(const MemBlock& expected, const MemBlock& actual, const std::string& source);
+
+  uint64_t mismatches() const {
+    return mismatches_;
+  }
+
+private:
+
+  MemChecker();
+  ~MemChecker();
+
+  void load(uint64_t addr, MemBlock* block);
+
+  bool enabled_;
+  RAM* ram_;
+  std::unordered_map<uint64_t, MemBlock> image_;
+  uint64_t checks_;
+  uint64_t mismatches_;
+};
+
+}
@@ -109,6 +109,13 @@ void MemCoalescer::tick() {
       uint64_t seed_addr = in_req.addrs.at(i) & addr_mask;
       cur_mask.set(i);
 
+      // atomics are executed per lane, never coalesce them
+      if (in_req.atomic) {
+        out_mask.set(o);
+        out_addrs.at(o) = seed_addr;
+        break;
+      }
+
       // coalesce matching requests
       for (uint32_t s = r + 1; s < output_ratio_; ++s) {
         uint32_t j = o * output_ratio_ + s;
@@ -139,10 +146,38 @@ void MemCoalescer::tick() {
   out_req.mask = out_mask;
   out_req.tag = tag;
   out_req.write = in_req.write;
+  out_req.atomic = in_req.atomic;
   out_req.addrs = out_addrs;
   out_req.cid = in_req.cid;
   out_req.uuid = in_req.uuid;
 
+  // merge the lane payloads (cache data mode)
+  if (!in_req.data.empty()) {
+    out_req.data.resize(output_size_);
+    for (uint32_t o = 0; o < output_size_; ++o) {
+      if (!out_mask.test(o))
+        continue;
+      MemBlock::Ptr block;
+      for (uint32_t r = 0; r < output_ratio_; ++r) {
+        uint32_t i = o * output_ratio_ + r;
+        if (!cur_mask.test(i))
+          continue;
+        auto& lane_data = in_req.data.at(i);
+        if (!lane_data) {
+          // untracked lane
+          block = nullptr;
+          break;
+        }
+        if (!block) {
+          block = std::make_shared<MemBlock>(*lane_data);
+        } else {
+          block->merge(*lane_data);
+        }
+      }
+      out_req.data.at(o) = block;
+    }
+  }
+
   // send memory request
   ReqOut.push(out_req, delay_);
   DT(4, this->name() << "-mem-req: coalesced=" << cur_mask.count() << ", " << out_req);
@@ -20,6 +20,7 @@
 #include "constants.h"
 #include "types.h"
 #include "debug.h"
+#include "mem_checker.h"
 
 using namespace vortex;
 
@@ -34,6 +35,7 @@ private:
 		MemSim::Impl* memsim;
 		MemReq request;
 		uint32_t bank_id;
+		MemBlock::Ptr data;
 	};
 
 public:
@@ -78,7 +80,24 @@ public:
 			auto& mem_req = mem_xbar_->ReqOut.at(i).front();
 
 			// enqueue the request to the memory system
-			auto req_args = new DramCallbackArgs{this, mem_req, i};
+			auto req_args = new DramCallbackArgs{this, mem_req, i, nullptr};
+
+			// cache data mode: memory is updated in request order
+			auto& checker = MemChecker::instance();
+			if (checker.enabled()) {
+				if (mem_req.write) {
+					checker.write(mem_req.addr, mem_req.data);
+				} else {
+					if (mem_req.atomic && mem_req.data) {
+						checker.write(mem_req.addr, mem_req.data);
+					}
+					req_args->data = std::make_shared<MemBlock>();
+					checker.read(mem_req.addr, req_args->data.get());
+					if (mem_req.data && !mem_req.atomic) {
+						checker.check(*mem_req.data, *req_args->data, simobject_->name());
+					}
+				}
+			}
 			dram_sim_.send_request(
 				mem_req.addr,
 				mem_req.write,
@@ -87,6 +106,7 @@ public:
 					if (!rsp_args->request.write) {
 						// only send a response for read requests
 						MemRsp mem_rsp{rsp_args->request.tag, rsp_args->request.cid, rsp_args->request.uuid};
+						mem_rsp.data = rsp_args->data;
 						rsp_args->memsim->mem_xbar_->RspOut.at(rsp_args->bank_id).push(mem_rsp, 1);
 						DT(3, rsp_args->memsim->simobject_->name() << "-mem-rsp[" << rsp_args->bank_id << "]: " << mem_rsp);
 					}
@@ -13,66 +13,174 @@
 
 #pragma once
 
+#include <deque>
 #include "instr_trace.h"
+#include "timeline.h"
 
 namespace vortex {
 
+// Operand collector stage.
+// Each issued instruction is allocated a collector unit that gathers its source
+// operands from a banked register file. Every bank serves a limited number of reads
+// per cycle, older collectors having priority; denied reads are bank-conflict stalls.
+// Issue stalls when all collectors are allocated.
 class Operand : public SimObject<Operand> {
-private:
-		static constexpr uint32_t NUM_BANKS = 4;
-		uint32_t total_stalls_ = 0;
-
 public:
-    SimPort<instr_trace_t*> Input;
-    SimPort<instr_trace_t*> Output;
-
-    Operand(const SimContext& ctx)
-			: SimObject<Operand>(ctx, "Operand")
-			, Input(this)
-			, Output(this)
-    {
-			total_stalls_ = 0;
+	enum BankMap {
+		RegIndex = 0, // bank = reg % num_banks
+		WarpSkew = 1  // bank = (reg + wid) % num_banks
+	};
+
+	SimPort<instr_trace_t*> Output;
+
+	Operand(const SimContext& ctx,
+					uint32_t num_banks,
+					uint32_t bank_ports,
+					uint32_t num_collectors,
+					uint32_t bank_map)
+		: SimObject<Operand>(ctx, "Operand")
+		, Output(this)
+		, Input_(this)
+		, num_banks_(num_banks)
+		, bank_ports_(bank_ports)
+		, num_collectors_(num_collectors)
+		, bank_map_(bank_map)
+		, bank_reads_(num_banks)
+	{
+		this->reset();
+	}
+
+	virtual ~Operand() {}
+
+	virtual void reset() {
+		collectors_.clear();
+		reserved_ = 0;
+		bank_stalls_ = 0;
+		collector_stalls_ = 0;
+	}
+
+	virtual void tick() {
+		// allocate a collector to the incoming instruction
+		if (!Input_.empty()) {
+			auto trace = Input_.front();
+			collector_t collector{trace, 0};
+			for (uint32_t i = 0; i < NUM_SRC_REGS; ++i) {
+				auto& reg = trace->src_regs.at(i);
+				// x0 is hardwired and needs no bank read
+				if (reg.type == RegType::None
+				 || (reg.type == RegType::Integer && reg.idx == 0))
+					continue;
+				collector.pending |= (1 << i);
+			}
+			collectors_.push_back(collector);
+			Input_.pop();
 		}
 
-    virtual ~Operand() {}
-
-    virtual void reset() {
-			total_stalls_ = 0;
+		// arbitrate bank read ports, oldest collectors first
+		std::fill(bank_reads_.begin(), bank_reads_.end(), 0);
+		for (auto& collector : collectors_) {
+			auto trace = collector.trace;
+			uint32_t conflicts = 0;
+			for (uint32_t i = 0; i < NUM_SRC_REGS; ++i) {
+				if (!(collector.pending & (1 << i)))
+					continue;
+				auto& reg = trace->src_regs.at(i);
+				auto& reads = bank_reads_.at(this->bank_id(reg.idx, trace->wid));
+				if (reads < bank_ports_) {
+					++reads;
+					// duplicate source registers share the read
+					for (uint32_t j = i; j < NUM_SRC_REGS; ++j) {
+						auto& other = trace->src_regs.at(j);
+						if (other.type == reg.type && other.idx == reg.idx) {
+							collector.pending &= ~(1 << j);
+						}
+					}
+				} else {
+					++conflicts;
+				}
+			}
+			if (conflicts != 0) {
+				bank_stalls_ += conflicts;
+				if (!trace->log_once(true)) {
+					DT(4, "*** operand-stall: bank conflicts=" << conflicts << ", " << *trace);
+					auto& timeline = Timeline::instance();
+					if (timeline.active()) {
+						timeline.record(Timeline::Stall, trace->cid, trace->wid, trace->uuid, Timeline::Operand);
+					}
+				}
+			}
 		}
 
-    virtual void tick() {
-			if (Input.empty())
-				return;
-			auto trace = Input.front();
-
-			uint32_t stalls = 0;
-
-			for (int i = 0; i < NUM_SRC_REGS; ++i) {
-				for (int j = i + 1; j < NUM_SRC_REGS; ++j) {
-					int bank_i = trace->src_regs[i].idx % NUM_BANKS;
-					int bank_j = trace->src_regs[j].idx % NUM_BANKS;
-					if ((trace->src_regs[i].type != RegType::None)
-					 && (trace->src_regs[j].type != RegType::None)
-					 && (trace->src_regs[i].idx != 0)
-					 && (trace->src_regs[j].idx != 0)
-					 && bank_i == bank_j) {
-						++stalls;
-					}
+		// release a completed collector, preserving program order per warp
+		for (auto it = collectors_.begin(); it != collectors_.end(); ++it) {
+			if (it->pending != 0)
+				continue;
+			auto trace = it->trace;
+			bool blocked = false;
+			for (auto prev = collectors_.begin(); prev != it; ++prev) {
+				if (prev->trace->wid == trace->wid) {
+					blocked = true;
+					break;
 				}
 			}
+			if (blocked)
+				continue;
+			trace->log_once(false);
+			Output.push(trace, 2);
+			DT(3, "pipeline-operands: " << *trace);
+			collectors_.erase(it);
+			--reserved_;
+			break;
+		}
+	};
 
-			total_stalls_ += stalls;
+	// reserve a collector and send the instruction, returns false if all collectors are allocated
+	bool push(instr_trace_t* trace) {
+		if (reserved_ >= num_collectors_) {
+			++collector_stalls_;
+			return false;
+		}
+		++reserved_;
+		Input_.push(trace, 2);
+		return true;
+	}
 
-			Output.push(trace, 2 + stalls);
+	uint64_t bank_stalls() const {
+		return bank_stalls_;
+	}
 
-			DT(3, "pipeline-operands: " << *trace);
+	uint64_t collector_stalls() const {
+		return collector_stalls_;
+	}
+
+	uint64_t total_stalls() const {
+		return bank_stalls_ + collector_stalls_;
+	}
+
+private:
 
-			Input.pop();
-    };
+	struct collector_t {
+		instr_trace_t* trace;
+		uint32_t pending; // source operands not yet read
+	};
 
-		uint32_t total_stalls() const {
-			return total_stalls_;
+	uint32_t bank_id(uint32_t reg, uint32_t wid) const {
+		switch (bank_map_) {
+		case WarpSkew: return (reg + wid) % num_banks_;
+		default:       return reg % num_banks_;
 		}
+	}
+
+	SimPort<instr_trace_t*> Input_;
+	uint32_t num_banks_;
+	uint32_t bank_ports_;
+	uint32_t num_collectors_;
+	uint32_t bank_map_;
+	std::deque<collector_t> collectors_;
+	std::vector<uint32_t> bank_reads_;
+	uint32_t reserved_;
+	uint64_t bank_stalls_;
+	uint64_t collector_stalls_;
 };
 
-}
\ No newline at end of file
+}
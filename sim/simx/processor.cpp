@@ -13,12 +13,21 @@
 
 #include "processor.h"
 #include "processor_impl.h"
+#include "timeline.h"
+#include "mem_checker.h"
+#include "cosim.h"
+#include "sampler.h"
+#include "trace_log.h"
 
 using namespace vortex;
 
 ProcessorImpl::ProcessorImpl(const Arch& arch)
   : arch_(arch)
   , clusters_(arch.num_clusters())
+  , perf_stream_(nullptr)
+  , ram_(nullptr)
+  , checkpoint_cycle_(-1ull)
+  , checkpointed_(false)
 {
   SimPlatform::instance().initialize();
 
@@ -53,6 +62,8 @@ ProcessorImpl::ProcessorImpl(const Arch& arch)
     false,                    // write response
     L3_MSHR_SIZE,             // mshr size
     2,                        // pipeline latency
+    (AMO_CACHE_LEVEL <= 3),   // execute atomics
+    AMO_LATENCY,              // atomic latency
     }
   );
 
@@ -96,6 +107,9 @@ ProcessorImpl::ProcessorImpl(const Arch& arch)
             << ", num_barriers=" << arch.num_barriers()
             << std::endl;
 #endif
+  Cosim::instance().open(arch.num_threads());
+  TraceLog::instance().open(arch);
+
   // reset the device
   this->reset();
 }
@@ -105,9 +119,11 @@ ProcessorImpl::~ProcessorImpl() {
 }
 
 void ProcessorImpl::attach_ram(RAM* ram) {
+  ram_ = ram;
   for (auto cluster : clusters_) {
     cluster->attach_ram(ram);
   }
+  MemChecker::instance().attach_ram(ram);
 }
 #ifdef VM_ENABLE
 void ProcessorImpl::set_satp(uint64_t satp) {
@@ -123,8 +139,39 @@ int ProcessorImpl::run() {
 
   bool done;
   int exitcode = 0;
+  uint64_t cycles = 0;
+  if (restore_) {
+    // resume the checkpointed processor state
+    cycles = restore_->cycle();
+    for (auto cluster : clusters_) {
+      cluster->load(*restore_);
+    }
+    l3cache_->load(*restore_);
+    int err = restore_->close();
+    restore_.reset();
+    if (err != 0) {
+      printf("error: checkpoint restore failed\n");
+      return -1;
+    }
+    printf("checkpoint: restored at cycle %ld\n", cycles);
+  }
+  this->preload();
+  checkpointed_ = false;
+  bool draining = false;
+  auto& sampler = Sampler::instance();
+  bool sample_draining = false;
   do {
-    SimPlatform::instance().tick();
+    bool functional = sampler.enabled() && (sampler.phase() == Sampler::Functional);
+    if (functional) {
+      // fast-forward without timing
+      for (auto cluster : clusters_) {
+        cluster->emulate(sampler.warming());
+      }
+    } else {
+      SimPlatform::instance().tick();
+      Timeline::instance().tick();
+      ++cycles;
+    }
     done = true;
     for (auto cluster : clusters_) {
       if (cluster->running()) {
@@ -136,8 +183,62 @@ int ProcessorImpl::run() {
     #endif
     }
     perf_mem_latency_ += perf_mem_pending_reads_;
+    if (perf_stream_ && (done || (!functional && 0 == (cycles % perf_stream_->interval())))) {
+      this->perf_sample(cycles);
+    }
+    // close the sample once the pipeline drained
+    if (sampler.enabled() && !functional) {
+      Sampler::counters_t counters = {cycles, perf_mem_reads_, perf_mem_writes_};
+      sampler.tick(counters);
+      if (sampler.phase() == Sampler::Drain) {
+        if (!sample_draining) {
+          for (auto cluster : clusters_) {
+            cluster->drain(true);
+          }
+          sample_draining = true;
+        }
+        if (this->drained()) {
+          sampler.end_sample(counters);
+          for (auto cluster : clusters_) {
+            cluster->drain(false);
+          }
+          sample_draining = false;
+        }
+      }
+    }
+    // stop at the first divergence from the RTL
+    if (Cosim::instance().failed())
+      break;
+    // checkpoint once the machine is quiescent
+    if (cycles >= checkpoint_cycle_ && !done) {
+      if (!draining) {
+        for (auto cluster : clusters_) {
+          cluster->drain(true);
+        }
+        draining = true;
+      }
+      if (this->drained()) {
+        exitcode = this->save(cycles);
+        checkpointed_ = (exitcode == 0);
+        break;
+      }
+    }
   } while (!done);
 
+  // the kernel ended inside a sample
+  if (sampler.enabled()
+   && (sampler.phase() == Sampler::Measure || sampler.phase() == Sampler::Drain)) {
+    Sampler::counters_t counters = {cycles, perf_mem_reads_, perf_mem_writes_};
+    sampler.end_sample(counters);
+    for (auto cluster : clusters_) {
+      cluster->drain(false);
+    }
+  }
+
+  Cosim::instance().end_run();
+  TraceLog::instance().end_run();
+  Timeline::instance().flush();
+
   return exitcode;
 }
 
@@ -146,12 +247,119 @@ void ProcessorImpl::reset() {
   perf_mem_writes_ = 0;
   perf_mem_latency_ = 0;
   perf_mem_pending_reads_ = 0;
+  // the host may have updated memory since the last run
+  MemChecker::instance().reset();
+}
+
+bool ProcessorImpl::drained() const {
+  for (auto cluster : clusters_) {
+    if (!cluster->drained())
+      return false;
+  }
+  return SimPlatform::instance().idle();
+}
+
+void ProcessorImpl::warm(uint64_t addr, bool write) {
+  l3cache_->warm(addr, write);
+}
+
+int ProcessorImpl::cache_warm(uint64_t addr, uint64_t size, uint32_t level) {
+  if (level < 1 || level > 3 || size == 0)
+    return -1;
+  warm_ranges_.push_back({addr, size, level});
+  return 0;
+}
+
+void ProcessorImpl::preload() {
+  // the lines are loaded after the reset so they are resident at the start of the run
+  for (auto& range : warm_ranges_) {
+    uint64_t end = range.addr + range.size;
+    for (uint64_t addr = range.addr & ~uint64_t(L1_LINE_SIZE-1); addr < end; addr += L1_LINE_SIZE) {
+      if (range.level == 3) {
+        this->warm(addr, false);
+      } else {
+        for (auto cluster : clusters_) {
+          cluster->preload(addr, range.level);
+        }
+      }
+    }
+  }
+  warm_ranges_.clear();
+}
+
+void ProcessorImpl::checkpoint(uint64_t cycle, const char* path) {
+  checkpoint_cycle_ = cycle;
+  checkpoint_path_ = path;
+}
+
+int ProcessorImpl::save(uint64_t cycle) {
+  CheckpointWriter writer;
+  if (writer.open(checkpoint_path_.c_str(), arch_, cycle) != 0)
+    return -1;
+  writer.section("DCRS");
+  writer.write(dcrs_);
+  writer.section("RAM");
+  ram_->for_each_page([&](uint64_t addr, const uint8_t* data, uint32_t size) {
+    writer.write_image(addr, data, size);
+  });
+  writer.end_image();
+  for (auto cluster : clusters_) {
+    cluster->save(writer);
+  }
+  l3cache_->save(writer);
+  if (writer.close() != 0)
+    return -1;
+  printf("checkpoint: saved %s at cycle %ld\n", checkpoint_path_.c_str(), cycle);
+  return 0;
+}
+
+int ProcessorImpl::restore(const char* path) {
+  auto reader = std::make_unique<CheckpointReader>();
+  if (reader->open(path, arch_) != 0)
+    return -1;
+  if (!reader->section("DCRS"))
+    return -1;
+  reader->read(&dcrs_);
+  if (!reader->section("RAM"))
+    return -1;
+  reader->read_image([&](uint64_t addr, const uint8_t* data, uint32_t size) {
+    ram_->write(data, addr, size);
+  });
+  if (reader->failed())
+    return -1;
+  restore_ = std::move(reader);
+  return 0;
 }
 
 void ProcessorImpl::dcr_write(uint32_t addr, uint32_t value) {
   dcrs_.write(addr, value);
 }
 
+void ProcessorImpl::attach_perf_stream(PerfStream* stream) {
+  perf_stream_ = stream;
+}
+
+void ProcessorImpl::show_stats() const {
+  for (auto cluster : clusters_) {
+    cluster->show_stats();
+  }
+  l3cache_->show_stats();
+}
+
+void ProcessorImpl::perf_sample(uint64_t cycles) {
+  PerfStream::sample_t sample = {};
+  sample.values[PerfStream::CYCLES] = cycles;
+  for (auto cluster : clusters_) {
+    cluster->perf_sample(&sample);
+  }
+  auto& l3cache_perf = l3cache_->perf_stats();
+  sample.values[PerfStream::L3CACHE_MISSES] = l3cache_perf.read_misses + l3cache_perf.write_misses;
+  sample.values[PerfStream::MEM_READS]   = perf_mem_reads_;
+  sample.values[PerfStream::MEM_WRITES]  = perf_mem_writes_;
+  sample.values[PerfStream::MEM_LATENCY] = perf_mem_latency_;
+  perf_stream_->push(sample);
+}
+
 ProcessorImpl::PerfStats ProcessorImpl::perf_stats() const {
   ProcessorImpl::PerfStats perf;
   perf.mem_reads   = perf_mem_reads_;
@@ -192,6 +400,30 @@ void Processor::dcr_write(uint32_t addr, uint32_t value) {
   return impl_->dcr_write(addr, value);
 }
 
+void Processor::attach_perf_stream(PerfStream* stream) {
+  impl_->attach_perf_stream(stream);
+}
+
+void Processor::show_stats() const {
+  impl_->show_stats();
+}
+
+void Processor::checkpoint(uint64_t cycle, const char* path) {
+  impl_->checkpoint(cycle, path);
+}
+
+bool Processor::checkpointed() const {
+  return impl_->checkpointed();
+}
+
+int Processor::restore(const char* path) {
+  return impl_->restore(path);
+}
+
+int Processor::cache_warm(uint64_t addr, uint64_t size, uint32_t level) {
+  return impl_->cache_warm(addr, size, level);
+}
+
 #ifdef VM_ENABLE
 int16_t Processor::set_satp_by_addr(uint64_t base_addr) {
   uint16_t asid = 0;
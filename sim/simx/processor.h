@@ -16,6 +16,7 @@
 #include <stdint.h>
 #include <VX_config.h>
 #include <mem.h>
+#include <perf_stream.h>
 
 namespace vortex {
 
@@ -36,6 +37,25 @@ public:
   int run();
 
   void dcr_write(uint32_t addr, uint32_t value);
+
+  void attach_perf_stream(PerfStream* stream);
+
+  void show_stats() const;
+
+  // save the simulation state to <path> once <cycle> is reached, ending the run
+  void checkpoint(uint64_t cycle, const char* path);
+
+  // true if the last run ended with a checkpoint
+  bool checkpointed() const;
+
+  // resume from a checkpoint, loads memory and device configuration now and
+  // the processor state at the next run
+  int restore(const char* path);
+
+  // load the lines of [addr, addr+size) into the caches at the next run,
+  // <level> 1 fills the core data caches, 2 the L2 caches, 3 the L3 cache,
+  // the levels below are filled as well
+  int cache_warm(uint64_t addr, uint64_t size, uint32_t level);
 #ifdef VM_ENABLE
   bool is_satp_unset();
   uint8_t get_satp_mode();
@@ -18,6 +18,7 @@
 #include "constants.h"
 #include "dcrs.h"
 #include "cluster.h"
+#include "checkpoint.h"
 
 namespace vortex {
 
@@ -40,6 +41,23 @@ public:
 
   void dcr_write(uint32_t addr, uint32_t value);
 
+  void attach_perf_stream(PerfStream* stream);
+
+  void show_stats() const;
+
+  // functional L3 access
+  void warm(uint64_t addr, bool write);
+
+  void checkpoint(uint64_t cycle, const char* path);
+
+  bool checkpointed() const {
+    return checkpointed_;
+  }
+
+  int restore(const char* path);
+
+  int cache_warm(uint64_t addr, uint64_t size, uint32_t level);
+
 #ifdef VM_ENABLE
   void set_satp(uint64_t satp);
 #endif
@@ -50,6 +68,14 @@ private:
 
   void reset();
 
+  void preload();
+
+  void perf_sample(uint64_t cycles);
+
+  bool drained() const;
+
+  int save(uint64_t cycle);
+
   const Arch& arch_;
   std::vector<std::shared_ptr<Cluster>> clusters_;
   DCRS dcrs_;
@@ -59,6 +85,19 @@ private:
   uint64_t perf_mem_writes_;
   uint64_t perf_mem_latency_;
   uint64_t perf_mem_pending_reads_;
+  PerfStream* perf_stream_;
+  RAM* ram_;
+  uint64_t checkpoint_cycle_;
+  std::string checkpoint_path_;
+  bool checkpointed_;
+  std::unique_ptr<CheckpointReader> restore_;
+
+  struct warm_range_t {
+    uint64_t addr;
+    uint64_t size;
+    uint32_t level;
+  };
+  std::vector<warm_range_t> warm_ranges_;
 };
 
 }
@@ -0,0 +1,298 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sampler.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+using namespace vortex;
+
+static const char* COUNTER_NAMES[] = {"cycles", "mem_reads", "mem_writes"};
+
+static uint64_t env_instrs(const char* name, uint64_t default_value) {
+  auto value_s = getenv(name);
+  if (value_s == nullptr)
+    return default_value;
+  return strtoull(value_s, nullptr, 0);
+}
+
+Sampler::Sampler()
+  : enabled_(false)
+  , phase_(Functional)
+  , interval_(env_instrs("VORTEX_SIMPOINT_INTERVAL", 100000))
+  , warmup_(env_instrs("VORTEX_SIMPOINT_WARMUP", 10000))
+  , instrs_(0)
+  , thread_instrs_(0)
+  , next_instrs_(-1ull)
+  , bbv_file_(nullptr)
+  , intervals_(0)
+  , point_idx_(0)
+  , started_(false)
+  , start_instrs_(0)
+  , start_counters_()
+{
+  if (interval_ == 0) {
+    interval_ = 1;
+  }
+  auto bbv_path = getenv("VORTEX_BBV");
+  auto points_path = getenv("VORTEX_SIMPOINTS");
+  if (bbv_path) {
+    bbv_file_ = fopen(bbv_path, "w");
+    if (bbv_file_ == nullptr) {
+      printf("error: cannot create basic block vectors file: %s\n", bbv_path);
+      std::abort();
+    }
+    enabled_ = true;
+  } else if (points_path) {
+    if (this->load_points(points_path) != 0) {
+      std::abort();
+    }
+    enabled_ = true;
+    this->seek();
+  }
+}
+
+Sampler::~Sampler() {
+  if (!enabled_)
+    return;
+  if (bbv_file_) {
+    this->write_bbv();
+    fclose(bbv_file_);
+    printf("simpoint: intervals=%ld, instrs=%ld\n", intervals_, instrs_);
+  } else {
+    this->report();
+  }
+}
+
+int Sampler::load_points(const char* path) {
+  std::ifstream ifs(path);
+  if (!ifs) {
+    printf("error: cannot open simulation points: %s\n", path);
+    return -1;
+  }
+  std::string line;
+  while (std::getline(ifs, line)) {
+    if (line.empty() || line[0] == '#')
+      continue;
+    std::stringstream ss(line);
+    point_t point;
+    if (!(ss >> point.interval >> point.cluster >> point.weight)) {
+      printf("error: invalid simulation point: %s\n", line.c_str());
+      return -1;
+    }
+    points_.push_back(point);
+  }
+  std::sort(points_.begin(), points_.end(), [](const point_t& a, const point_t& b) {
+    return a.interval < b.interval;
+  });
+  return 0;
+}
+
+void Sampler::profile(uint32_t gwid, uint64_t PC) {
+  if (gwid >= warps_.size()) {
+    warps_.resize(gwid + 1, warp_t{-1ull, 0});
+  }
+  // a basic block starts at the target of a control transfer
+  auto& warp = warps_.at(gwid);
+  if (PC != warp.next_PC) {
+    auto it = block_ids_.emplace(PC, block_ids_.size() + 1).first;
+    warp.block_id = it->second;
+  }
+  warp.next_PC = PC + 4;
+  ++bbv_[warp.block_id];
+  if (0 == (instrs_ % interval_)) {
+    this->write_bbv();
+  }
+}
+
+void Sampler::write_bbv() {
+  if (bbv_.empty())
+    return;
+  std::map<uint32_t, uint64_t> bbv(bbv_.begin(), bbv_.end());
+  fprintf(bbv_file_, "T");
+  for (auto& block : bbv) {
+    fprintf(bbv_file_, ":%d:%ld ", block.first, block.second);
+  }
+  fprintf(bbv_file_, "\n");
+  bbv_.clear();
+  ++intervals_;
+}
+
+void Sampler::advance() {
+  while (instrs_ >= next_instrs_) {
+    auto& point = points_.at(point_idx_);
+    switch (phase_) {
+    case Functional:
+      phase_ = Warmup;
+      next_instrs_ = point.interval * interval_;
+      break;
+    case Warmup:
+      phase_ = Measure;
+      started_ = false;
+      next_instrs_ = (point.interval + 1) * interval_;
+      break;
+    default:
+      phase_ = Drain;
+      next_instrs_ = -1ull;
+      break;
+    }
+  }
+}
+
+void Sampler::tick(const counters_t& counters) {
+  if (phase_ != Measure || started_)
+    return;
+  started_ = true;
+  start_instrs_ = instrs_;
+  memcpy(start_counters_, counters, sizeof(counters_t));
+}
+
+void Sampler::end_sample(const counters_t& counters) {
+  if (started_) {
+    auto& point = points_.at(point_idx_);
+    sample_t sample;
+    sample.cluster = point.cluster;
+    sample.weight = point.weight;
+    sample.instrs = instrs_ - start_instrs_;
+    for (uint32_t i = 0; i < NUM_COUNTERS; ++i) {
+      sample.counters[i] = counters[i] - start_counters_[i];
+    }
+    if (sample.instrs != 0) {
+      samples_.push_back(sample);
+    }
+    started_ = false;
+  }
+  ++point_idx_;
+  this->seek();
+}
+
+void Sampler::seek() {
+  // skip the points already executed
+  while (point_idx_ < points_.size()
+      && points_.at(point_idx_).interval * interval_ < instrs_) {
+    ++point_idx_;
+  }
+  phase_ = Functional;
+  if (point_idx_ < points_.size()) {
+    auto start = points_.at(point_idx_).interval * interval_;
+    next_instrs_ = start - std::min(start, warmup_);
+    this->advance();
+  } else {
+    next_instrs_ = -1ull;
+  }
+}
+
+void Sampler::report() const {
+  if (samples_.empty()) {
+    printf("simpoint: no sample simulated, instrs=%ld\n", instrs_);
+    return;
+  }
+
+  // per-instruction rates of each cluster
+  struct cluster_t {
+    double weight;
+    uint64_t instrs;
+    counters_t counters;
+    std::vector<std::vector<double>> rates;
+  };
+  std::map<uint32_t, cluster_t> clusters;
+  uint64_t sampled_instrs = 0;
+  for (auto& sample : samples_) {
+    auto& cluster = clusters[sample.cluster];
+    if (cluster.rates.empty()) {
+      cluster.weight = sample.weight;
+      cluster.instrs = 0;
+      memset(cluster.counters, 0, sizeof(counters_t));
+      cluster.rates.resize(NUM_COUNTERS);
+    }
+    cluster.instrs += sample.instrs;
+    for (uint32_t i = 0; i < NUM_COUNTERS; ++i) {
+      cluster.counters[i] += sample.counters[i];
+      cluster.rates.at(i).push_back(double(sample.counters[i]) / sample.instrs);
+    }
+    sampled_instrs += sample.instrs;
+  }
+
+  // clusters without sample are left out
+  double total_weight = 0;
+  for (auto& it : clusters) {
+    total_weight += it.second.weight;
+  }
+
+  auto sample_variance = [](const std::vector<double>& values, double mean) {
+    double s2 = 0;
+    for (auto value : values) {
+      s2 += (value - mean) * (value - mean);
+    }
+    return s2 / (values.size() - 1);
+  };
+
+  double estimates[NUM_COUNTERS];
+  double errors[NUM_COUNTERS];
+  bool has_errors[NUM_COUNTERS] = {};
+  for (uint32_t i = 0; i < NUM_COUNTERS; ++i) {
+    // stratified estimate, the variance of a cluster mean is taken from
+    // its samples, or from the pooled relative variance for single samples
+    double rate = 0, variance = 0, pooled_cv2 = 0;
+    uint32_t pooled_n = 0;
+    for (auto& it : clusters) {
+      auto& cluster = it.second;
+      double mean = double(cluster.counters[i]) / cluster.instrs;
+      rate += (cluster.weight / total_weight) * mean;
+      auto& rates = cluster.rates.at(i);
+      if (rates.size() < 2 || mean == 0)
+        continue;
+      pooled_cv2 += sample_variance(rates, mean) / (mean * mean);
+      ++pooled_n;
+    }
+    if (pooled_n != 0) {
+      pooled_cv2 /= pooled_n;
+      for (auto& it : clusters) {
+        auto& cluster = it.second;
+        double mean = double(cluster.counters[i]) / cluster.instrs;
+        auto& rates = cluster.rates.at(i);
+        double s2 = (rates.size() < 2) ? (pooled_cv2 * mean * mean) : sample_variance(rates, mean);
+        double w = cluster.weight / total_weight;
+        variance += w * w * s2 / rates.size();
+      }
+      has_errors[i] = true;
+    }
+    estimates[i] = rate * instrs_;
+    errors[i] = 1.96 * sqrt(variance) * instrs_;
+  }
+
+  printf("simpoint: samples=%ld, clusters=%ld, instrs=%ld, sampled=%ld (%.2f%%)\n",
+    samples_.size(), clusters.size(), instrs_, sampled_instrs, (100.0 * sampled_instrs) / instrs_);
+  for (uint32_t i = 0; i < NUM_COUNTERS; ++i) {
+    if (has_errors[i]) {
+      printf("simpoint: %s=%.0f +/-%.0f (95%%)\n", COUNTER_NAMES[i], estimates[i], errors[i]);
+    } else {
+      printf("simpoint: %s=%.0f\n", COUNTER_NAMES[i], estimates[i]);
+    }
+  }
+  double cycles = estimates[CYCLES];
+  if (cycles > 0) {
+    double ipc = thread_instrs_ / cycles;
+    if (has_errors[CYCLES] && errors[CYCLES] < cycles) {
+      printf("simpoint: IPC=%f [%f, %f]\n", ipc, thread_instrs_ / (cycles + errors[CYCLES]), thread_instrs_ / (cycles - errors[CYCLES]));
+    } else {
+      printf("simpoint: IPC=%f\n", ipc);
+    }
+  }
+}
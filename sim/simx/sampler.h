@@ -0,0 +1,153 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+namespace vortex {
+
+// SimPoint-style statistical sampling.
+// The execution is divided into intervals of a fixed number of warp
+// instructions, counted across the whole processor.
+// A profiling run executes the program functionally, without timing, and
+// writes the basic block vector of each interval in SimPoint's .bb format;
+// ci/simpoint.py clusters the vectors and selects representative intervals.
+// A sampled run executes functionally, updating the cache tags, up to each
+// selected interval, which is then simulated in detail after a short detailed
+// warm-up; the pipeline is drained at the end of the interval.
+// Cycles and memory traffic are extrapolated from the per-instruction rates
+// of the samples weighted by their cluster, with a 95% confidence interval
+// derived from the variation between samples of the same cluster.
+// The sampling is configured from the environment:
+//   VORTEX_BBV=<path>                  profiling run, basic block vectors output
+//   VORTEX_SIMPOINTS=<path>            sampled run, "<interval> <cluster> <cluster weight>" lines
+//   VORTEX_SIMPOINT_INTERVAL=<instrs>  interval size, default 100000
+//   VORTEX_SIMPOINT_WARMUP=<instrs>    detailed warm-up before a sample, default 10000
+class Sampler {
+public:
+  enum Phase {
+    Functional, // no timing
+    Warmup,     // detailed simulation before a sample
+    Measure,    // detailed simulation of a sample
+    Drain       // end of a sample, waiting for the pipeline to drain
+  };
+
+  enum Counter {
+    CYCLES,
+    MEM_READS,
+    MEM_WRITES,
+    NUM_COUNTERS
+  };
+
+  typedef uint64_t counters_t[NUM_COUNTERS];
+
+  static Sampler& instance() {
+    static Sampler sampler;
+    return sampler;
+  }
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+  Phase phase() const {
+    return phase_;
+  }
+
+  // functional execution with cache warm-up
+  bool warming() const {
+    return (phase_ == Functional) && (bbv_file_ == nullptr);
+  }
+
+  // record an executed instruction
+  void step(uint32_t gwid, uint64_t PC, uint32_t active_threads) {
+    ++instrs_;
+    thread_instrs_ += active_threads;
+    if (bbv_file_) {
+      this->profile(gwid, PC);
+    } else if (instrs_ >= next_instrs_) {
+      this->advance();
+    }
+  }
+
+  // called every detailed cycle
+  void tick(const counters_t& counters);
+
+  // the pipeline drained at the end of a sample or of the kernel
+  void end_sample(const counters_t& counters);
+
+private:
+
+  struct point_t {
+    uint64_t interval;
+    uint32_t cluster;
+    double   weight;
+  };
+
+  struct sample_t {
+    uint32_t cluster;
+    double   weight;
+    uint64_t instrs;
+    counters_t counters;
+  };
+
+  struct warp_t {
+    uint64_t next_PC;
+    uint32_t block_id;
+  };
+
+  Sampler();
+  ~Sampler();
+
+  int load_points(const char* path);
+
+  void profile(uint32_t gwid, uint64_t PC);
+
+  void write_bbv();
+
+  // schedule the warm-up of the next point
+  void seek();
+
+  void advance();
+
+  void report() const;
+
+  bool enabled_;
+  Phase phase_;
+  uint64_t interval_;
+  uint64_t warmup_;
+  uint64_t instrs_;
+  uint64_t thread_instrs_;
+  uint64_t next_instrs_;
+
+  // profiling
+  FILE* bbv_file_;
+  std::vector<warp_t> warps_;
+  std::unordered_map<uint64_t, uint32_t> block_ids_;
+  std::unordered_map<uint32_t, uint64_t> bbv_;
+  uint64_t intervals_;
+
+  // sampling
+  std::vector<point_t> points_;
+  uint32_t point_idx_;
+  bool started_;
+  uint64_t start_instrs_;
+  counters_t start_counters_;
+  std::vector<sample_t> samples_;
+};
+
+}
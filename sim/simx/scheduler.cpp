@@ -0,0 +1,306 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "scheduler.h"
+#include "instr_trace.h"
+#include <algorithm>
+
+using namespace vortex;
+
+// cache-aware throttling thresholds (L1 miss rate per feedback epoch)
+#define THROTTLE_MISS_HIGH    0.4
+#define THROTTLE_MISS_LOW     0.2
+#define THROTTLE_MIN_ACCESSES 64
+
+WarpScheduler::WarpScheduler(SchedPolicy policy, uint32_t num_warps)
+  : policy_(policy)
+  , num_warps_(num_warps)
+  , ages_(num_warps)
+  , warp_stats_(num_warps)
+{
+  this->reset();
+}
+
+void WarpScheduler::reset() {
+  for (auto& age : ages_) {
+    age = 0;
+  }
+  for (auto& stats : warp_stats_) {
+    stats = warp_stats_t{0, 0, 0};
+  }
+  active_.reset();
+  blocked_.reset();
+  age_ctr_ = 0;
+}
+
+int WarpScheduler::schedule(const WarpMask& ready, const WarpMask& active, const WarpMask& blocked) {
+  // track activation order for age-based policies
+  auto activated = active & ~active_;
+  if (activated.any()) {
+    for (uint32_t wid = 0; wid < num_warps_; ++wid) {
+      if (activated.test(wid)) {
+        ages_.at(wid) = age_ctr_++;
+      }
+    }
+  }
+  active_ = active;
+  blocked_ = blocked;
+
+  int scheduled = ready.any() ? this->select(ready) : -1;
+
+  // update histograms
+  for (uint32_t wid = 0; wid < num_warps_; ++wid) {
+    if (!active.test(wid))
+      continue;
+    auto& stats = warp_stats_.at(wid);
+    if (!ready.test(wid)) {
+      ++stats.stalled;
+    } else if ((int)wid != scheduled) {
+      ++stats.waiting;
+    }
+  }
+  if (scheduled != -1) {
+    ++warp_stats_.at(scheduled).issued;
+  }
+
+  return scheduled;
+}
+
+int WarpScheduler::oldest(const WarpMask& mask) const {
+  int found = -1;
+  for (uint32_t wid = 0; wid < num_warps_; ++wid) {
+    if (mask.test(wid) && (found == -1 || ages_.at(wid) < ages_.at(found))) {
+      found = wid;
+    }
+  }
+  return found;
+}
+
+int WarpScheduler::next(const WarpMask& mask, uint32_t start) const {
+  for (uint32_t i = 0; i < num_warps_; ++i) {
+    uint32_t wid = (start + i) % num_warps_;
+    if (mask.test(wid))
+      return wid;
+  }
+  return -1;
+}
+
+void WarpScheduler::dump_stats(std::ostream& os, const std::string& prefix) const {
+  os << prefix << "scheduler=" << policy_ << std::endl;
+  for (uint32_t wid = 0; wid < num_warps_; ++wid) {
+    auto& stats = warp_stats_.at(wid);
+    os << prefix << "warp" << wid << ": issued=" << stats.issued
+       << ", stalled=" << stats.stalled
+       << ", waiting=" << stats.waiting << std::endl;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+class PriorityScheduler : public WarpScheduler {
+public:
+  PriorityScheduler(uint32_t num_warps)
+    : WarpScheduler(SchedPolicy::Priority, num_warps)
+  {}
+
+protected:
+  int select(const WarpMask& ready) override {
+    return this->next(ready, 0);
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+class GTOScheduler : public WarpScheduler {
+public:
+  GTOScheduler(uint32_t num_warps, SchedPolicy policy = SchedPolicy::GTO)
+    : WarpScheduler(policy, num_warps)
+    , last_(-1)
+  {}
+
+  void reset() override {
+    WarpScheduler::reset();
+    last_ = -1;
+  }
+
+protected:
+  int select(const WarpMask& ready) override {
+    // keep issuing from the same warp until it stalls
+    if (last_ == -1 || !ready.test(last_)) {
+      last_ = this->oldest(ready);
+    }
+    return last_;
+  }
+
+  int last_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+class LRRScheduler : public WarpScheduler {
+public:
+  LRRScheduler(uint32_t num_warps)
+    : WarpScheduler(SchedPolicy::LRR, num_warps)
+    , last_(num_warps - 1)
+  {}
+
+  void reset() override {
+    WarpScheduler::reset();
+    last_ = num_warps_ - 1;
+  }
+
+protected:
+  int select(const WarpMask& ready) override {
+    // start after the last scheduled warp, skipping warps that are not ready
+    auto wid = this->next(ready, (last_ + 1) % num_warps_);
+    last_ = wid;
+    return wid;
+  }
+
+  uint32_t last_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+class TwoLevelScheduler : public WarpScheduler {
+public:
+  TwoLevelScheduler(uint32_t num_warps)
+    : WarpScheduler(SchedPolicy::TwoLevel, num_warps)
+    , pool_size_(std::max<uint32_t>(num_warps / 2, 1))
+    , last_(num_warps - 1)
+  {}
+
+  void reset() override {
+    WarpScheduler::reset();
+    pool_.reset();
+    last_ = num_warps_ - 1;
+  }
+
+  void issued(uint32_t wid, const instr_trace_t* trace) override {
+    // move warps waiting on long-latency operations to the pending pool
+    if (trace->fu_type == FUType::LSU
+     && (trace->lsu_type == LsuType::LOAD || trace->lsu_type == LsuType::AMO)) {
+      pool_.reset(wid);
+    }
+  }
+
+protected:
+  int select(const WarpMask& ready) override {
+    // release exited warps and warps waiting at a barrier,
+    // the warps needed to release the barrier may be pending
+    pool_ &= active_ & ~blocked_;
+
+    // refill the active pool with the oldest ready pending warps
+    while (pool_.count() < pool_size_) {
+      auto wid = this->oldest(ready & ~pool_);
+      if (wid == -1)
+        break;
+      pool_.set(wid);
+    }
+
+    // round-robin within the active pool
+    auto wid = this->next(ready & pool_, (last_ + 1) % num_warps_);
+    if (wid != -1) {
+      last_ = wid;
+    }
+    return wid;
+  }
+
+  uint32_t pool_size_;
+  WarpMask pool_;
+  uint32_t last_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+class CacheAwareScheduler : public GTOScheduler {
+public:
+  CacheAwareScheduler(uint32_t num_warps)
+    : GTOScheduler(num_warps, SchedPolicy::CacheAware)
+  {
+    this->reset();
+  }
+
+  void reset() override {
+    GTOScheduler::reset();
+    limit_ = num_warps_;
+    eligible_.reset();
+    eligible_active_.reset();
+    prev_accesses_ = 0;
+    prev_misses_ = 0;
+  }
+
+  void cache_feedback(uint64_t accesses, uint64_t misses) override {
+    uint64_t delta_accesses = accesses - prev_accesses_;
+    uint64_t delta_misses = misses - prev_misses_;
+    if (delta_accesses < THROTTLE_MIN_ACCESSES)
+      return;
+    prev_accesses_ = accesses;
+    prev_misses_ = misses;
+    double miss_rate = double(delta_misses) / delta_accesses;
+    if (miss_rate > THROTTLE_MISS_HIGH && limit_ > 1) {
+      --limit_;
+      eligible_active_.reset();
+    } else if (miss_rate < THROTTLE_MISS_LOW && limit_ < num_warps_) {
+      ++limit_;
+      eligible_active_.reset();
+    }
+  }
+
+protected:
+  int select(const WarpMask& ready) override {
+    // only the oldest <limit> active warps may be scheduled,
+    // warps waiting at a barrier do not count towards the limit
+    auto schedulable = active_ & ~blocked_;
+    if (eligible_active_ != schedulable || eligible_.none()) {
+      eligible_.reset();
+      auto remaining = schedulable;
+      for (uint32_t i = 0; i < limit_; ++i) {
+        auto wid = this->oldest(remaining);
+        if (wid == -1)
+          break;
+        eligible_.set(wid);
+        remaining.reset(wid);
+      }
+      eligible_active_ = schedulable;
+    }
+    auto candidates = ready & eligible_;
+    if (candidates.none())
+      return -1;
+    return GTOScheduler::select(candidates);
+  }
+
+  uint32_t limit_;
+  WarpMask eligible_;
+  WarpMask eligible_active_;
+  uint64_t prev_accesses_;
+  uint64_t prev_misses_;
+};
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+WarpScheduler::Ptr WarpScheduler::Create(SchedPolicy policy, uint32_t num_warps) {
+  switch (policy) {
+  case SchedPolicy::Priority:   return std::make_shared<PriorityScheduler>(num_warps);
+  case SchedPolicy::GTO:        return std::make_shared<GTOScheduler>(num_warps);
+  case SchedPolicy::LRR:        return std::make_shared<LRRScheduler>(num_warps);
+  case SchedPolicy::TwoLevel:   return std::make_shared<TwoLevelScheduler>(num_warps);
+  case SchedPolicy::CacheAware: return std::make_shared<CacheAwareScheduler>(num_warps);
+  default: assert(false);
+  }
+  return nullptr;
+}
@@ -0,0 +1,104 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <iostream>
+#include "types.h"
+
+namespace vortex {
+
+struct instr_trace_t;
+
+enum class SchedPolicy {
+  Priority,   // lowest ready warp id first (matches VX_schedule.sv)
+  GTO,        // greedy-then-oldest
+  LRR,        // loose round-robin
+  TwoLevel,   // round-robin over an active pool refilled from a pending pool
+  CacheAware  // greedy-then-oldest over a warp set throttled by L1 miss rate
+};
+
+inline std::ostream &operator<<(std::ostream &os, const SchedPolicy& policy) {
+  switch (policy) {
+  case SchedPolicy::Priority:   os << "Priority"; break;
+  case SchedPolicy::GTO:        os << "GTO"; break;
+  case SchedPolicy::LRR:        os << "LRR"; break;
+  case SchedPolicy::TwoLevel:   os << "TwoLevel"; break;
+  case SchedPolicy::CacheAware: os << "CacheAware"; break;
+  default: assert(false);
+  }
+  return os;
+}
+
+// Selects which ready warp the core schedules every cycle.
+// Per-warp issue and stall histograms are collected for all policies.
+class WarpScheduler {
+public:
+  typedef std::shared_ptr<WarpScheduler> Ptr;
+
+  struct warp_stats_t {
+    uint64_t issued;  // instructions scheduled
+    uint64_t stalled; // cycles active but not ready
+    uint64_t waiting; // cycles ready but not selected
+  };
+
+  static Ptr Create(SchedPolicy policy, uint32_t num_warps);
+
+  virtual ~WarpScheduler() {}
+
+  virtual void reset();
+
+  // select a warp to schedule, returns -1 if no warp is ready,
+  // <blocked> holds the active warps waiting at a barrier
+  int schedule(const WarpMask& ready, const WarpMask& active, const WarpMask& blocked);
+
+  // notification of the instruction fetched by the selected warp
+  virtual void issued(uint32_t /*wid*/, const instr_trace_t* /*trace*/) {}
+
+  // periodic L1 data cache feedback (cumulative counters)
+  virtual void cache_feedback(uint64_t /*accesses*/, uint64_t /*misses*/) {}
+
+  SchedPolicy policy() const {
+    return policy_;
+  }
+
+  const std::vector<warp_stats_t>& warp_stats() const {
+    return warp_stats_;
+  }
+
+  void dump_stats(std::ostream& os, const std::string& prefix) const;
+
+protected:
+
+  WarpScheduler(SchedPolicy policy, uint32_t num_warps);
+
+  virtual int select(const WarpMask& ready) = 0;
+
+  // oldest ready warp in the mask, by activation order
+  int oldest(const WarpMask& mask) const;
+
+  // first ready warp at or after the given position
+  int next(const WarpMask& mask, uint32_t start) const;
+
+  SchedPolicy policy_;
+  uint32_t num_warps_;
+  std::vector<uint64_t> ages_;
+  std::vector<warp_stats_t> warp_stats_;
+  WarpMask active_;
+  WarpMask blocked_;
+  uint64_t age_ctr_;
+};
+
+}
@@ -14,11 +14,14 @@
 #pragma once
 
 #include "instr_trace.h"
-#include <unordered_map>
 #include <vector>
 
 namespace vortex {
 
+// Register dependency tracking.
+// Each warp keeps a single bitmask of pending writes covering all register types,
+// so an instruction's full operand set is checked with one mask test.
+// Pending writers are stored in a flat array indexed by warp and register slot.
 class Scoreboard {
 public:
 
@@ -31,54 +34,41 @@ public:
 	};
 
 	Scoreboard(const Arch &arch)
-	: in_use_regs_(arch.num_warps()) {
-		for (auto& in_use_reg : in_use_regs_) {
-			in_use_reg.resize((int)RegType::Count);
-		}
+		: in_use_regs_(arch.num_warps())
+		, owners_(arch.num_warps() * REG_SLOTS)
+	{
 		this->clear();
 	}
 
 	void clear() {
 		for (auto& in_use_reg : in_use_regs_) {
-			for (auto& mask : in_use_reg) {
-				mask.reset();
-			}
+			in_use_reg = 0;
+		}
+		for (auto& owner : owners_) {
+			owner = nullptr;
 		}
-		owners_.clear();
 	}
 
 	bool in_use(instr_trace_t* trace) const {
-		if (trace->wb) {
-			assert(trace->dst_reg.type != RegType::None);
-			if (in_use_regs_.at(trace->wid).at((int)trace->dst_reg.type).test(trace->dst_reg.idx)) {
-				return true;
-			}
-		}
-		for (uint32_t i = 0; i < trace->src_regs.size(); ++i) {
-			if (trace->src_regs[i].type != RegType::None) {
-				if (in_use_regs_.at(trace->wid).at((int)trace->src_regs[i].type).test(trace->src_regs[i].idx)) {
-					return true;
-				}
-			}
-		}
-		return false;
+		return (in_use_regs_.at(trace->wid) & reg_mask(trace)) != 0;
 	}
 
 	std::vector<reg_use_t> get_uses(instr_trace_t* trace) const {
 		std::vector<reg_use_t> out;
+		auto in_use_regs = in_use_regs_.at(trace->wid);
 		if (trace->wb) {
 			assert(trace->dst_reg.type != RegType::None);
-			if (in_use_regs_.at(trace->wid).at((int)trace->dst_reg.type).test(trace->dst_reg.idx)) {
-				uint32_t tag = (trace->dst_reg.idx << 16) | (trace->wid << 4) | (int)trace->dst_reg.type;
-				auto owner = owners_.at(tag);
+			auto slot = reg_slot(trace->dst_reg);
+			if (in_use_regs & (1ull << slot)) {
+				auto owner = owners_.at(trace->wid * REG_SLOTS + slot);
 				out.push_back({trace->dst_reg.type, trace->dst_reg.idx, owner->fu_type, owner->sfu_type, owner->uuid});
 			}
 		}
 		for (uint32_t i = 0; i < trace->src_regs.size(); ++i) {
 			if (trace->src_regs[i].type != RegType::None) {
-				if (in_use_regs_.at(trace->wid).at((int)trace->src_regs[i].type).test(trace->src_regs[i].idx)) {
-					uint32_t tag = (trace->src_regs[i].idx << 16) | (trace->wid << 4) | (int)trace->src_regs[i].type;
-					auto owner = owners_.at(tag);
+				auto slot = reg_slot(trace->src_regs[i]);
+				if (in_use_regs & (1ull << slot)) {
+					auto owner = owners_.at(trace->wid * REG_SLOTS + slot);
 					out.push_back({trace->src_regs[i].type, trace->src_regs[i].idx, owner->fu_type, owner->sfu_type, owner->uuid});
 				}
 			}
@@ -88,24 +78,51 @@ public:
 
 	void reserve(instr_trace_t* trace) {
 		assert(trace->wb);
-		in_use_regs_.at(trace->wid).at((int)trace->dst_reg.type).set(trace->dst_reg.idx);
-		uint32_t tag = (trace->dst_reg.idx << 16) | (trace->wid << 4) | (int)trace->dst_reg.type;
-		assert(owners_.count(tag) == 0);
-		owners_[tag] = trace;
+		auto slot = reg_slot(trace->dst_reg);
+		auto& owner = owners_.at(trace->wid * REG_SLOTS + slot);
+		assert(owner == nullptr);
+		in_use_regs_.at(trace->wid) |= (1ull << slot);
+		owner = trace;
 	}
 
 	void release(instr_trace_t* trace) {
 		assert(trace->wb);
-		in_use_regs_.at(trace->wid).at((int)trace->dst_reg.type).reset(trace->dst_reg.idx);
-		uint32_t tag = (trace->dst_reg.idx << 16) | (trace->wid << 4) | (int)trace->dst_reg.type;
-		assert(owners_.count(tag) != 0);
-		owners_.erase(tag);
+		auto slot = reg_slot(trace->dst_reg);
+		auto& owner = owners_.at(trace->wid * REG_SLOTS + slot);
+		assert(owner != nullptr);
+		in_use_regs_.at(trace->wid) &= ~(1ull << slot);
+		owner = nullptr;
 	}
 
 private:
 
-	std::vector<std::vector<RegMask>> in_use_regs_;
-	std::unordered_map<uint32_t, instr_trace_t*> owners_;
+	// register slots per warp, integer registers first then floating-point
+	static constexpr uint32_t REG_SLOTS = ((int)RegType::Count - 1) * MAX_NUM_REGS;
+	static_assert(REG_SLOTS <= 64, "register slots must fit a 64-bit mask");
+
+	static uint32_t reg_slot(const instr_trace_t::reg_t& reg) {
+		assert(reg.type != RegType::None && reg.type < RegType::Count);
+		assert(reg.idx < MAX_NUM_REGS);
+		return ((int)reg.type - 1) * MAX_NUM_REGS + reg.idx;
+	}
+
+	// all registers read or written by the instruction
+	static uint64_t reg_mask(instr_trace_t* trace) {
+		uint64_t mask = 0;
+		if (trace->wb) {
+			assert(trace->dst_reg.type != RegType::None);
+			mask |= (1ull << reg_slot(trace->dst_reg));
+		}
+		for (uint32_t i = 0; i < trace->src_regs.size(); ++i) {
+			if (trace->src_regs[i].type != RegType::None) {
+				mask |= (1ull << reg_slot(trace->src_regs[i]));
+			}
+		}
+		return mask;
+	}
+
+	std::vector<uint64_t> in_use_regs_;
+	std::vector<instr_trace_t*> owners_;
 };
 
-}
\ No newline at end of file
+}
@@ -47,6 +47,8 @@ Socket::Socket(const SimContext& ctx,
     false,                  // write response
     (uint8_t)arch.num_warps(), // mshr size
     2,                      // pipeline latency
+    false,                  // execute atomics
+    0,                      // atomic latency
   });
 
   snprintf(sname, 100, "%s-dcaches", this->name().c_str());
@@ -65,6 +67,8 @@ Socket::Socket(const SimContext& ctx,
     false,                  // write response
     DCACHE_MSHR_SIZE,       // mshr size
     2,                      // pipeline latency
+    (AMO_CACHE_LEVEL <= 1), // execute atomics
+    AMO_LATENCY,            // atomic latency
   });
 
   // find overlap
@@ -149,6 +153,63 @@ bool Socket::running() const {
   return false;
 }
 
+void Socket::drain(bool enable) {
+  for (auto& core : cores_) {
+    core->drain(enable);
+  }
+}
+
+bool Socket::drained() const {
+  for (auto& core : cores_) {
+    if (!core->drained())
+      return false;
+  }
+  return true;
+}
+
+void Socket::emulate(bool warm) {
+  for (auto& core : cores_) {
+    core->emulate(warm);
+  }
+}
+
+void Socket::warm_icache(uint32_t core_index, uint64_t addr) {
+  if (icaches_->warm(core_index, addr, false)) {
+    cluster_->warm(addr, false);
+  }
+}
+
+void Socket::warm_dcache(uint32_t core_index, uint64_t addr, bool write) {
+  if (dcaches_->warm(core_index, addr, write)) {
+    cluster_->warm(addr, write);
+  }
+}
+
+void Socket::preload(uint64_t addr) {
+  for (uint32_t i = 0, n = cores_.size(); i < n; ++i) {
+    this->warm_dcache(i, addr, false);
+  }
+}
+
+void Socket::save(CheckpointWriter& writer) const {
+  writer.section("SOCK");
+  for (auto& core : cores_) {
+    core->save(writer);
+  }
+  icaches_->save(writer);
+  dcaches_->save(writer);
+}
+
+void Socket::load(CheckpointReader& reader) {
+  if (!reader.section("SOCK"))
+    return;
+  for (auto& core : cores_) {
+    core->load(reader);
+  }
+  icaches_->load(reader);
+  dcaches_->load(reader);
+}
+
 int Socket::get_exitcode() const {
   int exitcode = 0;
   for (auto& core : cores_) {
@@ -170,4 +231,25 @@ Socket::PerfStats Socket::perf_stats() const {
   perf_stats.icache = icaches_->perf_stats();
   perf_stats.dcache = dcaches_->perf_stats();
   return perf_stats;
+}
+
+void Socket::perf_sample(PerfStream::sample_t* sample) const {
+  for (auto& core : cores_) {
+    auto& core_perf = core->perf_stats();
+    sample->values[PerfStream::INSTRS]       += core_perf.instrs;
+    sample->values[PerfStream::SCHED_STALLS] += core_perf.sched_stalls;
+    sample->values[PerfStream::IBUF_STALLS]  += core_perf.ibuf_stalls;
+    sample->values[PerfStream::SCRB_STALLS]  += core_perf.scrb_stalls;
+  }
+  auto icache_perf = icaches_->perf_stats();
+  auto dcache_perf = dcaches_->perf_stats();
+  sample->values[PerfStream::ICACHE_MISSES] += icache_perf.read_misses;
+  sample->values[PerfStream::DCACHE_MISSES] += dcache_perf.read_misses + dcache_perf.write_misses;
+}
+
+void Socket::show_stats() const {
+  for (auto& core : cores_) {
+    core->show_stats();
+  }
+  dcaches_->show_stats();
 }
\ No newline at end of file
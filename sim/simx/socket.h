@@ -14,6 +14,7 @@
 #pragma once
 
 #include <simobject.h>
+#include <perf_stream.h>
 #include "dcrs.h"
 #include "arch.h"
 #include "cache_cluster.h"
@@ -69,8 +70,31 @@ public:
 
   void resume(uint32_t core_id);
 
+  void drain(bool enable);
+
+  bool drained() const;
+
+  // execute one instruction per ready warp without timing
+  void emulate(bool warm);
+
+  // functional cache accesses of a core
+  void warm_icache(uint32_t core_index, uint64_t addr);
+
+  void warm_dcache(uint32_t core_index, uint64_t addr, bool write);
+
+  // load a line into the data caches of all cores
+  void preload(uint64_t addr);
+
+  void save(CheckpointWriter& writer) const;
+
+  void load(CheckpointReader& reader);
+
   PerfStats perf_stats() const;
 
+  void perf_sample(PerfStream::sample_t* sample) const;
+
+  void show_stats() const;
+
 private:
   uint32_t                socket_id_;
   Cluster*                cluster_;
@@ -0,0 +1,85 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "timeline.h"
+#include <stdlib.h>
+#include <string.h>
+
+using namespace vortex;
+
+// file header: magic, version
+static const char TIMELINE_MAGIC[4] = {'V', 'X', 'T', 'L'};
+static const uint32_t TIMELINE_VERSION = 1;
+
+Timeline::Timeline()
+  : file_(nullptr)
+  , start_cycle_(0)
+  , end_cycle_(UINT64_MAX)
+  , cycles_(0)
+  , num_tracks_(0)
+{
+  auto path = getenv("VORTEX_TIMELINE");
+  if (path == nullptr || path[0] == '\0')
+    return;
+
+  auto start_s = getenv("VORTEX_TIMELINE_START");
+  if (start_s) {
+    start_cycle_ = strtoull(start_s, nullptr, 0);
+  }
+  auto end_s = getenv("VORTEX_TIMELINE_END");
+  if (end_s) {
+    end_cycle_ = strtoull(end_s, nullptr, 0);
+  }
+
+  file_ = fopen(path, "wb");
+  if (file_ == nullptr) {
+    printf("error: cannot open timeline file: %s\n", path);
+    return;
+  }
+  fwrite(TIMELINE_MAGIC, 1, sizeof(TIMELINE_MAGIC), file_);
+  fwrite(&TIMELINE_VERSION, sizeof(TIMELINE_VERSION), 1, file_);
+  events_.reserve(FLUSH_SIZE);
+}
+
+Timeline::~Timeline() {
+  if (file_ == nullptr)
+    return;
+  this->flush();
+  fclose(file_);
+}
+
+uint16_t Timeline::add_track(const std::string& name) {
+  uint16_t track = TRACK_BASE + num_tracks_++;
+  if (file_ == nullptr)
+    return track;
+
+  // track names are written in-line, ahead of any event that references them
+  this->flush();
+  event_t event = {};
+  event.type  = TrackName;
+  event.track = track;
+  event.aux   = name.size();
+  fwrite(&event, sizeof(event_t), 1, file_);
+  std::vector<char> buffer((name.size() + 7) & ~size_t(7), 0);
+  memcpy(buffer.data(), name.data(), name.size());
+  fwrite(buffer.data(), 1, buffer.size(), file_);
+  return track;
+}
+
+void Timeline::flush() {
+  if (file_ == nullptr || events_.empty())
+    return;
+  fwrite(events_.data(), sizeof(event_t), events_.size(), file_);
+  fflush(file_);
+  events_.clear();
+}
@@ -0,0 +1,109 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <stdio.h>
+
+namespace vortex {
+
+// Pipeline timeline recorder.
+// Emits compact fixed-size binary events per warp (issue, stalls, functional
+// unit dispatch, commit) and per cache bank (miss spans) within a cycle window.
+// The recorder is controlled from the environment and is available in release builds:
+//   VORTEX_TIMELINE=<file>          output file, recording is disabled if unset
+//   VORTEX_TIMELINE_START=<cycle>   first recorded cycle (default 0)
+//   VORTEX_TIMELINE_END=<cycle>     last recorded cycle, exclusive (default unbounded)
+// Use ci/timeline2perfetto.py to convert the output into a Perfetto trace.
+class Timeline {
+public:
+  enum EventType : uint8_t {
+    TrackName,  // names a track, followed by <aux> bytes of name padded to 8 bytes
+    Issue,      // instruction leaves the ibuffer, arg=fu_type
+    Stall,      // instruction starts stalling, arg=reason, aux=blocking fu_type
+    Dispatch,   // instruction enters its functional unit, arg=fu_type
+    Commit,     // instruction retires, arg=fu_type
+    MissBegin,  // cache fill request sent, id=address, aux=mshr_id
+    MissEnd     // cache fill response received, id=address, aux=mshr_id
+  };
+
+  enum StallReason : uint8_t {
+    IBuffer,
+    Scoreboard,
+    Operand,
+    Dispatcher
+  };
+
+  struct event_t {
+    uint64_t cycle;
+    uint64_t id;    // instruction uuid or memory address
+    uint16_t track; // core id or registered track id
+    uint16_t lane;  // warp id or cache bank id
+    uint8_t  type;
+    uint8_t  arg;
+    uint16_t aux;
+  };
+
+  static_assert(sizeof(event_t) == 24, "invalid event size");
+
+  static Timeline& instance() {
+    static Timeline timeline;
+    return timeline;
+  }
+
+  // allocate a named track for non-core objects (e.g. caches)
+  uint16_t add_track(const std::string& name);
+
+  // true if the current cycle lies in the recording window
+  bool active() const {
+    return (file_ != nullptr)
+        && (cycles_ >= start_cycle_)
+        && (cycles_ < end_cycle_);
+  }
+
+  void record(uint8_t type, uint16_t track, uint16_t lane, uint64_t id, uint8_t arg = 0, uint16_t aux = 0) {
+    events_.push_back({cycles_, id, track, lane, type, arg, aux});
+    if (events_.size() >= FLUSH_SIZE) {
+      this->flush();
+    }
+  }
+
+  // advance the global cycle counter, called once per simulation cycle
+  void tick() {
+    ++cycles_;
+  }
+
+  void flush();
+
+private:
+
+  static constexpr uint32_t FLUSH_SIZE = 65536;
+
+  // tracks below this id are reserved for cores
+  static constexpr uint16_t TRACK_BASE = 0x8000;
+
+  Timeline();
+  ~Timeline();
+
+  FILE* file_;
+  uint64_t start_cycle_;
+  uint64_t end_cycle_;
+  uint64_t cycles_;
+  uint16_t num_tracks_;
+  std::vector<event_t> events_;
+};
+
+}
@@ -0,0 +1,317 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "trace_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <VX_config.h>
+
+using namespace vortex;
+
+static const uint32_t VERSION = 1;
+
+enum {
+  FLAG_JUMP   = 1 << 0, // PC is not the next one
+  FLAG_TMASK  = 1 << 1, // thread mask changed
+  FLAG_WB     = 1 << 2,
+  FLAG_STALL  = 1 << 3, // fetch stall
+  FLAG_EXIT   = 1 << 4, // warp terminated
+  FLAG_ARGS   = 1 << 5, // warp control arguments
+  FLAG_ADDRS  = 1 << 6  // memory addresses
+};
+
+namespace {
+
+struct header_t {
+  char     magic[4];
+  uint32_t version;
+  uint32_t xlen;
+  uint32_t num_threads;
+  uint32_t num_warps;
+  uint32_t num_cores;
+  uint32_t num_clusters;
+  uint32_t reserved;
+};
+
+uint64_t zigzag(int64_t value) {
+  return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+  return int64_t(value >> 1) ^ -int64_t(value & 1);
+}
+
+uint64_t encode_reg(const instr_trace_t::reg_t& reg) {
+  return (uint64_t(reg.idx) << 3) | uint64_t(reg.type);
+}
+
+instr_trace_t::reg_t decode_reg(uint64_t value) {
+  return {RegType(value & 0x7), uint32_t(value >> 3)};
+}
+
+}
+
+TraceLog::TraceLog()
+  : writer_(nullptr)
+  , reader_(nullptr)
+  , path_(nullptr)
+  , run_done_(false)
+  , records_(0)
+  , bytes_(0)
+{}
+
+TraceLog::~TraceLog() {
+  if (writer_) {
+    fclose(writer_);
+    printf("itrace: records=%ld, bytes=%ld\n", records_, bytes_);
+  }
+  if (reader_) {
+    fclose(reader_);
+  }
+}
+
+void TraceLog::open(const Arch& arch) {
+  if (writer_ || reader_)
+    return;
+
+  uint32_t total_warps = arch.num_clusters() * arch.num_cores() * arch.num_warps();
+  header_t expected = {{'V', 'X', 'I', 'T'}, VERSION, XLEN,
+                       arch.num_threads(), arch.num_warps(), arch.num_cores(), arch.num_clusters(), 0};
+
+  auto replay_path = getenv("VORTEX_ITRACE_REPLAY");
+  if (replay_path) {
+    reader_ = fopen(replay_path, "rb");
+    if (reader_ == nullptr) {
+      printf("error: cannot open instruction trace: %s\n", replay_path);
+      std::abort();
+    }
+    header_t header;
+    if (1 != fread(&header, sizeof(header), 1, reader_)
+     || memcmp(header.magic, expected.magic, 4) != 0
+     || header.version != VERSION) {
+      printf("error: invalid instruction trace: %s\n", replay_path);
+      std::abort();
+    }
+    if (memcmp(&header, &expected, sizeof(header_t)) != 0) {
+      printf("error: instruction trace configuration mismatch: xlen=%d, threads=%d, warps=%d, cores=%d, clusters=%d\n",
+        header.xlen, header.num_threads, header.num_warps, header.num_cores, header.num_clusters);
+      std::abort();
+    }
+    path_ = replay_path;
+    pending_.resize(total_warps);
+  } else {
+    auto capture_path = getenv("VORTEX_ITRACE");
+    if (capture_path == nullptr)
+      return;
+    writer_ = fopen(capture_path, "wb");
+    if (writer_ == nullptr) {
+      printf("error: cannot create instruction trace: %s\n", capture_path);
+      std::abort();
+    }
+    fwrite(&expected, sizeof(header_t), 1, writer_);
+    bytes_ = sizeof(header_t);
+    path_ = capture_path;
+  }
+  warps_.resize(total_warps, warp_t{0, 0, 0});
+}
+
+void TraceLog::write_varint(uint64_t value) {
+  while (value >= 0x80) {
+    buffer_.push_back(uint8_t(value) | 0x80);
+    value >>= 7;
+  }
+  buffer_.push_back(uint8_t(value));
+}
+
+bool TraceLog::read_varint(uint64_t* value) {
+  uint64_t result = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7) {
+    int byte = getc(reader_);
+    if (byte == EOF)
+      return false;
+    result |= uint64_t(byte & 0x7f) << shift;
+    if (0 == (byte & 0x80)) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+void TraceLog::capture(uint32_t gwid, const instr_trace_t& trace, bool exit) {
+  auto& warp = warps_.at(gwid);
+  auto tmask = trace.tmask.to_ullong();
+  auto lsu_data = (trace.fu_type == FUType::LSU) ? std::dynamic_pointer_cast<LsuTraceData>(trace.data) : nullptr;
+  auto sfu_data = (trace.fu_type == FUType::SFU) ? std::dynamic_pointer_cast<SFUTraceData>(trace.data) : nullptr;
+
+  uint32_t flags = 0;
+  if (trace.PC != warp.next_PC) flags |= FLAG_JUMP;
+  if (tmask != warp.tmask)      flags |= FLAG_TMASK;
+  if (trace.wb)                 flags |= FLAG_WB;
+  if (trace.fetch_stall)        flags |= FLAG_STALL;
+  if (exit)                     flags |= FLAG_EXIT;
+  if (sfu_data)                 flags |= FLAG_ARGS;
+  if (lsu_data)                 flags |= FLAG_ADDRS;
+
+  buffer_.clear();
+  this->write_varint(gwid + 1);
+  this->write_varint(flags);
+  this->write_varint(uint32_t(trace.fu_type));
+  this->write_varint(trace.unit_type);
+  this->write_varint(encode_reg(trace.dst_reg));
+  for (auto& reg : trace.src_regs) {
+    this->write_varint(encode_reg(reg));
+  }
+  if (flags & FLAG_JUMP) {
+    this->write_varint(zigzag(int64_t(trace.PC - warp.next_PC)));
+  }
+  if (flags & FLAG_TMASK) {
+    this->write_varint(tmask);
+  }
+  if (flags & FLAG_ARGS) {
+    this->write_varint(sfu_data->arg1);
+    this->write_varint(sfu_data->arg2);
+  }
+  if (flags & FLAG_ADDRS) {
+    uint32_t size = 0;
+    for (uint32_t t = 0, n = lsu_data->mem_addrs.size(); t < n; ++t) {
+      if (trace.tmask.test(t)) {
+        size = lsu_data->mem_addrs.at(t).size;
+        break;
+      }
+    }
+    this->write_varint(size);
+    for (uint32_t t = 0, n = lsu_data->mem_addrs.size(); t < n; ++t) {
+      if (!trace.tmask.test(t))
+        continue;
+      auto addr = lsu_data->mem_addrs.at(t).addr;
+      this->write_varint(zigzag(int64_t(addr - warp.addr)));
+      warp.addr = addr;
+    }
+  }
+  warp.next_PC = trace.PC + 4;
+  warp.tmask = tmask;
+
+  fwrite(buffer_.data(), 1, buffer_.size(), writer_);
+  bytes_ += buffer_.size();
+  ++records_;
+}
+
+bool TraceLog::read_record() {
+  uint64_t gwid = 0, flags = 0, value = 0;
+  if (!this->read_varint(&gwid) || gwid == 0 || gwid > warps_.size())
+    return false;
+  --gwid;
+  auto& warp = warps_.at(gwid);
+  record_t record;
+  bool valid = this->read_varint(&flags);
+  valid = valid && this->read_varint(&value);
+  record.fu_type = FUType(value);
+  valid = valid && this->read_varint(&value);
+  record.unit_type = value;
+  valid = valid && this->read_varint(&value);
+  record.dst_reg = decode_reg(value);
+  record.src_regs.resize(NUM_SRC_REGS);
+  for (auto& reg : record.src_regs) {
+    valid = valid && this->read_varint(&value);
+    reg = decode_reg(value);
+  }
+  record.PC = warp.next_PC;
+  if (flags & FLAG_JUMP) {
+    valid = valid && this->read_varint(&value);
+    record.PC += unzigzag(value);
+  }
+  if (flags & FLAG_TMASK) {
+    valid = valid && this->read_varint(&warp.tmask);
+  }
+  record.tmask = warp.tmask;
+  record.wb = (flags & FLAG_WB) != 0;
+  record.fetch_stall = (flags & FLAG_STALL) != 0;
+  record.exit = (flags & FLAG_EXIT) != 0;
+  record.has_args = (flags & FLAG_ARGS) != 0;
+  if (record.has_args) {
+    valid = valid && this->read_varint(&record.args[0]);
+    valid = valid && this->read_varint(&record.args[1]);
+  }
+  record.has_addrs = (flags & FLAG_ADDRS) != 0;
+  if (record.has_addrs) {
+    valid = valid && this->read_varint(&value);
+    record.addr_size = value;
+    for (uint64_t tmask = record.tmask; tmask != 0 && valid; tmask &= tmask - 1) {
+      valid = this->read_varint(&value);
+      warp.addr += unzigzag(value);
+      record.addrs.push_back(warp.addr);
+    }
+  }
+  if (!valid) {
+    printf("error: truncated instruction trace: %s\n", path_);
+    return false;
+  }
+  warp.next_PC = record.PC + 4;
+  pending_.at(gwid).push_back(std::move(record));
+  return true;
+}
+
+bool TraceLog::replay(uint32_t gwid, instr_trace_t* trace, bool* exit) {
+  auto& pending = pending_.at(gwid);
+  while (pending.empty()) {
+    if (run_done_)
+      return false;
+    if (!this->read_record()) {
+      run_done_ = true;
+    }
+  }
+  auto& record = pending.front();
+  trace->PC = record.PC;
+  trace->tmask = ThreadMask(record.tmask);
+  trace->fu_type = record.fu_type;
+  trace->unit_type = record.unit_type;
+  trace->dst_reg = record.dst_reg;
+  trace->src_regs = record.src_regs;
+  trace->wb = record.wb;
+  trace->fetch_stall = record.fetch_stall;
+  if (record.has_args) {
+    trace->data = std::make_shared<SFUTraceData>(record.args[0], record.args[1]);
+  }
+  if (record.has_addrs) {
+    auto trace_data = std::make_shared<LsuTraceData>(trace->arch.num_threads());
+    uint32_t i = 0;
+    for (uint32_t t = 0, n = trace->arch.num_threads(); t < n; ++t) {
+      if (trace->tmask.test(t)) {
+        trace_data->mem_addrs.at(t) = {record.addrs.at(i++), record.addr_size};
+      }
+    }
+    trace->data = trace_data;
+  }
+  *exit = record.exit;
+  pending.pop_front();
+  return true;
+}
+
+void TraceLog::end_run() {
+  if (writer_) {
+    buffer_.clear();
+    this->write_varint(0);
+    fwrite(buffer_.data(), 1, buffer_.size(), writer_);
+    fflush(writer_);
+    bytes_ += buffer_.size();
+  }
+  if (reader_) {
+    // skip the instructions the replay did not consume
+    while (!run_done_ && this->read_record()) {}
+    for (auto& pending : pending_) {
+      pending.clear();
+    }
+    run_done_ = false;
+  }
+}
@@ -0,0 +1,113 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <vector>
+#include "instr_trace.h"
+
+namespace vortex {
+
+// Binary instruction trace.
+// A capture records each instruction executed by the emulator: warp, PC,
+// thread mask, functional unit and operation, registers, warp control
+// arguments and the memory address of each active thread. Records are
+// varint-encoded, the PC, thread mask and addresses as deltas from the
+// previous record of the same warp; each kernel run ends with a marker.
+// A replay feeds the pipeline from the trace instead of executing the
+// program, so the memory system can be reconfigured and simulated again
+// without re-executing the kernel; the processor configuration (threads,
+// warps, cores) must match the capture. Kernels whose control flow depends
+// on timing (e.g. spinning on memory) replay the captured path.
+// The trace is configured from the environment:
+//   VORTEX_ITRACE=<path>         capture the executed instructions
+//   VORTEX_ITRACE_REPLAY=<path>  replay a captured trace
+class TraceLog {
+public:
+  static TraceLog& instance() {
+    static TraceLog log;
+    return log;
+  }
+
+  bool capturing() const {
+    return writer_ != nullptr;
+  }
+
+  bool replaying() const {
+    return reader_ != nullptr;
+  }
+
+  // open the trace files, the configuration must match a replayed trace
+  void open(const Arch& arch);
+
+  // record an executed instruction, <exit> if the warp terminated
+  void capture(uint32_t gwid, const instr_trace_t& trace, bool exit);
+
+  // fill <trace> with the next instruction of warp <gwid>,
+  // false if the warp has no instruction left in the current run
+  bool replay(uint32_t gwid, instr_trace_t* trace, bool* exit);
+
+  // end of the kernel run
+  void end_run();
+
+private:
+
+  struct record_t {
+    uint64_t PC;
+    uint64_t tmask;
+    FUType   fu_type;
+    uint32_t unit_type;
+    instr_trace_t::reg_t dst_reg;
+    std::vector<instr_trace_t::reg_t> src_regs;
+    bool     wb;
+    bool     fetch_stall;
+    bool     exit;
+    bool     has_args;
+    uint64_t args[2];
+    bool     has_addrs;
+    uint32_t addr_size;
+    std::vector<uint64_t> addrs; // active threads only
+  };
+
+  // per-warp encoding state
+  struct warp_t {
+    uint64_t next_PC;
+    uint64_t tmask;
+    uint64_t addr;
+  };
+
+  TraceLog();
+  ~TraceLog();
+
+  void write_varint(uint64_t value);
+
+  bool read_varint(uint64_t* value);
+
+  // decode the next record, false at the end of the run
+  bool read_record();
+
+  FILE* writer_;
+  FILE* reader_;
+  const char* path_;
+  std::vector<uint8_t> buffer_;
+  std::vector<warp_t> warps_;
+  std::vector<std::deque<record_t>> pending_;
+  bool run_done_;
+  uint64_t records_;
+  uint64_t bytes_;
+};
+
+}
@@ -51,13 +51,18 @@ void LocalMemSwitch::tick() {
     auto& in_req = ReqIn.front();
 
     LsuReq out_dc_req(in_req.mask.size());
-    out_dc_req.write = in_req.write;
-    out_dc_req.tag   = in_req.tag;
+    out_dc_req.write  = in_req.write;
+    out_dc_req.atomic = in_req.atomic;
+    out_dc_req.tag    = in_req.tag;
     out_dc_req.cid   = in_req.cid;
     out_dc_req.uuid  = in_req.uuid;
 
     LsuReq out_lmem_req(out_dc_req);
 
+    if (!in_req.data.empty()) {
+      out_dc_req.data.resize(in_req.mask.size());
+    }
+
     for (uint32_t i = 0; i < in_req.mask.size(); ++i) {
       if (in_req.mask.test(i)) {
         auto type = get_addr_type(in_req.addrs.at(i));
@@ -67,6 +72,9 @@ void LocalMemSwitch::tick() {
         } else {
           out_dc_req.mask.set(i);
           out_dc_req.addrs.at(i) = in_req.addrs.at(i);
+          if (!in_req.data.empty()) {
+            out_dc_req.data.at(i) = in_req.data.at(i);
+          }
         }
       }
     }
@@ -146,11 +154,15 @@ void LsuMemAdapter::tick() {
         // build memory request
         MemReq out_req;
         out_req.write = in_req.write;
+        out_req.atomic = in_req.atomic;
         out_req.addr  = in_req.addrs.at(i);
         out_req.type  = get_addr_type(in_req.addrs.at(i));
         out_req.tag   = in_req.tag;
         out_req.cid   = in_req.cid;
         out_req.uuid  = in_req.uuid;
+        if (!in_req.data.empty()) {
+          out_req.data = in_req.data.at(i);
+        }
         // send memory request
         ReqOut.at(i).push(out_req, delay_);
         DT(4, this->name() << "-req" << i << ": " << out_req);
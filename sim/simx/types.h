@@ -14,7 +14,9 @@
 #pragma once
 
 #include <stdint.h>
+#include <array>
 #include <bitset>
+#include <memory>
 #include <queue>
 #include <vector>
 #include <unordered_map>
@@ -151,7 +153,8 @@ enum class LsuType {
   TCU_LOAD,
   STORE,
   TCU_STORE,
-  FENCE
+  FENCE,
+  AMO
 };
 
 enum class TCUType {
@@ -173,6 +176,7 @@ inline std::ostream &operator<<(std::ostream &os, const LsuType& type) {
   case LsuType::STORE: os << "STORE"; break;
   case LsuType::TCU_STORE: os << "TCU_STORE"; break;
   case LsuType::FENCE: os << "FENCE"; break;
+  case LsuType::AMO:   os << "AMO"; break;
   default: assert(false);
   }
   return os;
@@ -217,6 +221,38 @@ struct mem_addr_size_t {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Memory block payload of the cache data mode (see MemChecker).
+// Requests carry the bytes written by stores or observed by loads,
+// responses carry the line data.
+struct MemBlock {
+  typedef std::shared_ptr<MemBlock> Ptr;
+
+  uint64_t addr;  // block address
+  std::array<uint8_t, MEM_BLOCK_SIZE> data;
+  std::bitset<MEM_BLOCK_SIZE> mask; // valid bytes
+  Word     PC;    // issuing instruction
+  uint32_t wid;
+
+  MemBlock(uint64_t _addr = 0)
+    : addr(_addr)
+    , data{}
+    , PC(0)
+    , wid(0)
+  {}
+
+  // copy the valid bytes of another block
+  void merge(const MemBlock& other) {
+    for (uint32_t i = 0; i < MEM_BLOCK_SIZE; ++i) {
+      if (other.mask.test(i)) {
+        data[i] = other.data[i];
+      }
+    }
+    mask |= other.mask;
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 enum class FpuType {
   FNCP,
   FMA,
@@ -286,7 +322,9 @@ inline std::ostream &operator<<(std::ostream &os, const ArbiterType& type) {
 struct LsuReq {
   BitVector<> mask;
   std::vector<uint64_t> addrs;
+  std::vector<MemBlock::Ptr> data; // cache data mode only
   bool     write;
+  bool     atomic;
   uint32_t tag;
   uint32_t cid;
   uint64_t uuid;
@@ -295,6 +333,7 @@ struct LsuReq {
     : mask(size)
     , addrs(size, 0)
     , write(false)
+    , atomic(false)
     , tag(0)
     , cid(0)
     , uuid(0)
@@ -302,7 +341,9 @@ struct LsuReq {
 };
 
 inline std::ostream &operator<<(std::ostream &os, const LsuReq& req) {
-  os << "rw=" << req.write << ", mask=" << req.mask << ", addr={";
+  os << "rw=" << req.write;
+  if (req.atomic) os << ", amo";
+  os << ", mask=" << req.mask << ", addr={";
   bool first_addr = true;
   for (size_t i = 0; i < req.mask.size(); ++i) {
     if (!first_addr) os << ", ";
@@ -345,10 +386,12 @@ inline std::ostream &operator<<(std::ostream &os, const LsuRsp& rsp) {
 struct MemReq {
   uint64_t addr;
   bool     write;
+  bool     atomic;
   AddrType type;
   uint32_t tag;
   uint32_t cid;
   uint64_t uuid;
+  MemBlock::Ptr data; // cache data mode only
 
   MemReq(uint64_t _addr = 0,
           bool _write = false,
@@ -358,6 +401,7 @@ struct MemReq {
           uint64_t _uuid = 0
   ) : addr(_addr)
     , write(_write)
+    , atomic(false)
     , type(_type)
     , tag(_tag)
     , cid(_cid)
@@ -367,6 +411,7 @@ struct MemReq {
 
 inline std::ostream &operator<<(std::ostream &os, const MemReq& req) {
   os << "rw=" << req.write << ", ";
+  if (req.atomic) os << "amo, ";
   os << "addr=0x" << std::hex << req.addr << std::dec << ", type=" << req.type;
   os << ", tag=0x" << std::hex << req.tag << std::dec << ", cid=" << req.cid;
   os << " (#" << req.uuid << ")";
@@ -379,6 +424,7 @@ struct MemRsp {
   uint64_t tag;
   uint32_t cid;
   uint64_t uuid;
+  MemBlock::Ptr data; // cache data mode only
 
   MemRsp(uint64_t _tag = 0, uint32_t _cid = 0, uint64_t _uuid = 0)
     : tag (_tag)
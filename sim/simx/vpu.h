@@ -1342,15 +1342,24 @@ void vector_op_vv_store(std::vector<std::vector<Byte>> &vreg_file, vortex::Emula
 
 template <template <typename DT1, typename DT2> class OP, typename DT>
 void vector_op_vix(DT first, std::vector<std::vector<Byte>> &vreg_file, uint32_t rsrc0, uint32_t rdest, uint32_t vl, uint32_t vmask) {
-  for (uint32_t i = 0; i < vl; i++) {
-    if (isMasked(vreg_file, 0, i, vmask))
-      continue;
-
-    DT second = getVregData<DT>(vreg_file, rsrc0, i);
-    DT third = getVregData<DT>(vreg_file, rdest, i);
-    DT result = OP<DT, DT>::apply(first, second, third);
-    DP(4, (OP<DT, DT>::name()) << "(" << +first << ", " << +second << ", " << +third << ")" << " = " << +result);
-    getVregData<DT>(vreg_file, rdest, i) = result;
+  constexpr uint32_t num_elems = VLEN / (sizeof(DT) * 8);
+  auto mask = vreg_file.at(0).data();
+  for (uint32_t base = 0, r = 0; base < vl; base += num_elems, ++r) {
+    auto second = (const DT *)vreg_file.at((rsrc0 + r) % 32).data();
+    auto dest = (DT *)vreg_file.at((rdest + r) % 32).data();
+    uint32_t n = std::min(vl - base, num_elems);
+    if (vmask) {
+      for (uint32_t i = 0; i < n; ++i) {
+        dest[i] = OP<DT, DT>::apply(first, second[i], dest[i]);
+      }
+    } else {
+      for (uint32_t i = 0; i < n; ++i) {
+        uint32_t e = base + i;
+        if (((mask[e / 8] >> (e % 8)) & 0x1) == 0)
+          continue;
+        dest[i] = OP<DT, DT>::apply(first, second[i], dest[i]);
+      }
+    }
   }
 }
 
@@ -1814,16 +1823,27 @@ void vector_op_vix_gather(Word src1, std::vector<std::vector<Byte>> &vreg_file,
 
 template <template <typename DT1, typename DT2> class OP, typename DT>
 void vector_op_vv(std::vector<std::vector<Byte>> &vreg_file, uint32_t rsrc0, uint32_t rsrc1, uint32_t rdest, uint32_t vl, uint32_t vmask) {
-  for (uint32_t i = 0; i < vl; i++) {
-    if (isMasked(vreg_file, 0, i, vmask))
-      continue;
-
-    DT first = getVregData<DT>(vreg_file, rsrc0, i);
-    DT second = getVregData<DT>(vreg_file, rsrc1, i);
-    DT third = getVregData<DT>(vreg_file, rdest, i);
-    DT result = OP<DT, DT>::apply(first, second, third);
-    DP(4, (OP<DT, DT>::name()) << "(" << +first << ", " << +second << ", " << +third << ")" << " = " << +result);
-    getVregData<DT>(vreg_file, rdest, i) = result;
+  // process the register group one register at a time over raw element arrays,
+  // the unmasked loop is left free of branches for the compiler to vectorize
+  constexpr uint32_t num_elems = VLEN / (sizeof(DT) * 8);
+  auto mask = vreg_file.at(0).data();
+  for (uint32_t base = 0, r = 0; base < vl; base += num_elems, ++r) {
+    auto first = (const DT *)vreg_file.at((rsrc0 + r) % 32).data();
+    auto second = (const DT *)vreg_file.at((rsrc1 + r) % 32).data();
+    auto dest = (DT *)vreg_file.at((rdest + r) % 32).data();
+    uint32_t n = std::min(vl - base, num_elems);
+    if (vmask) {
+      for (uint32_t i = 0; i < n; ++i) {
+        dest[i] = OP<DT, DT>::apply(first[i], second[i], dest[i]);
+      }
+    } else {
+      for (uint32_t i = 0; i < n; ++i) {
+        uint32_t e = base + i;
+        if (((mask[e / 8] >> (e % 8)) & 0x1) == 0)
+          continue;
+        dest[i] = OP<DT, DT>::apply(first[i], second[i], dest[i]);
+      }
+    }
   }
 }
 
@@ -25,9 +25,11 @@
 #include <mem.h>
 
 #include <dram_sim.h>
+#include <mem_shim.h>
 
 #include <VX_config.h>
 #include <future>
+#include <atomic>
 #include <list>
 #include <queue>
 #include <unordered_map>
@@ -41,6 +43,10 @@
 #define MEM_CLOCK_RATIO 1
 #endif
 
+#ifndef MEM_QUEUE_SIZE
+#define MEM_QUEUE_SIZE 256
+#endif
+
 #define CACHE_BLOCK_SIZE  64
 
 #ifndef TRACE_START_TIME
@@ -77,7 +83,8 @@ double sc_time_stamp() {
   return timestamp;
 }
 
-static bool trace_enabled = false;
+// toggled by dpi_trace_start/stop from any Verilator thread
+static std::atomic<bool> trace_enabled(false);
 static uint64_t trace_start_time = TRACE_START_TIME;
 static uint64_t trace_stop_time = TRACE_STOP_TIME;
 
@@ -129,6 +136,7 @@ public:
   : device_(nullptr)
   , ram_(nullptr)
   , dram_sim_(PLATFORM_MEMORY_NUM_BANKS, PLATFORM_MEMORY_DATA_SIZE, MEM_CLOCK_RATIO)
+  , mem_shim_(PLATFORM_MEMORY_NUM_BANKS, PLATFORM_MEMORY_DATA_SIZE, MEM_QUEUE_SIZE, &dram_sim_)
   , stop_(false)
 #ifdef VCD_OUTPUT
   , tfp_(nullptr)
@@ -180,6 +188,7 @@ public:
 
     // allocate RAM
     ram_ = new RAM(0, RAM_PAGE_SIZE);
+    mem_shim_.attach_ram(ram_);
 
     // initialize AXI memory interfaces
     MP_M_AXI_MEM(PLATFORM_MEMORY_NUM_BANKS);
@@ -315,14 +324,7 @@ private:
     this->axi_ctrl_bus_reset();
     this->axi_mem_bus_reset();
 
-    for (auto& reqs : pending_mem_reqs_) {
-      reqs.clear();
-    }
-
-    for (int b = 0; b < PLATFORM_MEMORY_NUM_BANKS; ++b) {
-      std::queue<mem_req_t*> empty;
-      std::swap(dram_queues_[b], empty);
-    }
+    mem_shim_.reset();
 
     device_->ap_rst_n = 0;
 
@@ -356,20 +358,7 @@ private:
 
     dram_sim_.tick();
 
-    for (int b = 0; b < PLATFORM_MEMORY_NUM_BANKS; ++b) {
-      if (!dram_queues_[b].empty()) {
-        auto mem_req = dram_queues_[b].front();
-        dram_sim_.send_request(mem_req->addr, mem_req->write, [](void* arg) {
-          auto orig_req = reinterpret_cast<mem_req_t*>(arg);
-          if (orig_req->ready) {
-            delete orig_req;
-          } else {
-            orig_req->ready = true;
-          }
-        }, mem_req);
-        dram_queues_[b].pop();
-      }
-    }
+    mem_shim_.tick();
 
   #ifndef NDEBUG
     fflush(stdout);
@@ -445,18 +434,14 @@ private:
         *m_axi_mem_[b].rvalid = 0;
       }
       if (!*m_axi_mem_[b].rvalid) {
-        if (!pending_mem_reqs_[b].empty()
-        && (*pending_mem_reqs_[b].begin())->ready
-        && !(*pending_mem_reqs_[b].begin())->write) {
-          auto mem_rsp_it = pending_mem_reqs_[b].begin();
-          auto mem_rsp = *mem_rsp_it;
+        auto mem_rsp = mem_shim_.front(b);
+        if (mem_rsp && !mem_rsp->write) {
           *m_axi_mem_[b].rvalid = 1;
           *m_axi_mem_[b].rid    = mem_rsp->tag;
           *m_axi_mem_[b].rresp  = 0;
           *m_axi_mem_[b].rlast  = 1;
-          memcpy(m_axi_mem_[b].rdata->data(), mem_rsp->data.data(), PLATFORM_MEMORY_DATA_SIZE);
-          pending_mem_reqs_[b].erase(mem_rsp_it);
-          delete mem_rsp;
+          memcpy(m_axi_mem_[b].rdata->data(), mem_rsp->data, PLATFORM_MEMORY_DATA_SIZE);
+          mem_shim_.pop(b);
         }
       }
 
@@ -465,37 +450,18 @@ private:
         *m_axi_mem_[b].bvalid = 0;
       }
       if (!*m_axi_mem_[b].bvalid) {
-        if (!pending_mem_reqs_[b].empty()
-        && (*pending_mem_reqs_[b].begin())->ready
-        && (*pending_mem_reqs_[b].begin())->write) {
-          auto mem_rsp_it = pending_mem_reqs_[b].begin();
-          auto mem_rsp = *mem_rsp_it;
+        auto mem_rsp = mem_shim_.front(b);
+        if (mem_rsp && mem_rsp->write) {
           *m_axi_mem_[b].bvalid = 1;
           *m_axi_mem_[b].bid    = mem_rsp->tag;
           *m_axi_mem_[b].bresp  = 0;
-          pending_mem_reqs_[b].erase(mem_rsp_it);
-          delete mem_rsp;
+          mem_shim_.pop(b);
         }
       }
 
       // handle read requests
       if (*m_axi_mem_[b].arvalid && *m_axi_mem_[b].arready) {
-        auto mem_req = new mem_req_t();
-        mem_req->tag   = *m_axi_mem_[b].arid;
-        mem_req->addr  = uint64_t(*m_axi_mem_[b].araddr);
-        ram_->read(mem_req->data.data(), mem_req->addr, PLATFORM_MEMORY_DATA_SIZE);
-        mem_req->write = false;
-        mem_req->ready = false;
-        pending_mem_reqs_[b].emplace_back(mem_req);
-
-        /*printf("%0ld: [sim] axi-mem-read[%d]: addr=0x%lx, tag=0x%x, data=0x", timestamp, b, mem_req->addr, mem_req->tag);
-        for (int i = PLATFORM_MEMORY_DATA_SIZE-1; i >= 0; --i) {
-          printf("%02x", mem_req->data[i]);
-        }
-        printf("\n");*/
-
-        // send dram request
-        dram_queues_[b].push(mem_req);
+        mem_shim_.read(b, uint64_t(*m_axi_mem_[b].araddr), *m_axi_mem_[b].arid);
       }
 
       // handle write address requests
@@ -508,10 +474,7 @@ private:
       // handle write data requests
       if (*m_axi_mem_[b].wvalid && *m_axi_mem_[b].wready && !m_axi_states_[b].write_req_data_ack) {
         m_axi_states_[b].write_req_byteen = *m_axi_mem_[b].wstrb;
-        auto data = (const uint8_t*)m_axi_mem_[b].wdata->data();
-        for (int i = 0; i < PLATFORM_MEMORY_DATA_SIZE; ++i) {
-          m_axi_states_[b].write_req_data[i] = data[i];
-        }
+        memcpy(m_axi_states_[b].write_req_data.data(), m_axi_mem_[b].wdata->data(), PLATFORM_MEMORY_DATA_SIZE);
         m_axi_states_[b].write_req_data_ack = true;
       }
 
@@ -519,31 +482,24 @@ private:
       if (m_axi_states_[b].write_req_addr_ack && m_axi_states_[b].write_req_data_ack) {
         auto byteen = m_axi_states_[b].write_req_byteen;
         auto byte_addr = m_axi_states_[b].write_req_addr;
-        for (int i = 0; i < PLATFORM_MEMORY_DATA_SIZE; ++i) {
-          if ((byteen >> i) & 0x1) {
-            (*ram_)[byte_addr + i] = m_axi_states_[b].write_req_data[i];
-          }
-        }
-        auto mem_req = new mem_req_t();
-        mem_req->tag   = m_axi_states_[b].write_req_tag;
-        mem_req->addr  = byte_addr;
-        mem_req->write = true;
-        mem_req->ready = false;
-        pending_mem_reqs_[b].emplace_back(mem_req);
-
-        /*printf("%0ld: [sim] axi-mem-write[%d]: addr=0x%lx, byteen=0x%lx, tag=0x%x, data=0x", timestamp, b, mem_req->addr, byteen, mem_req->tag);
+        mem_shim_.write(b, byte_addr, m_axi_states_[b].write_req_data.data(), byteen, m_axi_states_[b].write_req_tag);
+
+        /*printf("%0ld: [sim] axi-mem-write[%d]: addr=0x%lx, byteen=0x%lx, tag=0x%x, data=0x", timestamp, b, byte_addr, byteen, m_axi_states_[b].write_req_tag);
         for (int i = PLATFORM_MEMORY_DATA_SIZE-1; i >= 0; --i) {
           printf("%02x", m_axi_states_[b].write_req_data[i]);
         }
         printf("\n");*/
 
-        // send dram request
-        dram_queues_[b].push(mem_req);
-
         // clear acks
         m_axi_states_[b].write_req_addr_ack = false;
         m_axi_states_[b].write_req_data_ack = false;
       }
+
+      // stall the bank while its request queue cannot take both a read and a write
+      bool ready = !mem_shim_.full(b, 2);
+      *m_axi_mem_[b].arready = ready;
+      *m_axi_mem_[b].awready = ready;
+      *m_axi_mem_[b].wready  = ready;
     }
   }
 
@@ -558,14 +514,6 @@ private:
     bool write_req_data_ack;
   } m_axi_state_t;
 
-  typedef struct {
-    std::array<uint8_t, PLATFORM_MEMORY_DATA_SIZE> data;
-    uint32_t tag;
-    uint64_t addr;
-    bool write;
-    bool ready;
-  } mem_req_t;
-
   typedef struct {
     CData* awvalid;
     CData* awready;
@@ -597,6 +545,7 @@ private:
   Vvortex_afu_shim* device_;
   RAM* ram_;
   DramSim dram_sim_;
+  MemShim mem_shim_;
   uint64_t mem_bank_size_;
 
   std::future<void> future_;
@@ -604,16 +553,12 @@ private:
 
   std::mutex mutex_;
 
-  std::list<mem_req_t*> pending_mem_reqs_[PLATFORM_MEMORY_NUM_BANKS];
-
   m_axi_mem_t m_axi_mem_[PLATFORM_MEMORY_NUM_BANKS];
 
   MemoryAllocator* mem_alloc_[PLATFORM_MEMORY_NUM_BANKS];
 
   m_axi_state_t m_axi_states_[PLATFORM_MEMORY_NUM_BANKS];
 
-  std::queue<mem_req_t*> dram_queues_[PLATFORM_MEMORY_NUM_BANKS];
-
 #ifdef VCD_OUTPUT
   VerilatedVcdC* tfp_;
 #endif
@@ -0,0 +1,55 @@
+#include <stdint.h>
+#include <vx_intrinsics.h>
+#include <vx_print.h>
+
+#define NUM_ELEMS 8
+#define SCALAR    3
+
+int32_t src_buffer[NUM_ELEMS];
+int32_t dst_buffer[NUM_ELEMS];
+
+int __attribute__((noinline)) make_full_tmask(int num_threads) {
+	return (num_threads >= 32) ? -1 : ((1 << num_threads) - 1);
+}
+
+// the vector registers belong to the warp,
+// the accumulation must happen once regardless of the active threads
+void __attribute__((noinline)) do_vmacc(int32_t scalar) {
+	asm volatile (
+		"vsetivli zero, %0, e32, m1, ta, ma\n"
+		"vle32.v v1, (%1)\n"
+		"vle32.v v2, (%2)\n"
+		"vmacc.vx v2, %3, v1\n"
+		"vse32.v v2, (%2)\n"
+		:: "i"(NUM_ELEMS), "r"(src_buffer), "r"(dst_buffer), "r"(scalar)
+		: "v1", "v2", "memory");
+}
+
+int main() {
+	int errors = 0;
+
+	for (int i = 0; i < NUM_ELEMS; ++i) {
+		src_buffer[i] = i + 1;
+		dst_buffer[i] = 100 + i;
+	}
+
+	vx_tmc(make_full_tmask(vx_num_threads()));
+	do_vmacc(SCALAR);
+	vx_tmc_one();
+
+	for (int i = 0; i < NUM_ELEMS; ++i) {
+		int32_t ref_value = 100 + i + SCALAR * (i + 1);
+		if (dst_buffer[i] != ref_value) {
+			vx_printf("*** error: [%d] %d, expected %d\n", i, dst_buffer[i], ref_value);
+			++errors;
+		}
+	}
+
+	if (0 == errors) {
+		vx_printf("Passed!\n");
+	} else {
+		vx_printf("Failed!\n");
+	}
+
+	return errors;
+}
@@ -24,7 +24,6 @@ vx_buffer_h src0_buffer = nullptr;
 vx_buffer_h src1_buffer = nullptr;
 vx_buffer_h dst_buffer = nullptr;
 vx_buffer_h krnl_buffer = nullptr;
-vx_buffer_h args_buffer = nullptr;
 kernel_arg_t kernel_arg = {};
 
 static void show_usage() {
@@ -78,7 +77,6 @@ void cleanup() {
     vx_mem_free(src1_buffer);
     vx_mem_free(dst_buffer);
     vx_mem_free(krnl_buffer);
-    vx_mem_free(args_buffer);
     vx_dev_close(device);
   }
 }
@@ -124,7 +122,6 @@ int main(int argc, char *argv[]) {
   RT_CHECK(vx_mem_address(src1_buffer, &kernel_arg.src1_addr));
   RT_CHECK(vx_mem_alloc(device, buf_size, VX_MEM_READ_WRITE, &dst_buffer));
   RT_CHECK(vx_mem_address(dst_buffer, &kernel_arg.dst_addr));
-  RT_CHECK(vx_mem_alloc(device, sizeof(kernel_arg_t), VX_MEM_READ, &args_buffer));
 
   std::cout << "dev_src0=0x" << std::hex << kernel_arg.src0_addr << std::dec << std::endl;
   std::cout << "dev_src1=0x" << std::hex << kernel_arg.src1_addr << std::dec << std::endl;
@@ -183,14 +180,10 @@ int main(int argc, char *argv[]) {
     }
     RT_CHECK(vx_copy_to_dev(dst_buffer, dst_buf.data(), 0, buf_size));
 
-    // upload kernel argument
-    std::cout << "upload kernel argument" << std::endl;
+    // launch device with kernel argument
+    std::cout << "launch device" << std::endl;
     kernel_arg.testid = t;
-    RT_CHECK(vx_copy_to_dev(args_buffer, &kernel_arg, 0, sizeof(kernel_arg_t)));
-
-    // start device
-    std::cout << "start device" << std::endl;
-    RT_CHECK(vx_start(device, krnl_buffer, args_buffer));
+    RT_CHECK(vx_launch(device, krnl_buffer, &kernel_arg, sizeof(kernel_arg_t)));
 
     // wait for completion
     std::cout << "wait for completion" << std::endl;
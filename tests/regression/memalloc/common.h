@@ -0,0 +1,17 @@
+#ifndef _COMMON_H_
+#define _COMMON_H_
+
+typedef struct {
+  uint64_t addr;
+  uint32_t size;
+  uint32_t seed;
+} buffer_desc_t;
+
+typedef struct {
+  uint32_t num_tasks;
+  uint32_t reserved;
+  uint64_t table_addr;
+  uint64_t dst_addr;
+} kernel_arg_t;
+
+#endif
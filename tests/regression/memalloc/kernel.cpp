@@ -0,0 +1,22 @@
+#include <vx_spawn.h>
+#include "common.h"
+
+void kernel_body(kernel_arg_t* __UNIFORM__ arg) {
+	buffer_desc_t* table = (buffer_desc_t*)arg->table_addr;
+	uint32_t* dst_ptr    = (uint32_t*)arg->dst_addr;
+
+	buffer_desc_t* desc = &table[blockIdx.x];
+	uint32_t* src_ptr   = (uint32_t*)desc->addr;
+	uint32_t num_words = desc->size / sizeof(uint32_t);
+
+	uint32_t checksum = desc->seed;
+	for (uint32_t i = 0; i < num_words; ++i) {
+		checksum = (checksum * 31) + src_ptr[i];
+	}
+	dst_ptr[blockIdx.x] = checksum;
+}
+
+int main() {
+	kernel_arg_t* arg = (kernel_arg_t*)csr_read(VX_CSR_MSCRATCH);
+	return vx_spawn_threads(1, &arg->num_tasks, nullptr, (vx_kernel_func_cb)kernel_body, arg);
+}
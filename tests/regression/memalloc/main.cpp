@@ -0,0 +1,265 @@
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <stdlib.h>
+#include <vector>
+#include <vortex.h>
+#include "common.h"
+
+#define RT_CHECK(_expr)                                         \
+   do {                                                         \
+     int _ret = _expr;                                          \
+     if (0 == _ret)                                             \
+       break;                                                   \
+     printf("Error: '%s' returned %d!\n", #_expr, (int)_ret);   \
+	 cleanup();			                                              \
+     exit(-1);                                                  \
+   } while (false)
+
+#define MAX_BUFFERS     64
+#define MAX_SMALL_SIZE  4096
+#define MAX_LARGE_SIZE  (256 * 1024)
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct buffer_t {
+  vx_buffer_h handle;
+  buffer_desc_t desc;
+};
+
+const char* kernel_file = "kernel.vxbin";
+uint32_t count = 0;
+
+vx_device_h device = nullptr;
+vx_buffer_h table_buffer = nullptr;
+vx_buffer_h dst_buffer = nullptr;
+vx_buffer_h krnl_buffer = nullptr;
+vx_buffer_h args_buffer = nullptr;
+std::vector<buffer_t> buffers;
+kernel_arg_t kernel_arg = {};
+
+static void show_usage() {
+   std::cout << "Vortex Test." << std::endl;
+   std::cout << "Usage: [-k: kernel] [-n iterations] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:k:h")) != -1) {
+    switch (c) {
+    case 'n':
+      count = atoi(optarg);
+      break;
+    case 'k':
+      kernel_file = optarg;
+      break;
+    case 'h':
+      show_usage();
+      exit(0);
+      break;
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+void cleanup() {
+  if (device) {
+    for (auto& buffer : buffers) {
+      vx_mem_free(buffer.handle);
+    }
+    vx_mem_free(table_buffer);
+    vx_mem_free(dst_buffer);
+    vx_mem_free(krnl_buffer);
+    vx_mem_free(args_buffer);
+    vx_dev_close(device);
+  }
+}
+
+static uint32_t pattern(uint32_t seed, uint32_t index) {
+  return seed ^ (index * 2654435761u);
+}
+
+static uint32_t checksum(const buffer_desc_t& desc) {
+  uint32_t value = desc.seed;
+  for (uint32_t i = 0; i < desc.size / sizeof(uint32_t); ++i) {
+    value = (value * 31) + pattern(desc.seed, i);
+  }
+  return value;
+}
+
+static void dump_mem_stats(const char* label) {
+  uint64_t mem_free, mem_used, peak, largest, frag, allocs;
+  RT_CHECK(vx_mem_info(device, &mem_free, &mem_used));
+  RT_CHECK(vx_mem_stats(device, VX_MEM_STATS_PEAK_USED, &peak));
+  RT_CHECK(vx_mem_stats(device, VX_MEM_STATS_LARGEST_FREE, &largest));
+  RT_CHECK(vx_mem_stats(device, VX_MEM_STATS_FRAGMENTATION, &frag));
+  RT_CHECK(vx_mem_stats(device, VX_MEM_STATS_NUM_ALLOCS, &allocs));
+  std::cout << std::dec << label << ": used=" << mem_used << ", free=" << mem_free
+            << ", peak=" << peak << ", largest_free=" << largest
+            << ", fragmentation=" << frag << "%, allocs=" << allocs << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // parse command arguments
+  parse_args(argc, argv);
+
+  if (count == 0) {
+    count = 1;
+  }
+
+  std::srand(50);
+
+  // open device connection
+  std::cout << "open device connection" << std::endl;
+  RT_CHECK(vx_dev_open(&device));
+
+  // upload program
+  std::cout << "upload program" << std::endl;
+  RT_CHECK(vx_upload_kernel_file(device, kernel_file, &krnl_buffer));
+
+  uint64_t base_used, base_largest, base_allocs;
+  RT_CHECK(vx_mem_info(device, nullptr, &base_used));
+  RT_CHECK(vx_mem_stats(device, VX_MEM_STATS_LARGEST_FREE, &base_largest));
+  RT_CHECK(vx_mem_stats(device, VX_MEM_STATS_NUM_ALLOCS, &base_allocs));
+  dump_mem_stats("baseline");
+
+  // random allocate/release churn
+  std::cout << "run " << count << " allocation iterations" << std::endl;
+  for (uint32_t i = 0; i < count; ++i) {
+    bool do_alloc = buffers.empty() || (buffers.size() < MAX_BUFFERS && (std::rand() % 2));
+    if (do_alloc) {
+      uint32_t max_size = (std::rand() % 8) ? MAX_SMALL_SIZE : MAX_LARGE_SIZE;
+      uint32_t size = ((std::rand() % max_size) + sizeof(uint32_t)) & ~(sizeof(uint32_t) - 1);
+      buffer_t buffer;
+      RT_CHECK(vx_mem_alloc(device, size, VX_MEM_READ, &buffer.handle));
+      RT_CHECK(vx_mem_address(buffer.handle, &buffer.desc.addr));
+      buffer.desc.size = size;
+      buffer.desc.seed = std::rand();
+      buffers.push_back(buffer);
+    } else {
+      uint32_t index = std::rand() % buffers.size();
+      RT_CHECK(vx_mem_free(buffers[index].handle));
+      buffers[index] = buffers.back();
+      buffers.pop_back();
+    }
+  }
+
+  dump_mem_stats("after churn");
+
+  // verify live buffers do not overlap
+  std::cout << "verify address ranges" << std::endl;
+  int errors = 0;
+  for (uint32_t i = 0; i < buffers.size(); ++i) {
+    auto& a = buffers[i].desc;
+    for (uint32_t j = i + 1; j < buffers.size(); ++j) {
+      auto& b = buffers[j].desc;
+      if (a.addr < b.addr + b.size && b.addr < a.addr + a.size) {
+        std::cout << "error: buffer #" << std::dec << i << " [0x" << std::hex << a.addr << ", 0x" << (a.addr + a.size)
+                  << ") overlaps buffer #" << std::dec << j << " [0x" << std::hex << b.addr << ", 0x" << (b.addr + b.size) << ")" << std::endl;
+        ++errors;
+      }
+    }
+  }
+
+  uint64_t num_allocs;
+  RT_CHECK(vx_mem_stats(device, VX_MEM_STATS_NUM_ALLOCS, &num_allocs));
+  if (num_allocs != base_allocs + buffers.size()) {
+    std::cout << "error: allocation count " << std::dec << num_allocs << ", expected " << (base_allocs + buffers.size()) << std::endl;
+    ++errors;
+  }
+
+  // upload buffer contents
+  std::cout << "upload " << std::dec << buffers.size() << " buffers" << std::endl;
+  std::vector<buffer_desc_t> h_table(buffers.size());
+  for (uint32_t i = 0; i < buffers.size(); ++i) {
+    auto& desc = buffers[i].desc;
+    std::vector<uint32_t> h_data(desc.size / sizeof(uint32_t));
+    for (uint32_t j = 0; j < h_data.size(); ++j) {
+      h_data[j] = pattern(desc.seed, j);
+    }
+    RT_CHECK(vx_copy_to_dev(buffers[i].handle, h_data.data(), 0, desc.size));
+    h_table[i] = desc;
+  }
+
+  uint32_t num_tasks = buffers.size();
+  kernel_arg.num_tasks = num_tasks;
+
+  std::cout << "allocate device memory" << std::endl;
+  RT_CHECK(vx_mem_alloc(device, num_tasks * sizeof(buffer_desc_t), VX_MEM_READ, &table_buffer));
+  RT_CHECK(vx_mem_address(table_buffer, &kernel_arg.table_addr));
+  RT_CHECK(vx_mem_alloc(device, num_tasks * sizeof(uint32_t), VX_MEM_WRITE, &dst_buffer));
+  RT_CHECK(vx_mem_address(dst_buffer, &kernel_arg.dst_addr));
+
+  std::cout << "upload buffer table" << std::endl;
+  RT_CHECK(vx_copy_to_dev(table_buffer, h_table.data(), 0, num_tasks * sizeof(buffer_desc_t)));
+
+  // upload kernel argument
+  std::cout << "upload kernel argument" << std::endl;
+  RT_CHECK(vx_upload_bytes(device, &kernel_arg, sizeof(kernel_arg_t), &args_buffer));
+
+  // start device
+  std::cout << "start device" << std::endl;
+  RT_CHECK(vx_start(device, krnl_buffer, args_buffer));
+
+  // wait for completion
+  std::cout << "wait for completion" << std::endl;
+  RT_CHECK(vx_ready_wait(device, VX_MAX_TIMEOUT));
+
+  // download destination buffer
+  std::cout << "download destination buffer" << std::endl;
+  std::vector<uint32_t> h_dst(num_tasks);
+  RT_CHECK(vx_copy_from_dev(h_dst.data(), dst_buffer, 0, num_tasks * sizeof(uint32_t)));
+
+  // verify result
+  std::cout << "verify result" << std::endl;
+  for (uint32_t i = 0; i < num_tasks; ++i) {
+    uint32_t ref = checksum(h_table[i]);
+    uint32_t cur = h_dst[i];
+    if (cur != ref) {
+      std::cout << "error at buffer #" << std::dec << i
+                << std::hex << ": actual 0x" << cur << ", expected 0x" << ref << std::endl;
+      ++errors;
+    }
+  }
+
+  // release everything and check that free blocks coalesced back
+  std::cout << "release device memory" << std::endl;
+  for (auto& buffer : buffers) {
+    RT_CHECK(vx_mem_free(buffer.handle));
+  }
+  buffers.clear();
+  RT_CHECK(vx_mem_free(table_buffer));
+  RT_CHECK(vx_mem_free(dst_buffer));
+  RT_CHECK(vx_mem_free(args_buffer));
+  table_buffer = dst_buffer = args_buffer = nullptr;
+
+  dump_mem_stats("after release");
+
+  uint64_t end_used, end_largest;
+  RT_CHECK(vx_mem_info(device, nullptr, &end_used));
+  RT_CHECK(vx_mem_stats(device, VX_MEM_STATS_LARGEST_FREE, &end_largest));
+  if (end_used != base_used) {
+    std::cout << "error: memory leak, used=" << std::dec << end_used << ", expected " << base_used << std::endl;
+    ++errors;
+  }
+  if (end_largest != base_largest) {
+    std::cout << "error: free blocks not coalesced, largest_free=" << std::dec << end_largest << ", expected " << base_largest << std::endl;
+    ++errors;
+  }
+
+  // cleanup
+  std::cout << "cleanup" << std::endl;
+  cleanup();
+
+  if (errors != 0) {
+    std::cout << "Found " << std::dec << errors << " errors!" << std::endl;
+    std::cout << "FAILED!" << std::endl;
+    return errors;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,54 @@
+#include <perf_stream.h>
+#include <stdio.h>
+#include <thread>
+#include <atomic>
+
+#define NUM_SAMPLES 1000000
+
+int main() {
+    vortex::PerfStream stream(1, 256);
+    std::atomic<bool> done(false);
+
+    // producer: cumulative cycle counter, like the simulator
+    std::thread producer([&]() {
+        vortex::PerfStream::sample_t sample = {};
+        for (uint64_t i = 1; i <= NUM_SAMPLES; ++i) {
+            sample.values[vortex::PerfStream::CYCLES] = i;
+            sample.values[vortex::PerfStream::INSTRS] = i * 2;
+            stream.push(sample);
+        }
+        done = true;
+    });
+
+    // consumer: samples must arrive in order and intact
+    uint64_t received = 0;
+    uint64_t last = 0;
+    vortex::PerfStream::sample_t sample;
+    for (;;) {
+        bool finished = done;
+        if (!stream.pop(&sample)) {
+            if (finished)
+                break;
+            continue;
+        }
+        auto cycles = sample.values[vortex::PerfStream::CYCLES];
+        if (cycles <= last || sample.values[vortex::PerfStream::INSTRS] != cycles * 2) {
+            printf("Error: invalid sample #%ld after #%ld!\n", cycles, last);
+            producer.join();
+            return -1;
+        }
+        last = cycles;
+        ++received;
+    }
+
+    producer.join();
+
+    if (received + stream.dropped() != NUM_SAMPLES) {
+        printf("Error: received=%ld, dropped=%ld, expected=%d!\n", received, stream.dropped(), NUM_SAMPLES);
+        return -1;
+    }
+
+    printf("PASSED!\n");
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <rvfloats.h>
+#include <stdio.h>
+#include <random>
+
+extern "C" {
+#include <softfloat.h>
+}
+
+#define NUM_TESTS 1000000
+
+// Differential test of the rvfloats host fast path against softfloat
+
+static std::mt19937_64 rng(0x5eed);
+
+// random operands biased towards special values and exponent extremes
+static uint32_t rand_f32() {
+  uint32_t v = rng();
+  uint32_t sign = v & 0x80000000;
+  switch (rng() % 8) {
+  case 0: return v;
+  case 1: return sign | (v & 0x007fffff) | ((rng() % 4) << 23);          // tiny
+  case 2: return sign | (v & 0x007fffff) | ((252 + rng() % 3) << 23);    // huge
+  case 3: return sign | (v & 0x007fffff) | (0xff << 23);                 // inf/NaN
+  case 4: return sign;                                                   // zero
+  case 5: return sign | (v & 0x007fffff);                                // subnormal
+  default: return sign | (v & 0x007fffff) | ((112 + rng() % 32) << 23);  // around one
+  }
+}
+
+static uint64_t rand_f64() {
+  uint64_t v = rng();
+  uint64_t sign = v & 0x8000000000000000;
+  uint64_t mant = v & 0x000fffffffffffff;
+  switch (rng() % 8) {
+  case 0: return v;
+  case 1: return sign | mant | (uint64_t(rng() % 4) << 52);
+  case 2: return sign | mant | (uint64_t(2044 + rng() % 3) << 52);
+  case 3: return sign | mant | (uint64_t(0x7ff) << 52);
+  case 4: return sign;
+  case 5: return sign | mant;
+  default: return sign | mant | (uint64_t(1008 + rng() % 32) << 52);
+  }
+}
+
+static void sf_init() {
+  softfloat_exceptionFlags = 0;
+  softfloat_roundingMode = softfloat_round_near_even;
+}
+
+static int errors = 0;
+
+template <typename T>
+static void check(const char* op, T r, uint32_t fflags, T ref, T a, T b, T c) {
+  if (r == ref && fflags == softfloat_exceptionFlags)
+    return;
+  if (++errors <= 10) {
+    printf("Error: %s(0x%lx, 0x%lx, 0x%lx) returned 0x%lx (fflags=0x%x), expected 0x%lx (fflags=0x%x)\n",
+      op, (uint64_t)a, (uint64_t)b, (uint64_t)c, (uint64_t)r, fflags, (uint64_t)ref, softfloat_exceptionFlags);
+  }
+}
+
+static void test_f32(uint32_t a, uint32_t b, uint32_t c) {
+  uint32_t fflags, r;
+  float32_t fa{a}, fb{b}, fc{c};
+  float32_t na{a ^ 0x80000000}, nc{c ^ 0x80000000};
+
+  r = rv_fadd_s(a, b, 0, &fflags); sf_init();
+  check("fadd.s", r, fflags, f32_add(fa, fb).v, a, b, c);
+  r = rv_fsub_s(a, b, 0, &fflags); sf_init();
+  check("fsub.s", r, fflags, f32_sub(fa, fb).v, a, b, c);
+  r = rv_fmul_s(a, b, 0, &fflags); sf_init();
+  check("fmul.s", r, fflags, f32_mul(fa, fb).v, a, b, c);
+  r = rv_fdiv_s(a, b, 0, &fflags); sf_init();
+  check("fdiv.s", r, fflags, f32_div(fa, fb).v, a, b, c);
+  r = rv_fsqrt_s(a, 0, &fflags); sf_init();
+  check("fsqrt.s", r, fflags, f32_sqrt(fa).v, a, b, c);
+  r = rv_fmadd_s(a, b, c, 0, &fflags); sf_init();
+  check("fmadd.s", r, fflags, f32_mulAdd(fa, fb, fc).v, a, b, c);
+  r = rv_fmsub_s(a, b, c, 0, &fflags); sf_init();
+  check("fmsub.s", r, fflags, f32_mulAdd(fa, fb, nc).v, a, b, c);
+  r = rv_fnmadd_s(a, b, c, 0, &fflags); sf_init();
+  check("fnmadd.s", r, fflags, f32_mulAdd(na, fb, nc).v, a, b, c);
+  r = rv_fnmsub_s(a, b, c, 0, &fflags); sf_init();
+  check("fnmsub.s", r, fflags, f32_mulAdd(na, fb, fc).v, a, b, c);
+}
+
+static void test_f64(uint64_t a, uint64_t b, uint64_t c) {
+  uint32_t fflags;
+  uint64_t r;
+  float64_t fa{a}, fb{b}, fc{c};
+  float64_t na{a ^ 0x8000000000000000}, nc{c ^ 0x8000000000000000};
+
+  r = rv_fadd_d(a, b, 0, &fflags); sf_init();
+  check("fadd.d", r, fflags, f64_add(fa, fb).v, a, b, c);
+  r = rv_fsub_d(a, b, 0, &fflags); sf_init();
+  check("fsub.d", r, fflags, f64_sub(fa, fb).v, a, b, c);
+  r = rv_fmul_d(a, b, 0, &fflags); sf_init();
+  check("fmul.d", r, fflags, f64_mul(fa, fb).v, a, b, c);
+  r = rv_fdiv_d(a, b, 0, &fflags); sf_init();
+  check("fdiv.d", r, fflags, f64_div(fa, fb).v, a, b, c);
+  r = rv_fsqrt_d(a, 0, &fflags); sf_init();
+  check("fsqrt.d", r, fflags, f64_sqrt(fa).v, a, b, c);
+  r = rv_fmadd_d(a, b, c, 0, &fflags); sf_init();
+  check("fmadd.d", r, fflags, f64_mulAdd(fa, fb, fc).v, a, b, c);
+  r = rv_fmsub_d(a, b, c, 0, &fflags); sf_init();
+  check("fmsub.d", r, fflags, f64_mulAdd(fa, fb, nc).v, a, b, c);
+  r = rv_fnmadd_d(a, b, c, 0, &fflags); sf_init();
+  check("fnmadd.d", r, fflags, f64_mulAdd(na, fb, nc).v, a, b, c);
+  r = rv_fnmsub_d(a, b, c, 0, &fflags); sf_init();
+  check("fnmsub.d", r, fflags, f64_mulAdd(na, fb, fc).v, a, b, c);
+}
+
+int main() {
+  for (int i = 0; i < NUM_TESTS; ++i) {
+    test_f32(rand_f32(), rand_f32(), rand_f32());
+    test_f64(rand_f64(), rand_f64(), rand_f64());
+  }
+  if (errors != 0) {
+    printf("FAILED! %d mismatches\n", errors);
+    return -1;
+  }
+  printf("PASSED!\n");
+  return 0;
+}
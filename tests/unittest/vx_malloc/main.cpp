@@ -44,6 +44,27 @@ int main() {
     RT_CHECK(allocator->release(a2));
     RT_CHECK(allocator->release(a3));
 
+    // page-sized allocations must be page-aligned
+    RT_CHECK(allocator->allocate(64, &a0));
+    RT_CHECK(allocator->allocate(5878, &a1));
+    RT_CHECK(allocator->allocate(4096, &a2));
+    if ((a1 % pageAlign) != 0 || (a2 % pageAlign) != 0) {
+        printf("Error: page-sized allocation not page-aligned!\n");
+        return -1;
+    }
+    RT_CHECK(allocator->release(a1));
+    RT_CHECK(allocator->allocate(1, &a3));
+    RT_CHECK(allocator->release(a0));
+    RT_CHECK(allocator->release(a2));
+    RT_CHECK(allocator->release(a3));
+
+    // released blocks must coalesce back into a single free block
+    if (allocator->allocated() != 0
+     || allocator->largestFree() != allocator->capacity()) {
+        printf("Error: free blocks not coalesced!\n");
+        return -1;
+    }
+
     delete allocator;
 
     printf("PASSED!\n");